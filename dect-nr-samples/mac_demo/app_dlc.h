@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef APP_DLC_H__
+#define APP_DLC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file app_dlc.h
+ * @brief Binary DLC data path exported by main.c.
+ *
+ * Every DLC SDU starts with a one-byte port that selects the service handling
+ * it on the receiver; the rest is an opaque payload of
+ * 1..APP_DLC_PAYLOAD_LEN_MAX bytes. No NUL terminator is added on TX or
+ * expected on RX. The default peer is the currently associated FT (PT mode)
+ * or PT (FT mode).
+ */
+
+/** Largest DLC SDU, port byte included. */
+#define APP_DLC_SDU_LEN_MAX CONFIG_APP_DLC_SDU_LEN_MAX
+
+/** Length of the port header at the front of each SDU. */
+#define APP_DLC_PORT_HDR_LEN 1
+
+/** Largest payload after the port header. */
+#define APP_DLC_PAYLOAD_LEN_MAX (APP_DLC_SDU_LEN_MAX - APP_DLC_PORT_HDR_LEN)
+
+/** DLC flow for signalling, as configured at association (highest priority). */
+#define APP_DLC_FLOW_SIGNALLING 1
+
+/** DLC flow for user-plane payloads. */
+#define APP_DLC_FLOW_USER CONFIG_APP_DLC_USER_FLOW_ID
+
+/** Service ports. */
+enum app_dlc_port {
+	/** SEND/SENDHEX/SENDB64 and app_dlc_send(). */
+	APP_DLC_PORT_DATA = 0,
+	/** PERF throughput benchmark. */
+	APP_DLC_PORT_PERF = 1,
+	/** Echo requests and replies (PING). */
+	APP_DLC_PORT_ECHO = 2,
+	/** Fragments of messages larger than one SDU. */
+	APP_DLC_PORT_FRAG = 3,
+	/** Several small messages coalesced into one SDU. */
+	APP_DLC_PORT_BATCH = 4,
+	/** Compressed payloads and compression capability exchange. */
+	APP_DLC_PORT_COMPRESSED = 5,
+	/** Multi-hop payloads and route adverts (relay.h). */
+	APP_DLC_PORT_ROUTE = 6,
+	/** Sequence-numbered SDUs (seqtrack.h). */
+	APP_DLC_PORT_SEQ = 7,
+	/** Network time sync and one-way latency probes (timesync.h). */
+	APP_DLC_PORT_TIME = 8,
+	/** IPv6 packets of the dect0 network interface (dlc_net.h). */
+	APP_DLC_PORT_IP = 9,
+	/**
+	 * First of CONFIG_APP_DLC_USER_PORTS ports for services registered
+	 * with app_dlc_port_register(). Lower ports are built in.
+	 */
+	APP_DLC_PORT_USER = 16,
+};
+
+/**
+ * @brief RX handler for binary DLC payloads.
+ *
+ * Called from the main event loop (thread context). @p data is only valid for
+ * the duration of the call.
+ *
+ * @param long_rd_id Long RD ID of the sender
+ * @param data       Payload bytes
+ * @param len        Payload length in bytes
+ */
+typedef void (*app_dlc_rx_cb_t)(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+/**
+ * @brief Per-port dispatch of a payload unwrapped by a transport layer.
+ *
+ * Layers that carry other ports inside their own (batches, compression) hand
+ * each inner payload back to the normal port dispatch through this handler.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param port       Inner service port
+ * @param data       Inner payload
+ * @param len        Inner payload length (at least 1 byte)
+ */
+typedef void (*app_dlc_dispatch_t)(uint32_t long_rd_id, uint8_t port, const uint8_t *data,
+				   size_t len);
+
+/**
+ * @brief Send a binary payload to the associated peer.
+ *
+ * The payload becomes one DLC SDU on the user-plane flow, or part of one
+ * while SDU coalescing is enabled (see coalesce.h). Completion is reported
+ * asynchronously by the modem; this call returns once the payload has been
+ * queued for transmission (see tx_sched.h) or for coalescing. On a PT
+ * without a parent, or while older payloads still wait, the payload is stored
+ * in the outbox instead and sent after the next association (outbox.h).
+ *
+ * @param data Payload bytes
+ * @param len  Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @return 0 on success, -EINVAL on bad arguments, -EMSGSIZE if @p len is too
+ *         large, -ENOTCONN if not associated, or -ENOBUFS if the TX queue is
+ *         full
+ */
+int app_dlc_send(const void *data, size_t len);
+
+/**
+ * @brief Send a payload on a service port.
+ *
+ * Same as app_dlc_send(), but selects the port and the peer and returns the
+ * transaction ID that the matching TX completion will carry.
+ *
+ * @param long_rd_id     Destination, or 0 for the associated peer
+ * @param port           Service port (enum app_dlc_port)
+ * @param data           Payload bytes
+ * @param len            Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @param transaction_id Output: transaction ID of the SDU (may be NULL)
+ * @return 0 on success, negative error code as for app_dlc_send()
+ */
+int app_dlc_port_send(uint32_t long_rd_id, uint8_t port, const void *data, size_t len,
+		      uint32_t *transaction_id);
+
+/**
+ * @brief Send a payload on a service port and an explicit DLC flow.
+ *
+ * Same as app_dlc_port_send(). Flows 1-2 are signalling and are scheduled
+ * ahead of the user-plane flows 3+.
+ *
+ * @param long_rd_id     Destination, or 0 for the associated peer
+ * @param flow_id        DLC flow (APP_DLC_FLOW_SIGNALLING or APP_DLC_FLOW_USER)
+ * @param port           Service port (enum app_dlc_port)
+ * @param data           Payload bytes
+ * @param len            Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @param transaction_id Output: transaction ID of the SDU (may be NULL)
+ * @return 0 on success, negative error code as for app_dlc_send()
+ */
+int app_dlc_flow_send(uint32_t long_rd_id, uint8_t flow_id, uint8_t port, const void *data,
+		      size_t len, uint32_t *transaction_id);
+
+/**
+ * @brief Send a service header and a payload as one SDU on a service port.
+ *
+ * Same as app_dlc_port_send() with the SDU payload being @p hdr followed by
+ * @p data, so services can prefix their own header without copying the
+ * payload into a staging buffer first.
+ *
+ * @param long_rd_id     Destination, or 0 for the associated peer
+ * @param port           Service port (enum app_dlc_port)
+ * @param hdr            Service header (may be NULL if @p hdr_len is 0)
+ * @param hdr_len        Service header length
+ * @param data           Payload bytes (may be NULL if @p len is 0)
+ * @param len            Payload length; hdr_len + len must be 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @param transaction_id Output: transaction ID of the SDU (may be NULL)
+ * @return 0 on success, negative error code as for app_dlc_send()
+ */
+int app_dlc_port_send_hdr(uint32_t long_rd_id, uint8_t port, const void *hdr, size_t hdr_len,
+			  const void *data, size_t len, uint32_t *transaction_id);
+
+/**
+ * @brief Get the currently associated peer.
+ *
+ * @param long_rd_id Output: long RD ID of the parent FT (PT mode) or of the
+ *                   most recently associated child PT (FT mode)
+ * @return 0 on success, -ENOTCONN if not associated
+ */
+int app_dlc_peer_get(uint32_t *long_rd_id);
+
+/**
+ * @brief Resolve a destination the way the send functions do.
+ *
+ * @param long_rd_id Destination, or 0 for the associated peer (app_dlc_peer_get())
+ * @param peer       Output: resolved long RD ID
+ * @return 0 on success, -ENOTCONN if @p long_rd_id is not an associated peer
+ */
+int app_dlc_peer_resolve(uint32_t long_rd_id, uint32_t *peer);
+
+/**
+ * @brief Get the parent FT of this device.
+ *
+ * @param long_rd_id Output: long RD ID of the FT this PT or relay is associated with
+ * @return 0 on success, -ENOTCONN if not associated upstream (idle, FT or unassociated PT)
+ */
+int app_dlc_parent_get(uint32_t *long_rd_id);
+
+/**
+ * @brief Get the arrival time of the SDU being handled.
+ *
+ * Only valid inside an RX handler (app_dlc_rx_cb_t). The time is taken in the
+ * modem callback, before the SDU waits in the event queue.
+ *
+ * @return Uptime in microseconds at which the SDU was received
+ */
+uint64_t app_dlc_rx_time_us(void);
+
+/**
+ * @brief Get the port of the payload being handled.
+ *
+ * Only valid inside an RX handler (app_dlc_rx_cb_t), for handlers that serve
+ * several ports.
+ *
+ * @return Service port the payload arrived on
+ */
+uint8_t app_dlc_rx_port(void);
+
+/**
+ * @brief Register an RX handler for binary DLC payloads.
+ *
+ * With no handler registered, received payloads are printed on the console.
+ *
+ * @param cb Handler, or NULL to restore console printing
+ */
+void app_dlc_rx_cb_set(app_dlc_rx_cb_t cb);
+
+/**
+ * @brief Register an RX handler for an application service port.
+ *
+ * Received SDUs are demultiplexed by their port byte with one table lookup;
+ * the handler gets the payload after the port byte in place, without a copy.
+ * Payloads on this port unwrapped from batches, compression or multi-hop
+ * routing reach the same handler.
+ *
+ * @param port Service port, APP_DLC_PORT_USER..APP_DLC_PORT_USER +
+ *             CONFIG_APP_DLC_USER_PORTS - 1
+ * @param cb   Handler, or NULL to release the port
+ * @return 0 on success, -EINVAL if @p port is not a user port, -EBUSY if
+ *         another handler holds it
+ */
+int app_dlc_port_register(uint8_t port, app_dlc_rx_cb_t cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_DLC_H__ */
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "bcast.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include "app_dlc.h"
+#include "ft_assoc.h"
+
+LOG_MODULE_REGISTER(bcast, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define BCAST_PEER_MAX  CONFIG_APP_FT_MAX_PTS
+#define BCAST_RETRY_MS  10
+/* Longer than tx_sched's in-flight reclaim timeout: a copy without a
+ * completion by then never gets one. */
+#define BCAST_STALL_MS  70000
+
+enum bcast_state {
+	BCAST_PENDING,
+	BCAST_QUEUED,
+	BCAST_OK,
+	BCAST_FAILED,
+	BCAST_GONE, /* released before its turn */
+};
+
+static const char *const state_names[] = {
+	[BCAST_PENDING] = "pending",
+	[BCAST_QUEUED] = "queued",
+	[BCAST_OK] = "ok",
+	[BCAST_FAILED] = "failed",
+	[BCAST_GONE] = "gone",
+};
+
+/* The single sweep buffer: one payload, one slot per PT. */
+static struct {
+	bool active;
+	uint8_t port;
+	uint16_t len;
+	uint8_t inflight;
+	size_t count;
+	size_t next;
+	uint32_t start_ms;
+	uint32_t end_ms;
+	uint32_t progress_ms;
+	uint32_t long_rd_id[BCAST_PEER_MAX];
+	uint32_t transaction_id[BCAST_PEER_MAX];
+	uint8_t state[BCAST_PEER_MAX];
+	uint8_t buf[APP_DLC_PAYLOAD_LEN_MAX];
+} sweep;
+
+static struct {
+	uint32_t sweeps;
+	uint32_t sdus;
+	uint32_t ok;
+	uint32_t failed;
+	uint32_t gone;
+	uint32_t stalled;
+} stats;
+
+/* Lock order: bcast_mutex, then app_mutex (taken by the sends). */
+static K_MUTEX_DEFINE(bcast_mutex);
+
+static void bcast_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(bcast_work, bcast_work_handler);
+
+/* Must be called with bcast_mutex held. */
+static void finish_locked(void)
+{
+	size_t ok = 0, failed = 0, gone = 0;
+
+	for (size_t i = 0; i < sweep.count; i++) {
+		ok += (sweep.state[i] == BCAST_OK);
+		failed += (sweep.state[i] == BCAST_FAILED);
+		gone += (sweep.state[i] == BCAST_GONE);
+	}
+	stats.ok += ok;
+	stats.failed += failed;
+	stats.gone += gone;
+	sweep.active = false;
+	sweep.end_ms = k_uptime_get_32();
+	k_work_cancel_delayable(&bcast_work);
+	printk("BCAST done: %zu/%zu PTs ok, %zu failed, %zu gone in %u ms\n", ok, sweep.count,
+	       failed, gone, sweep.end_ms - sweep.start_ms);
+}
+
+/* Queue copies for the next PTs while the window has room. Must be called
+ * with bcast_mutex held. */
+static void pump_locked(void)
+{
+	bool blocked = false;
+
+	while (sweep.inflight < CONFIG_APP_BCAST_WINDOW && sweep.next < sweep.count) {
+		size_t i = sweep.next;
+		int err;
+
+		if (!ft_assoc_contains(sweep.long_rd_id[i])) {
+			sweep.state[i] = BCAST_GONE;
+			sweep.next++;
+			continue;
+		}
+		err = app_dlc_port_send_hdr(sweep.long_rd_id[i], sweep.port, NULL, 0, sweep.buf,
+					    sweep.len, &sweep.transaction_id[i]);
+		if (err == -ENOBUFS) {
+			/* tx_sched is full; try this PT again shortly. */
+			blocked = true;
+			break;
+		}
+		if (err != 0) {
+			LOG_WRN("BCAST to rd=%u failed: %d", sweep.long_rd_id[i], err);
+			sweep.state[i] = (err == -ENOTCONN) ? BCAST_GONE : BCAST_FAILED;
+		} else {
+			sweep.state[i] = BCAST_QUEUED;
+			sweep.inflight++;
+			stats.sdus++;
+		}
+		sweep.next++;
+	}
+
+	if (sweep.next == sweep.count && sweep.inflight == 0) {
+		finish_locked();
+	} else if (blocked) {
+		k_work_reschedule(&bcast_work, K_MSEC(BCAST_RETRY_MS));
+	} else {
+		k_work_reschedule(&bcast_work, K_MSEC(BCAST_STALL_MS));
+	}
+}
+
+static void bcast_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&bcast_mutex, K_FOREVER);
+	if (!sweep.active) {
+		k_mutex_unlock(&bcast_mutex);
+		return;
+	}
+	if (k_uptime_get_32() - sweep.progress_ms >= BCAST_STALL_MS) {
+		LOG_WRN("BCAST: no TX completion for %u ms, giving up on %u PTs", BCAST_STALL_MS,
+			sweep.inflight);
+		for (size_t i = 0; i < sweep.count; i++) {
+			if (sweep.state[i] == BCAST_QUEUED) {
+				sweep.state[i] = BCAST_FAILED;
+			}
+		}
+		sweep.inflight = 0;
+		stats.stalled++;
+		sweep.progress_ms = k_uptime_get_32();
+	}
+	pump_locked();
+	k_mutex_unlock(&bcast_mutex);
+}
+
+int bcast_send(uint8_t port, const void *data, size_t len)
+{
+	int err = 0;
+
+	if (data == NULL || len == 0) {
+		return -EINVAL;
+	}
+	if (len > APP_DLC_PAYLOAD_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&bcast_mutex, K_FOREVER);
+	if (sweep.active) {
+		err = -EBUSY;
+	} else {
+		sweep.count = ft_assoc_list(sweep.long_rd_id, ARRAY_SIZE(sweep.long_rd_id));
+		if (sweep.count == 0) {
+			err = -ENOTCONN;
+		}
+	}
+	if (err == 0) {
+		memcpy(sweep.buf, data, len);
+		memset(sweep.state, BCAST_PENDING, sizeof(sweep.state));
+		sweep.port = port;
+		sweep.len = (uint16_t)len;
+		sweep.next = 0;
+		sweep.inflight = 0;
+		sweep.start_ms = k_uptime_get_32();
+		sweep.progress_ms = sweep.start_ms;
+		sweep.end_ms = 0;
+		sweep.active = true;
+		stats.sweeps++;
+		pump_locked();
+	}
+	k_mutex_unlock(&bcast_mutex);
+	return err;
+}
+
+bool bcast_tx_done(uint32_t transaction_id, int status)
+{
+	bool found = false;
+
+	k_mutex_lock(&bcast_mutex, K_FOREVER);
+	for (size_t i = 0; sweep.active && i < sweep.next; i++) {
+		if (sweep.state[i] == BCAST_QUEUED && sweep.transaction_id[i] == transaction_id) {
+			sweep.state[i] = (status == 0) ? BCAST_OK : BCAST_FAILED;
+			sweep.inflight--;
+			sweep.progress_ms = k_uptime_get_32();
+			found = true;
+			pump_locked();
+			break;
+		}
+	}
+	k_mutex_unlock(&bcast_mutex);
+	return found;
+}
+
+static int cmd_bcast(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t now = k_uptime_get_32();
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_mutex_lock(&bcast_mutex, K_FOREVER);
+	if (sweep.count == 0) {
+		shell_print(shell, "BCAST: no group send yet (SEND @ALL starts one)");
+	} else {
+		shell_print(shell, "BCAST: %s, %u B on port %u to %zu PTs, %zu sent, %u in flight, "
+			    "%u ms", sweep.active ? "running" : "done", sweep.len, sweep.port,
+			    sweep.count, sweep.next, sweep.inflight,
+			    (sweep.active ? now : sweep.end_ms) - sweep.start_ms);
+		for (size_t i = 0; i < sweep.count; i++) {
+			shell_print(shell, "  rd=%u %s", sweep.long_rd_id[i],
+				    state_names[sweep.state[i]]);
+		}
+	}
+	shell_print(shell, "BCAST: sweeps=%u sdus=%u ok=%u failed=%u gone=%u stalled=%u "
+		    "window=%u", stats.sweeps, stats.sdus, stats.ok, stats.failed, stats.gone,
+		    stats.stalled, CONFIG_APP_BCAST_WINDOW);
+	k_mutex_unlock(&bcast_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(BCAST, NULL, "BCAST — progress and per-PT results of the last group send", cmd_bcast, 1, 0);
+SHELL_CMD_ARG_REGISTER(bcast, NULL, "bcast — progress and per-pt results of the last group send", cmd_bcast, 1, 0);
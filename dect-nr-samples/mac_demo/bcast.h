@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BCAST_H__
+#define BCAST_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file bcast.h
+ * @brief Downlink group send: one payload to every PT associated with this FT.
+ *
+ * The DECT NR+ MAC API offers DLC data only towards one associated peer, so
+ * a group send is a paced unicast sweep over a snapshot of the association
+ * table. The payload is held once in a single sweep buffer; at most
+ * CONFIG_APP_BCAST_WINDOW copies of it are queued in tx_sched at a time, and
+ * the next PT is served as each one completes. Every PT's result (delivered,
+ * failed, or released before its turn) is kept until the next group send.
+ */
+
+/**
+ * @brief Start a group send to every associated PT.
+ *
+ * Returns once the sweep has started; BCAST shows its progress. Must not be
+ * called with app_mutex held.
+ *
+ * @param port Service port (enum app_dlc_port)
+ * @param data Payload bytes (copied)
+ * @param len  Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @return 0 on success, -EINVAL on bad arguments, -EMSGSIZE if @p len is too
+ *         large, -ENOTCONN if no PT is associated, -EBUSY while a sweep runs
+ */
+int bcast_send(uint8_t port, const void *data, size_t len);
+
+/**
+ * @brief Offer a DLC TX completion to the group send.
+ *
+ * Called from the main event loop for every dlc_data_tx completion.
+ *
+ * @param transaction_id Transaction ID of the completed SDU
+ * @param status         Modem completion status (0 = success)
+ * @return true if the transaction belonged to the sweep
+ */
+bool bcast_tx_done(uint32_t transaction_id, int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BCAST_H__ */
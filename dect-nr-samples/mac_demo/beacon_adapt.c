@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "beacon_adapt.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_REGISTER(beacon_adapt, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Cluster beacon periods the modem accepts. */
+static const uint32_t periods_ms[] = {
+	10, 50, 100, 500, 1000, 1500, 2000, 4000, 8000, 16000, 32000,
+};
+
+static struct {
+	bool enabled;
+	uint32_t sdus;
+	uint32_t assocs;
+	uint32_t last_step_ms;
+	uint8_t idle_steps;
+} state = {
+	.enabled = IS_ENABLED(CONFIG_APP_BEACON_ADAPT),
+};
+
+/* Inputs and outcome of the latest step, for BEACON. */
+static struct {
+	uint32_t steps;
+	uint32_t shorter;
+	uint32_t longer;
+	uint32_t sdus_per_s;
+	uint32_t assocs;
+	uint32_t period_ms;
+} last;
+
+static K_MUTEX_DEFINE(beacon_adapt_mutex);
+
+void beacon_adapt_note_sdu(void)
+{
+	k_mutex_lock(&beacon_adapt_mutex, K_FOREVER);
+	state.sdus++;
+	k_mutex_unlock(&beacon_adapt_mutex);
+}
+
+void beacon_adapt_note_assoc(void)
+{
+	k_mutex_lock(&beacon_adapt_mutex, K_FOREVER);
+	state.assocs++;
+	k_mutex_unlock(&beacon_adapt_mutex);
+}
+
+void beacon_adapt_enable(bool enable)
+{
+	k_mutex_lock(&beacon_adapt_mutex, K_FOREVER);
+	state.enabled = enable;
+	state.idle_steps = 0;
+	k_mutex_unlock(&beacon_adapt_mutex);
+}
+
+bool beacon_adapt_enabled(void)
+{
+	bool enabled;
+
+	k_mutex_lock(&beacon_adapt_mutex, K_FOREVER);
+	enabled = state.enabled;
+	k_mutex_unlock(&beacon_adapt_mutex);
+	return enabled;
+}
+
+/* Next valid period above cur_ms, or cur_ms at the top of the ladder. */
+static uint32_t period_longer(uint32_t cur_ms)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(periods_ms); i++) {
+		if (periods_ms[i] > cur_ms) {
+			return periods_ms[i];
+		}
+	}
+	return cur_ms;
+}
+
+bool beacon_adapt_step(uint32_t cur_ms, uint32_t idle_ms, uint32_t *next_ms)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t busy_ms = MIN((uint32_t)CONFIG_APP_BEACON_PERIOD_BUSY_MS, idle_ms);
+	uint32_t elapsed_ms, sdus_per_s;
+	bool busy;
+
+	k_mutex_lock(&beacon_adapt_mutex, K_FOREVER);
+	elapsed_ms = (state.last_step_ms != 0) ? now - state.last_step_ms
+					       : CONFIG_APP_BEACON_ADAPT_INTERVAL_MS;
+	sdus_per_s = (state.sdus * 1000U) / MAX(elapsed_ms, 1U);
+	busy = state.assocs > 0 || sdus_per_s >= CONFIG_APP_BEACON_ADAPT_BUSY_SDU_S;
+
+	*next_ms = cur_ms;
+	if (cur_ms > idle_ms) {
+		/* PERIOD was lowered under us. */
+		*next_ms = idle_ms;
+	} else if (busy) {
+		*next_ms = busy_ms;
+		state.idle_steps = 0;
+	} else if (cur_ms < idle_ms &&
+		   ++state.idle_steps >= CONFIG_APP_BEACON_ADAPT_IDLE_STEPS) {
+		*next_ms = MIN(period_longer(cur_ms), idle_ms);
+		state.idle_steps = 0;
+	}
+	if (*next_ms < cur_ms) {
+		last.shorter++;
+	} else if (*next_ms > cur_ms) {
+		last.longer++;
+	}
+
+	last.steps++;
+	last.sdus_per_s = sdus_per_s;
+	last.assocs = state.assocs;
+	last.period_ms = *next_ms;
+	state.sdus = 0;
+	state.assocs = 0;
+	state.last_step_ms = now;
+	k_mutex_unlock(&beacon_adapt_mutex);
+
+	return *next_ms != cur_ms;
+}
+
+static int cmd_beacon(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "ON") == 0 || strcmp(argv[1], "on") == 0) {
+			beacon_adapt_enable(true);
+		} else if (strcmp(argv[1], "OFF") == 0 || strcmp(argv[1], "off") == 0) {
+			/* The next step goes back to the PERIOD value. */
+			beacon_adapt_enable(false);
+		} else {
+			shell_error(shell, "Usage: BEACON [ON|OFF]");
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&beacon_adapt_mutex, K_FOREVER);
+	shell_print(shell, "BEACON adapt: %s, every %u ms, busy period %u ms at an association "
+		    "or >= %u SDU/s, one step longer after %u quiet steps",
+		    state.enabled ? "on" : "off", CONFIG_APP_BEACON_ADAPT_INTERVAL_MS,
+		    CONFIG_APP_BEACON_PERIOD_BUSY_MS, CONFIG_APP_BEACON_ADAPT_BUSY_SDU_S,
+		    CONFIG_APP_BEACON_ADAPT_IDLE_STEPS);
+	if (last.steps == 0) {
+		shell_print(shell, "BEACON: no step yet (runs while in FT mode)");
+	} else {
+		shell_print(shell, "BEACON last step: %u SDU/s, %u association(s) -> period %u ms",
+			    last.sdus_per_s, last.assocs, last.period_ms);
+	}
+	shell_print(shell, "BEACON: steps=%u shorter=%u longer=%u", last.steps, last.shorter,
+		    last.longer);
+	k_mutex_unlock(&beacon_adapt_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(BEACON, NULL, "BEACON [ON|OFF] — load-adaptive FT beacon period", cmd_beacon, 1, 1);
+SHELL_CMD_ARG_REGISTER(beacon, NULL, "beacon [on|off] — load-adaptive ft beacon period", cmd_beacon, 1, 1);
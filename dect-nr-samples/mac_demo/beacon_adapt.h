@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BEACON_ADAPT_H__
+#define BEACON_ADAPT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file beacon_adapt.h
+ * @brief Load-adaptive FT cluster beacon period.
+ *
+ * The period set with PERIOD (or PROFILE) is the idle period. Every
+ * CONFIG_APP_BEACON_ADAPT_INTERVAL_MS the FT calls beacon_adapt_step(): an
+ * association indication or at least CONFIG_APP_BEACON_ADAPT_BUSY_SDU_S
+ * SDUs/s to or from its PTs since the previous step switches straight to
+ * CONFIG_APP_BEACON_PERIOD_BUSY_MS, which cuts association and downlink
+ * latency. After CONFIG_APP_BEACON_ADAPT_IDLE_STEPS quiet steps in a row the
+ * period moves one valid cluster period longer, back up to the idle period,
+ * saving FT energy and airtime.
+ *
+ * Associated PTs read the period from every cluster beacon, so they follow
+ * without a resync; lengthening one ladder step at a time keeps each change
+ * within their beacon supervision.
+ */
+
+/** @brief Count one SDU sent to or received from an associated PT. */
+void beacon_adapt_note_sdu(void);
+
+/** @brief Count an association indication (successful or not). */
+void beacon_adapt_note_assoc(void);
+
+/**
+ * @brief Turn adaptation on or off.
+ *
+ * @param enable true to let beacon_adapt_step() propose changes
+ */
+void beacon_adapt_enable(bool enable);
+
+/** @brief Check whether adaptation is on. */
+bool beacon_adapt_enabled(void);
+
+/**
+ * @brief Decide the cluster beacon period for the next interval.
+ *
+ * Consumes the counters since the previous call, also while adaptation is
+ * off.
+ *
+ * @param cur_ms  Cluster beacon period in use
+ * @param idle_ms Longest period to use (PERIOD)
+ * @param next_ms Output: proposed period (@p cur_ms if unchanged)
+ * @return true if @p next_ms differs from @p cur_ms
+ */
+bool beacon_adapt_step(uint32_t cur_ms, uint32_t idle_ms, uint32_t *next_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BEACON_ADAPT_H__ */
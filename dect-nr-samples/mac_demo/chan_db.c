@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "chan_db.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(chan_db, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define Q8(pct) ((int32_t)(pct) << 8) /* percent in 24.8 fixed point */
+
+struct chan_rec {
+	uint16_t channel;
+	uint16_t samples;
+	uint8_t busy_last;
+	int32_t busy_q8;
+	uint32_t var_q16;  /* busy variance, percent^2 in 16.16 */
+	int32_t free_q8;
+	int32_t possible_q8;
+	uint32_t scan_ms;
+	uint32_t ft_long_rd_id;
+	int16_t ft_rssi_dbm;
+	uint32_t ft_ms;
+};
+
+static struct chan_rec table[CONFIG_APP_CHAN_DB_SIZE];
+static size_t table_count;
+
+/* Scan results arrive in the modem callback context. */
+static struct k_spinlock chan_db_lock;
+
+static uint32_t isqrt(uint32_t v)
+{
+	uint32_t r = 0;
+	uint32_t bit = 1UL << 30;
+
+	while (bit > v) {
+		bit >>= 2;
+	}
+	while (bit != 0) {
+		if (v >= r + bit) {
+			v -= r + bit;
+			r = (r >> 1) + bit;
+		} else {
+			r >>= 1;
+		}
+		bit >>= 2;
+	}
+	return r;
+}
+
+static int32_t ewma(int32_t avg, int32_t sample)
+{
+	return avg + ((sample - avg) * CONFIG_APP_CHAN_DB_ALPHA) / 100;
+}
+
+static uint32_t rec_last_ms(const struct chan_rec *r)
+{
+	uint32_t now = k_uptime_get_32();
+
+	return MIN(now - r->scan_ms, now - r->ft_ms);
+}
+
+/* Find the record for channel, or take a free or the stalest one. Must be
+ * called with chan_db_lock held. */
+static struct chan_rec *rec_get_locked(uint16_t channel)
+{
+	struct chan_rec *oldest = NULL;
+
+	for (size_t i = 0; i < table_count; i++) {
+		if (table[i].channel == channel) {
+			return &table[i];
+		}
+		if (oldest == NULL || rec_last_ms(&table[i]) > rec_last_ms(oldest)) {
+			oldest = &table[i];
+		}
+	}
+	if (table_count < ARRAY_SIZE(table)) {
+		oldest = &table[table_count++];
+	}
+	memset(oldest, 0, sizeof(*oldest));
+	oldest->channel = channel;
+	return oldest;
+}
+
+void chan_db_note_scan(uint16_t channel, uint8_t busy_percentage, size_t free_slots,
+		       size_t possible_slots, size_t total_slots)
+{
+	int32_t busy = Q8(MIN(busy_percentage, 100));
+	int32_t free_pct = (total_slots != 0) ? Q8(free_slots * 100U / total_slots) : 0;
+	int32_t possible_pct = (total_slots != 0) ? Q8(possible_slots * 100U / total_slots) : 0;
+	k_spinlock_key_t key = k_spin_lock(&chan_db_lock);
+	struct chan_rec *r = rec_get_locked(channel);
+
+	if (r->samples == 0) {
+		r->busy_q8 = busy;
+		r->var_q16 = 0;
+		r->free_q8 = free_pct;
+		r->possible_q8 = possible_pct;
+	} else {
+		/* Incremental exponentially weighted variance:
+		 * var = (1 - a) * (var + a * d^2), d against the old mean. */
+		int64_t d = busy - r->busy_q8;
+		uint64_t var = r->var_q16 +
+			       ((uint64_t)(d * d) * CONFIG_APP_CHAN_DB_ALPHA) / 100U;
+
+		r->var_q16 = (uint32_t)((var * (100U - CONFIG_APP_CHAN_DB_ALPHA)) / 100U);
+		r->busy_q8 = ewma(r->busy_q8, busy);
+		r->free_q8 = ewma(r->free_q8, free_pct);
+		r->possible_q8 = ewma(r->possible_q8, possible_pct);
+	}
+	r->busy_last = busy_percentage;
+	r->scan_ms = k_uptime_get_32();
+	if (r->samples < UINT16_MAX) {
+		r->samples++;
+	}
+	k_spin_unlock(&chan_db_lock, key);
+}
+
+void chan_db_note_beacon(uint16_t channel, uint32_t long_rd_id, int16_t rssi_dbm)
+{
+	k_spinlock_key_t key = k_spin_lock(&chan_db_lock);
+	struct chan_rec *r = rec_get_locked(channel);
+
+	r->ft_long_rd_id = long_rd_id;
+	r->ft_rssi_dbm = rssi_dbm;
+	r->ft_ms = k_uptime_get_32();
+	k_spin_unlock(&chan_db_lock, key);
+}
+
+static void rec_snapshot(const struct chan_rec *r, uint32_t now, struct chan_db_entry *e)
+{
+	uint32_t usable_x10;
+
+	e->channel = r->channel;
+	e->samples = r->samples;
+	e->busy_last = r->busy_last;
+	e->busy_avg_x10 = (uint16_t)((r->busy_q8 * 10) >> 8);
+	e->busy_sd_x10 = (uint16_t)((isqrt(r->var_q16) * 10U) >> 8);
+	e->free_x10 = (uint16_t)((r->free_q8 * 10) >> 8);
+	e->possible_x10 = (uint16_t)((r->possible_q8 * 10) >> 8);
+	e->age_ms = now - r->scan_ms;
+	e->ft_long_rd_id = r->ft_long_rd_id;
+	e->ft_rssi_dbm = r->ft_rssi_dbm;
+	e->ft_age_ms = now - r->ft_ms;
+
+	if (r->samples == 0) {
+		e->score = UINT16_MAX;
+		return;
+	}
+	usable_x10 = MIN(e->free_x10 + e->possible_x10 / 2U, 1000U);
+	e->score = e->busy_avg_x10 + e->busy_sd_x10 + (1000U - usable_x10) / 4U;
+	if (r->ft_long_rd_id != 0 && e->ft_age_ms < CHAN_DB_FT_RECENT_MS) {
+		e->score += CONFIG_APP_CHAN_DB_FT_PENALTY * 10U;
+	}
+}
+
+size_t chan_db_rank(struct chan_db_entry *out, size_t max)
+{
+	uint32_t now = k_uptime_get_32();
+	k_spinlock_key_t key = k_spin_lock(&chan_db_lock);
+	size_t n = MIN(table_count, max);
+
+	for (size_t i = 0; i < n; i++) {
+		rec_snapshot(&table[i], now, &out[i]);
+	}
+	k_spin_unlock(&chan_db_lock, key);
+
+	/* Insertion sort: the table holds a band's worth of channels. */
+	for (size_t i = 1; i < n; i++) {
+		struct chan_db_entry e = out[i];
+		size_t j = i;
+
+		while (j > 0 && (out[j - 1].score > e.score ||
+				 (out[j - 1].score == e.score && out[j - 1].channel > e.channel))) {
+			out[j] = out[j - 1];
+			j--;
+		}
+		out[j] = e;
+	}
+	return n;
+}
+
+int chan_db_best(uint16_t *channel, uint8_t *busy)
+{
+	struct chan_db_entry ranked[CONFIG_APP_CHAN_DB_SIZE];
+	size_t n = chan_db_rank(ranked, ARRAY_SIZE(ranked));
+
+	if (n == 0 || ranked[0].samples == 0) {
+		return -ENOENT;
+	}
+	*channel = ranked[0].channel;
+	if (busy != NULL) {
+		*busy = (uint8_t)((ranked[0].busy_avg_x10 + 5U) / 10U);
+	}
+	return 0;
+}
+
+int chan_db_get(uint16_t channel, struct chan_db_entry *out)
+{
+	uint32_t now = k_uptime_get_32();
+	k_spinlock_key_t key = k_spin_lock(&chan_db_lock);
+	int err = -ENOENT;
+
+	for (size_t i = 0; i < table_count; i++) {
+		if (table[i].channel == channel) {
+			rec_snapshot(&table[i], now, out);
+			err = 0;
+			break;
+		}
+	}
+	k_spin_unlock(&chan_db_lock, key);
+	return err;
+}
+
+void chan_db_clear(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&chan_db_lock);
+
+	table_count = 0;
+	k_spin_unlock(&chan_db_lock, key);
+	LOG_DBG("channel history cleared");
+}
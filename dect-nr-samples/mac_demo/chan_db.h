@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CHAN_DB_H__
+#define CHAN_DB_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file chan_db.h
+ * @brief Per-channel history for channel selection.
+ *
+ * Every RSSI scan result and every FT beacon heard is folded into a small
+ * table keyed by channel, kept in RAM across scans. Busy percentage, its
+ * variance and the free and possible slot ratios are exponentially weighted
+ * moving averages with weight CONFIG_APP_CHAN_DB_ALPHA percent for the newest
+ * sample, so one quiet moment does not outweigh a channel's history.
+ *
+ * Channels are ranked by a score in tenths of a percentage point, lower is
+ * better: average busy + its standard deviation + a quarter of the slots that
+ * are not usable (free, or half for possible) + CONFIG_APP_CHAN_DB_FT_PENALTY
+ * points if another FT was heard there within CHAN_DB_FT_RECENT_MS.
+ */
+
+/** How long a heard FT beacon counts against its channel. */
+#define CHAN_DB_FT_RECENT_MS (10U * 60U * 1000U)
+
+/** Snapshot of one channel, as returned by chan_db_rank(). */
+struct chan_db_entry {
+	uint16_t channel;
+	uint16_t samples;        /**< RSSI scan results folded in */
+	uint8_t busy_last;       /**< Latest busy percentage */
+	uint16_t busy_avg_x10;   /**< EWMA busy, tenths of a percent */
+	uint16_t busy_sd_x10;    /**< EWMA standard deviation of busy, tenths of a percent */
+	uint16_t free_x10;       /**< EWMA free slots / total, tenths of a percent */
+	uint16_t possible_x10;   /**< EWMA possible slots / total, tenths of a percent */
+	uint32_t age_ms;         /**< Since the latest RSSI scan result */
+	uint32_t ft_long_rd_id;  /**< Last FT heard, 0 = none */
+	int16_t ft_rssi_dbm;     /**< Its beacon RSSI */
+	uint32_t ft_age_ms;      /**< Since that beacon */
+	uint16_t score;          /**< Lower is better */
+};
+
+/**
+ * @brief Fold one RSSI scan result into the table.
+ *
+ * Safe to call from the modem callback context.
+ */
+void chan_db_note_scan(uint16_t channel, uint8_t busy_percentage, size_t free_slots,
+		       size_t possible_slots, size_t total_slots);
+
+/** @brief Record an FT beacon heard on a channel. */
+void chan_db_note_beacon(uint16_t channel, uint32_t long_rd_id, int16_t rssi_dbm);
+
+/**
+ * @brief Pick the best scanned channel.
+ *
+ * @param channel Output: channel with the lowest score
+ * @param busy    Output: its EWMA busy percentage (optional)
+ * @return 0 on success, -ENOENT if no channel has been scanned
+ */
+int chan_db_best(uint16_t *channel, uint8_t *busy);
+
+/**
+ * @brief Snapshot the table, best channel first.
+ *
+ * Channels only known from beacons are ranked after all scanned ones.
+ *
+ * @param out Output array
+ * @param max Capacity of @p out
+ * @return Number of entries written
+ */
+size_t chan_db_rank(struct chan_db_entry *out, size_t max);
+
+/**
+ * @brief Snapshot one channel.
+ *
+ * @param channel Channel to look up
+ * @param out     Output entry
+ * @return 0 on success, -ENOENT if the channel is not in the table
+ */
+int chan_db_get(uint16_t channel, struct chan_db_entry *out);
+
+/** @brief Forget all history. */
+void chan_db_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAN_DB_H__ */
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "coalesce.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include "app_dlc.h"
+#include "compress.h"
+
+LOG_MODULE_REGISTER(coalesce, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* A record (up to 3 header bytes plus the message) must fit one batch SDU. */
+#define COALESCE_MSG_LEN_MAX  MIN(CONFIG_APP_COALESCE_MSG_LEN_MAX, APP_DLC_PAYLOAD_LEN_MAX - 3)
+#define COALESCE_DELAY_MS_MAX 1000
+
+static struct {
+	uint32_t delay_ms;
+	uint32_t long_rd_id; /* destination of the pending SDU */
+	size_t len;          /* bytes used in buf */
+	uint32_t count;      /* records in buf */
+	uint8_t buf[APP_DLC_PAYLOAD_LEN_MAX];
+} pending = {
+	.delay_ms = CONFIG_APP_COALESCE_DELAY_MS,
+};
+
+static struct {
+	uint32_t tx_msgs;
+	uint32_t tx_sdus;
+	uint32_t tx_direct;
+	uint32_t flush_size;
+	uint32_t flush_timer;
+	uint32_t flush_err;
+	uint32_t rx_sdus;
+	uint32_t rx_msgs;
+	uint32_t rx_malformed;
+} stats;
+
+/* Lock order: coalesce_mutex, then compress_mutex, then app_mutex. */
+static K_MUTEX_DEFINE(coalesce_mutex);
+
+static void coalesce_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(coalesce_work, coalesce_work_handler);
+
+static size_t rec_hdr_len(size_t len)
+{
+	return (len < 0x80 ? 1 : 2) + 1;
+}
+
+/* Must be called with coalesce_mutex held. */
+static void flush_locked(void)
+{
+	int err;
+
+	if (pending.count == 0) {
+		return;
+	}
+
+	err = compress_send(pending.long_rd_id, APP_DLC_PORT_BATCH, pending.buf, pending.len, NULL);
+	if (err != 0) {
+		stats.flush_err++;
+		LOG_WRN("Batch of %u message(s) to rd=%u dropped: %d", pending.count,
+			pending.long_rd_id, err);
+	} else {
+		stats.tx_sdus++;
+		LOG_DBG("Batch sent: rd=%u msgs=%u len=%zu", pending.long_rd_id, pending.count,
+			pending.len);
+	}
+	pending.len = 0;
+	pending.count = 0;
+	k_work_cancel_delayable(&coalesce_work);
+}
+
+static void coalesce_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&coalesce_mutex, K_FOREVER);
+	if (pending.count != 0) {
+		stats.flush_timer++;
+	}
+	flush_locked();
+	k_mutex_unlock(&coalesce_mutex);
+}
+
+bool coalesce_enabled(void)
+{
+	return pending.delay_ms != 0;
+}
+
+void coalesce_delay_set(uint32_t delay_ms)
+{
+	k_mutex_lock(&coalesce_mutex, K_FOREVER);
+	if (delay_ms == 0) {
+		flush_locked();
+	}
+	pending.delay_ms = delay_ms;
+	k_mutex_unlock(&coalesce_mutex);
+}
+
+uint32_t coalesce_delay_get(void)
+{
+	return pending.delay_ms;
+}
+
+int coalesce_send(uint32_t long_rd_id, uint8_t port, const void *data, size_t len)
+{
+	uint32_t peer;
+	size_t hdr_len;
+	uint8_t *p;
+	int err;
+
+	if (data == NULL || len == 0 || port == APP_DLC_PORT_BATCH) {
+		return -EINVAL;
+	}
+	if (len > APP_DLC_PAYLOAD_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+
+	hdr_len = rec_hdr_len(len);
+	k_mutex_lock(&coalesce_mutex, K_FOREVER);
+	if (pending.delay_ms == 0 || len > COALESCE_MSG_LEN_MAX ||
+	    hdr_len + len > sizeof(pending.buf)) {
+		/* Not coalesced: flush first so the peer sees messages in order. */
+		flush_locked();
+		err = compress_send(long_rd_id, port, data, len, NULL);
+		if (err == 0 && pending.delay_ms != 0) {
+			stats.tx_direct++;
+		}
+		k_mutex_unlock(&coalesce_mutex);
+		return err;
+	}
+
+	err = app_dlc_peer_resolve(long_rd_id, &peer);
+	if (err != 0) {
+		k_mutex_unlock(&coalesce_mutex);
+		return err;
+	}
+
+	if (pending.count != 0 &&
+	    (pending.long_rd_id != peer || pending.len + hdr_len + len > sizeof(pending.buf))) {
+		stats.flush_size++;
+		flush_locked();
+	}
+
+	p = &pending.buf[pending.len];
+	if (len < 0x80) {
+		*p++ = (uint8_t)len;
+	} else {
+		*p++ = 0x80 | (uint8_t)(len >> 8);
+		*p++ = (uint8_t)len;
+	}
+	*p++ = port;
+	memcpy(p, data, len);
+
+	pending.long_rd_id = peer;
+	pending.len += hdr_len + len;
+	pending.count++;
+	stats.tx_msgs++;
+
+	if (pending.len + rec_hdr_len(1) + 1 > sizeof(pending.buf)) {
+		/* Not even a one-byte message fits any more. */
+		stats.flush_size++;
+		flush_locked();
+	} else if (pending.count == 1) {
+		/* The delay runs from the first message, so no message waits longer. */
+		k_work_reschedule(&coalesce_work, K_MSEC(pending.delay_ms));
+	}
+	k_mutex_unlock(&coalesce_mutex);
+	return 0;
+}
+
+void coalesce_flush(void)
+{
+	k_mutex_lock(&coalesce_mutex, K_FOREVER);
+	flush_locked();
+	k_mutex_unlock(&coalesce_mutex);
+}
+
+void coalesce_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		 app_dlc_dispatch_t dispatch)
+{
+	size_t pos = 0;
+
+	stats.rx_sdus++;
+	while (pos < len) {
+		size_t rec_len = data[pos++];
+		uint8_t port;
+
+		if (rec_len & 0x80) {
+			if (pos >= len) {
+				break;
+			}
+			rec_len = ((rec_len & 0x7f) << 8) | data[pos++];
+		}
+		if (rec_len == 0 || pos + 1 + rec_len > len) {
+			break;
+		}
+		port = data[pos++];
+		if (port == APP_DLC_PORT_BATCH) {
+			LOG_WRN("BATCH from rd=%u: nested batch dropped", long_rd_id);
+		} else {
+			stats.rx_msgs++;
+			dispatch(long_rd_id, port, &data[pos], rec_len);
+		}
+		pos += rec_len;
+	}
+
+	if (pos != len) {
+		stats.rx_malformed++;
+		LOG_WRN("BATCH from rd=%u: malformed record at offset %zu", long_rd_id, pos);
+	}
+}
+
+/* COALESCE [delay_ms] */
+static int cmd_coalesce(const struct shell *shell, size_t argc, char **argv)
+{
+	long delay_ms;
+
+	if (argc >= 2) {
+		delay_ms = strtol(argv[1], NULL, 10);
+		if (delay_ms < 0 || delay_ms > COALESCE_DELAY_MS_MAX) {
+			shell_error(shell, "Delay must be between 0 (off) and %u ms",
+				    COALESCE_DELAY_MS_MAX);
+			return -EINVAL;
+		}
+		coalesce_delay_set((uint32_t)delay_ms);
+	}
+
+	k_mutex_lock(&coalesce_mutex, K_FOREVER);
+	if (pending.delay_ms == 0) {
+		shell_print(shell, "Coalescing: off");
+	} else {
+		shell_print(shell, "Coalescing: delay %u ms, messages up to %u B", pending.delay_ms,
+			    COALESCE_MSG_LEN_MAX);
+	}
+	shell_print(shell, "COALESCE TX: msgs=%u sdus=%u (%u.%02u msgs/SDU) direct=%u "
+		    "flush_size=%u flush_timer=%u dropped=%u", stats.tx_msgs, stats.tx_sdus,
+		    stats.tx_sdus ? stats.tx_msgs / stats.tx_sdus : 0,
+		    stats.tx_sdus ? (100U * stats.tx_msgs / stats.tx_sdus) % 100U : 0,
+		    stats.tx_direct, stats.flush_size, stats.flush_timer, stats.flush_err);
+	shell_print(shell, "COALESCE RX: sdus=%u msgs=%u malformed=%u", stats.rx_sdus,
+		    stats.rx_msgs, stats.rx_malformed);
+	k_mutex_unlock(&coalesce_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(COALESCE, NULL, "COALESCE [delay_ms] — small-message SDU coalescing (0=off)", cmd_coalesce, 1, 1);
+SHELL_CMD_ARG_REGISTER(coalesce, NULL, "coalesce [delay_ms] — small-message sdu coalescing (0=off)", cmd_coalesce, 1, 1);
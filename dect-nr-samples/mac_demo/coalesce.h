@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef COALESCE_H__
+#define COALESCE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "app_dlc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file coalesce.h
+ * @brief Nagle-style packing of small messages into one DLC SDU.
+ *
+ * While a coalescing delay is set, messages of up to
+ * CONFIG_APP_COALESCE_MSG_LEN_MAX bytes are appended to a pending SDU on
+ * APP_DLC_PORT_BATCH instead of being sent one SDU each. The pending SDU is
+ * sent when the next message no longer fits or when the delay has elapsed
+ * since its first message, whichever comes first. Larger messages flush the
+ * pending SDU and are then sent on their own, so ordering is preserved.
+ *
+ * Each record in a batch SDU is a length (one byte below 128, otherwise two
+ * bytes big endian with the top bit set), the inner port and the payload. The
+ * receiver hands every record to the normal port dispatch, so services see the
+ * same payloads as without coalescing.
+ */
+
+/**
+ * @brief Check whether coalescing is enabled.
+ *
+ * @return true if a non-zero coalescing delay is set
+ */
+bool coalesce_enabled(void);
+
+/**
+ * @brief Set the coalescing delay.
+ *
+ * Setting 0 sends any pending SDU and turns coalescing off.
+ *
+ * @param delay_ms Delay from the first queued message to the flush, 0 = off
+ */
+void coalesce_delay_set(uint32_t delay_ms);
+
+/**
+ * @brief Get the coalescing delay.
+ *
+ * @return Delay in milliseconds, 0 if coalescing is off
+ */
+uint32_t coalesce_delay_get(void);
+
+/**
+ * @brief Send a message on a port through the coalescing stage.
+ *
+ * With coalescing disabled this is compress_send(). Otherwise small
+ * messages are copied into the pending SDU and the call returns at once; an
+ * error while flushing later is counted and logged but not reported to the
+ * caller. Must not be called with app_mutex held.
+ *
+ * @param long_rd_id Destination, or 0 for the associated peer
+ * @param port       Service port (enum app_dlc_port, not APP_DLC_PORT_BATCH)
+ * @param data       Payload bytes
+ * @param len        Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @return 0 if the message was sent or queued, -EINVAL on bad arguments,
+ *         -EMSGSIZE if @p len is too large, -ENOTCONN if not associated, or a
+ *         send error
+ */
+int coalesce_send(uint32_t long_rd_id, uint8_t port, const void *data, size_t len);
+
+/**
+ * @brief Send the pending SDU now, if there is one.
+ */
+void coalesce_flush(void);
+
+/**
+ * @brief Unpack a payload received on APP_DLC_PORT_BATCH.
+ *
+ * Called from the main event loop. Records are dispatched in order; a
+ * malformed record ends the batch. Nested batches are dropped.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload (port byte stripped)
+ * @param len        Payload length
+ * @param dispatch   Handler for each record
+ */
+void coalesce_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		 app_dlc_dispatch_t dispatch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COALESCE_H__ */
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "compress.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_REGISTER(compress, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Payload on APP_DLC_PORT_COMPRESSED:
+ *   [0] type
+ *   HELLO / HELLO_ACK: [1] version, [2] codec mask
+ *   DATA:              [1] inner port, [2..] LZSS stream */
+#define COMPRESS_MSG_HELLO     1
+#define COMPRESS_MSG_HELLO_ACK 2
+#define COMPRESS_MSG_DATA      3
+#define COMPRESS_VERSION       1
+#define COMPRESS_CODEC_LZSS    BIT(0)
+#define COMPRESS_DATA_HDR_LEN  2
+#define COMPRESS_PEER_MAX      MAX(8, CONFIG_APP_FT_MAX_PTS)
+
+#define LZ_WINDOW     4096
+#define LZ_MIN_MATCH  3
+#define LZ_MAX_MATCH  18
+#define LZ_HASH_BITS  10
+#define LZ_CHAIN_MAX  16
+
+static struct {
+	uint32_t long_rd_id;
+	uint8_t codecs; /* 0 until the peer has announced its codecs */
+} peers[COMPRESS_PEER_MAX];
+
+static struct {
+	uint32_t tx_compressed;
+	uint32_t tx_raw;         /* incompressible, sent raw */
+	uint32_t tx_bytes_in;
+	uint32_t tx_bytes_out;
+	uint64_t tx_us;
+	uint32_t tx_us_max;
+	uint32_t rx_expanded;
+	uint32_t rx_bytes_in;
+	uint32_t rx_bytes_out;
+	uint64_t rx_us;
+	uint32_t rx_us_max;
+	uint32_t rx_err;
+} stats;
+
+static bool tx_enabled = IS_ENABLED(CONFIG_APP_COMPRESS_TX);
+
+/* Guards peers, stats, tx_enabled and the TX work buffers. Taken before app_mutex. */
+static K_MUTEX_DEFINE(compress_mutex);
+
+static uint16_t lz_head[1 << LZ_HASH_BITS]; /* position + 1, 0 = empty */
+static uint16_t lz_prev[APP_DLC_PAYLOAD_LEN_MAX];
+static uint8_t tx_buf[APP_DLC_PAYLOAD_LEN_MAX];
+static uint8_t rx_buf[APP_DLC_PAYLOAD_LEN_MAX]; /* event loop only */
+
+static uint32_t lz_hash(const uint8_t *p)
+{
+	uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+
+	return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+/* Compress in[0..n) into out. Returns the compressed length, or -ENOSPC if it
+ * does not fit in cap bytes. Must be called with compress_mutex held. */
+static int lz_compress(const uint8_t *in, size_t n, uint8_t *out, size_t cap)
+{
+	size_t ip = 0;
+	size_t op = 0;
+	size_t flag_pos = 0;
+	uint32_t flag_bit = 8;
+
+	memset(lz_head, 0, sizeof(lz_head));
+
+	while (ip < n) {
+		size_t best_len = 0;
+		size_t best_off = 0;
+		size_t adv;
+
+		if (flag_bit == 8) {
+			if (op >= cap) {
+				return -ENOSPC;
+			}
+			flag_pos = op++;
+			out[flag_pos] = 0;
+			flag_bit = 0;
+		}
+
+		if (ip + LZ_MIN_MATCH <= n) {
+			uint16_t cand = lz_head[lz_hash(&in[ip])];
+			size_t max = MIN((size_t)LZ_MAX_MATCH, n - ip);
+
+			for (int chain = 0; cand != 0 && chain < LZ_CHAIN_MAX; chain++) {
+				size_t c = cand - 1;
+				size_t l = 0;
+
+				if (ip - c > LZ_WINDOW) {
+					break;
+				}
+				while (l < max && in[c + l] == in[ip + l]) {
+					l++;
+				}
+				if (l > best_len) {
+					best_len = l;
+					best_off = ip - c;
+					if (l == max) {
+						break;
+					}
+				}
+				cand = lz_prev[c];
+			}
+		}
+
+		if (best_len >= LZ_MIN_MATCH) {
+			if (op + 2 > cap) {
+				return -ENOSPC;
+			}
+			out[op++] = (uint8_t)(best_off - 1);
+			out[op++] = (uint8_t)((((best_off - 1) >> 8) << 4) | (best_len - LZ_MIN_MATCH));
+			out[flag_pos] |= BIT(flag_bit);
+			adv = best_len;
+		} else {
+			if (op + 1 > cap) {
+				return -ENOSPC;
+			}
+			out[op++] = in[ip];
+			adv = 1;
+		}
+		flag_bit++;
+
+		for (; adv > 0; adv--, ip++) {
+			if (ip + LZ_MIN_MATCH <= n) {
+				uint32_t h = lz_hash(&in[ip]);
+
+				lz_prev[ip] = lz_head[h];
+				lz_head[h] = (uint16_t)(ip + 1);
+			}
+		}
+	}
+
+	return (int)op;
+}
+
+/* Expand in[0..n) into out. Returns the expanded length, or -EBADMSG if the
+ * stream is corrupt or expands beyond cap bytes. */
+static int lz_decompress(const uint8_t *in, size_t n, uint8_t *out, size_t cap)
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < n) {
+		uint8_t flags = in[ip++];
+
+		for (uint32_t bit = 0; bit < 8 && ip < n; bit++) {
+			if (flags & BIT(bit)) {
+				size_t off;
+				size_t l;
+
+				if (ip + 2 > n) {
+					return -EBADMSG;
+				}
+				off = (in[ip] | ((size_t)(in[ip + 1] >> 4) << 8)) + 1;
+				l = (in[ip + 1] & 0x0f) + LZ_MIN_MATCH;
+				ip += 2;
+				if (off > op || op + l > cap) {
+					return -EBADMSG;
+				}
+				for (; l > 0; l--, op++) {
+					out[op] = out[op - off];
+				}
+			} else {
+				if (op >= cap) {
+					return -EBADMSG;
+				}
+				out[op++] = in[ip++];
+			}
+		}
+	}
+
+	return (int)op;
+}
+
+/* Must be called with compress_mutex held. */
+static int peer_find(uint32_t long_rd_id)
+{
+	for (int i = 0; i < COMPRESS_PEER_MAX; i++) {
+		if (peers[i].long_rd_id == long_rd_id) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Must be called with compress_mutex held. Returns -1 if the table is full. */
+static int peer_add(uint32_t long_rd_id)
+{
+	int i = peer_find(long_rd_id);
+
+	if (i < 0) {
+		i = peer_find(0);
+		if (i >= 0) {
+			peers[i].long_rd_id = long_rd_id;
+			peers[i].codecs = 0;
+		}
+	}
+	return i;
+}
+
+static void send_hello(uint32_t long_rd_id, uint8_t type)
+{
+	uint8_t msg[3] = { type, COMPRESS_VERSION, COMPRESS_CODEC_LZSS };
+	int err;
+
+	err = app_dlc_flow_send(long_rd_id, APP_DLC_FLOW_SIGNALLING, APP_DLC_PORT_COMPRESSED, msg,
+				sizeof(msg), NULL);
+	if (err != 0) {
+		LOG_WRN("Compression hello to rd=%u failed: %d", long_rd_id, err);
+	}
+}
+
+void compress_peer_up(uint32_t long_rd_id)
+{
+	k_mutex_lock(&compress_mutex, K_FOREVER);
+	if (peer_add(long_rd_id) < 0) {
+		LOG_WRN("Compression peer table full, rd=%u stays uncompressed", long_rd_id);
+	}
+	k_mutex_unlock(&compress_mutex);
+
+	send_hello(long_rd_id, COMPRESS_MSG_HELLO);
+}
+
+void compress_peer_down(uint32_t long_rd_id)
+{
+	int i;
+
+	k_mutex_lock(&compress_mutex, K_FOREVER);
+	i = peer_find(long_rd_id);
+	if (i >= 0 && long_rd_id != 0) {
+		peers[i].long_rd_id = 0;
+		peers[i].codecs = 0;
+	}
+	k_mutex_unlock(&compress_mutex);
+}
+
+int compress_send(uint32_t long_rd_id, uint8_t port, const void *data, size_t len,
+		  uint32_t *transaction_id)
+{
+	uint32_t peer = long_rd_id;
+	uint8_t hdr[COMPRESS_DATA_HDR_LEN];
+	uint32_t start;
+	uint32_t us;
+	int clen;
+	int i;
+	int err;
+
+	k_mutex_lock(&compress_mutex, K_FOREVER);
+	if (!tx_enabled || data == NULL || len < CONFIG_APP_COMPRESS_MIN_LEN ||
+	    len > APP_DLC_PAYLOAD_LEN_MAX) {
+		goto raw;
+	}
+	if (peer == 0 && app_dlc_peer_get(&peer) != 0) {
+		goto raw;
+	}
+	i = peer_find(peer);
+	if (i < 0 || !(peers[i].codecs & COMPRESS_CODEC_LZSS)) {
+		goto raw;
+	}
+
+	start = k_cycle_get_32();
+	clen = lz_compress(data, len, tx_buf, len - COMPRESS_DATA_HDR_LEN - 1);
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	stats.tx_us += us;
+	stats.tx_us_max = MAX(stats.tx_us_max, us);
+	if (clen < 0) {
+		/* Would not shrink: the raw port is the per-message "uncompressed" flag. */
+		stats.tx_raw++;
+		goto raw;
+	}
+
+	hdr[0] = COMPRESS_MSG_DATA;
+	hdr[1] = port;
+	err = app_dlc_port_send_hdr(long_rd_id, APP_DLC_PORT_COMPRESSED, hdr, sizeof(hdr), tx_buf,
+				    (size_t)clen, transaction_id);
+	if (err == 0) {
+		stats.tx_compressed++;
+		stats.tx_bytes_in += len;
+		stats.tx_bytes_out += sizeof(hdr) + clen;
+	}
+	k_mutex_unlock(&compress_mutex);
+	return err;
+
+raw:
+	k_mutex_unlock(&compress_mutex);
+	return app_dlc_port_send(long_rd_id, port, data, len, transaction_id);
+}
+
+static void hello_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	int i;
+
+	if (len < 3) {
+		LOG_WRN("Compression hello from rd=%u too short", long_rd_id);
+		return;
+	}
+
+	k_mutex_lock(&compress_mutex, K_FOREVER);
+	i = peer_add(long_rd_id);
+	if (i >= 0) {
+		peers[i].codecs = data[2];
+	}
+	k_mutex_unlock(&compress_mutex);
+	LOG_DBG("Compression peer rd=%u: version %u codecs 0x%02x", long_rd_id, data[1], data[2]);
+
+	if (data[0] == COMPRESS_MSG_HELLO) {
+		send_hello(long_rd_id, COMPRESS_MSG_HELLO_ACK);
+	}
+}
+
+void compress_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		 app_dlc_dispatch_t dispatch)
+{
+	uint32_t start;
+	uint32_t us;
+	int n;
+
+	if (len < 1) {
+		return;
+	}
+
+	switch (data[0]) {
+	case COMPRESS_MSG_HELLO:
+	case COMPRESS_MSG_HELLO_ACK:
+		hello_rx(long_rd_id, data, len);
+		return;
+	case COMPRESS_MSG_DATA:
+		break;
+	default:
+		LOG_WRN("Compression: unknown type %u from rd=%u", data[0], long_rd_id);
+		return;
+	}
+
+	start = k_cycle_get_32();
+	if (len <= COMPRESS_DATA_HDR_LEN || data[1] == APP_DLC_PORT_COMPRESSED) {
+		n = -EBADMSG;
+	} else {
+		n = lz_decompress(&data[COMPRESS_DATA_HDR_LEN], len - COMPRESS_DATA_HDR_LEN, rx_buf,
+				  sizeof(rx_buf));
+	}
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	k_mutex_lock(&compress_mutex, K_FOREVER);
+	if (n <= 0) {
+		stats.rx_err++;
+	} else {
+		stats.rx_expanded++;
+		stats.rx_bytes_in += len;
+		stats.rx_bytes_out += n;
+		stats.rx_us += us;
+		stats.rx_us_max = MAX(stats.rx_us_max, us);
+	}
+	k_mutex_unlock(&compress_mutex);
+
+	if (n <= 0) {
+		LOG_WRN("Compression: corrupt payload from rd=%u (%zu B)", long_rd_id, len);
+		return;
+	}
+	dispatch(long_rd_id, data[1], rx_buf, (size_t)n);
+}
+
+/* One stats line: ratio as x.yy of uncompressed to compressed bytes, CPU time per codec run. */
+static void print_ratio(const struct shell *shell, const char *dir, uint32_t msgs,
+			uint32_t in, uint32_t out, uint32_t runs, uint64_t us, uint32_t us_max)
+{
+	uint32_t r100 = out ? (uint32_t)((100ULL * in) / out) : 0;
+
+	shell_print(shell, "COMPRESS %s: msgs=%u %u -> %u B ratio=%u.%02u cpu avg=%u us max=%u us",
+		    dir, msgs, in, out, r100 / 100U, r100 % 100U,
+		    runs ? (uint32_t)(us / runs) : 0, us_max);
+}
+
+/* COMPRESS [ON|OFF] */
+static int cmd_compress(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc >= 2) {
+		bool on;
+
+		if (strcmp(argv[1], "ON") == 0 || strcmp(argv[1], "on") == 0 ||
+		    strcmp(argv[1], "1") == 0) {
+			on = true;
+		} else if (strcmp(argv[1], "OFF") == 0 || strcmp(argv[1], "off") == 0 ||
+			   strcmp(argv[1], "0") == 0) {
+			on = false;
+		} else {
+			shell_error(shell, "Usage: COMPRESS [ON|OFF]");
+			return -EINVAL;
+		}
+		k_mutex_lock(&compress_mutex, K_FOREVER);
+		tx_enabled = on;
+		k_mutex_unlock(&compress_mutex);
+	}
+
+	k_mutex_lock(&compress_mutex, K_FOREVER);
+	shell_print(shell, "Compression TX: %s (payloads >= %u B)", tx_enabled ? "on" : "off",
+		    CONFIG_APP_COMPRESS_MIN_LEN);
+	for (int i = 0; i < COMPRESS_PEER_MAX; i++) {
+		if (peers[i].long_rd_id != 0) {
+			shell_print(shell, "  peer rd=%u: %s", peers[i].long_rd_id,
+				    (peers[i].codecs & COMPRESS_CODEC_LZSS) ? "LZSS" :
+				    "no codec announced");
+		}
+	}
+	print_ratio(shell, "TX", stats.tx_compressed, stats.tx_bytes_in, stats.tx_bytes_out,
+		    stats.tx_compressed + stats.tx_raw, stats.tx_us, stats.tx_us_max);
+	shell_print(shell, "COMPRESS TX: %u incompressible sent raw", stats.tx_raw);
+	print_ratio(shell, "RX", stats.rx_expanded, stats.rx_bytes_out, stats.rx_bytes_in,
+		    stats.rx_expanded, stats.rx_us, stats.rx_us_max);
+	shell_print(shell, "COMPRESS RX: %u corrupt", stats.rx_err);
+	k_mutex_unlock(&compress_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(COMPRESS, NULL, "COMPRESS [ON|OFF] — LZSS payload compression / stats", cmd_compress, 1, 1);
+SHELL_CMD_ARG_REGISTER(compress, NULL, "compress [on|off] — lzss payload compression / stats", cmd_compress, 1, 1);
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef COMPRESS_H__
+#define COMPRESS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "app_dlc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file compress.h
+ * @brief Optional LZSS compression of DLC payloads.
+ *
+ * When a link comes up both ends announce their codecs on
+ * APP_DLC_PORT_COMPRESSED; a payload is only compressed towards a peer that
+ * has announced LZSS. Compressed payloads travel on APP_DLC_PORT_COMPRESSED
+ * with the inner port in their header. Payloads shorter than
+ * CONFIG_APP_COMPRESS_MIN_LEN, or that would not shrink, are sent raw on their
+ * own port, so the port byte doubles as the per-message raw flag.
+ *
+ * The codec is LZSS with a 4096-byte window and 3..18-byte matches: a flag byte
+ * per group of eight items, a literal being one byte and a match two bytes
+ * (12-bit distance - 1, 4-bit length - 3).
+ */
+
+/**
+ * @brief Send a payload, compressed if the peer supports it and it helps.
+ *
+ * Must not be called with app_mutex held.
+ *
+ * @param long_rd_id     Destination, or 0 for the associated peer
+ * @param port           Service port of the payload
+ * @param data           Payload bytes
+ * @param len            Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @param transaction_id Output: transaction ID of the SDU (may be NULL)
+ * @return 0 on success, negative error code as for app_dlc_port_send()
+ */
+int compress_send(uint32_t long_rd_id, uint8_t port, const void *data, size_t len,
+		  uint32_t *transaction_id);
+
+/**
+ * @brief Announce our codecs to a peer whose link has just come up.
+ *
+ * Called from the main event loop after association.
+ *
+ * @param long_rd_id Peer long RD ID
+ */
+void compress_peer_up(uint32_t long_rd_id);
+
+/**
+ * @brief Forget the codecs of a peer whose link has gone down.
+ *
+ * @param long_rd_id Peer long RD ID
+ */
+void compress_peer_down(uint32_t long_rd_id);
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_COMPRESSED.
+ *
+ * Called from the main event loop. Capability messages update the peer
+ * table; compressed payloads are expanded and handed to @p dispatch.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload (port byte stripped)
+ * @param len        Payload length
+ * @param dispatch   Handler for the expanded payload
+ */
+void compress_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		 app_dlc_dispatch_t dispatch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMPRESS_H__ */
@@ -10,6 +10,7 @@
 #include <modem/nrf_modem_lib.h>
 #include <nrf_modem_dect.h>
 #include <zephyr/logging/log.h>
+#include "trace.h"
 
 LOG_MODULE_REGISTER(dect_adapter, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -121,7 +122,7 @@ static void internal_op_systemmode_cb(
 static void internal_op_cluster_configure_cb(
 	struct nrf_modem_dect_mac_cluster_configure_cb_params *params)
 {
-	LOG_INF("cluster_configure callback status=%d", params->status);
+	trace_event(TRACE_MODEM_CLUSTER_CONFIGURE, params->status, 0, 0);
 	if (app_op_cbs.cluster_configure) {
 		app_op_cbs.cluster_configure(params->status);
 	}
@@ -160,7 +161,7 @@ static void internal_op_network_beacon_configure_cb(
 static void internal_op_network_scan_cb(
 	struct nrf_modem_dect_mac_network_scan_cb_params *params)
 {
-	LOG_INF("network_scan callback status=%d scanned_channels=%u", params->status, params->num_scanned_channels);
+	trace_event(TRACE_MODEM_NETWORK_SCAN, params->status, params->num_scanned_channels, 0);
 	if (app_op_cbs.network_scan) {
 		app_op_cbs.network_scan(params->status);
 	}
@@ -196,8 +197,8 @@ static void internal_op_rssi_scan_stop_cb(
 static void internal_op_dlc_data_tx_cb(
 	struct nrf_modem_dect_dlc_data_tx_cb_params *params)
 {
-	LOG_DBG("op dlc_data_tx callback: status=%d txn=%u flow=%u rd=%u",
-		params->status, params->transaction_id, params->flow_id, params->long_rd_id);
+	trace_event(TRACE_MODEM_DLC_TX, params->status, params->transaction_id,
+		    params->long_rd_id);
 	if (app_op_cbs.dlc_data_tx) {
 		app_op_cbs.dlc_data_tx(params->status, params->transaction_id);
 	}
@@ -257,9 +258,8 @@ static void internal_ntf_association_release_cb(
 static void internal_ntf_association_ind_cb(
 	struct nrf_modem_dect_mac_association_ntf_cb_params *params)
 {
-	LOG_INF("FT association indication: status=%d rd=%u short_rd=%u ies=%u tx_method=%u",
-		params->status, params->long_rd_id, params->short_rd_id,
-		params->number_of_ies, params->tx_method);
+	trace_event(TRACE_MODEM_ASSOC_IND, params->status, params->long_rd_id,
+		    params->short_rd_id);
 
 	/* FT side: a PT has associated */
 	if (app_ntf_cbs.association_ind_ntf) {
@@ -334,8 +334,8 @@ static void internal_ntf_network_beacon_cb(
 static void internal_ntf_dlc_data_rx_cb(
 	struct nrf_modem_dect_dlc_data_rx_ntf_cb_params *params)
 {
-	LOG_INF("ntf dlc_data_rx callback: rd=%u flow=%u len=%zu",
-		params->long_rd_id, params->flow_id, params->data_len);
+	trace_event(TRACE_MODEM_DLC_RX, (int16_t)params->data_len, params->long_rd_id,
+		    params->flow_id);
 	if (app_ntf_cbs.dlc_data_rx_ntf) {
 		app_ntf_cbs.dlc_data_rx_ntf(params->long_rd_id, params->data, params->data_len);
 	}
@@ -344,8 +344,8 @@ static void internal_ntf_dlc_data_rx_cb(
 static void internal_ntf_cluster_ch_load_change_cb(
 	struct nrf_modem_dect_mac_cluster_ch_load_change_ntf_cb_params *params)
 {
-	LOG_DBG("ntf cluster_ch_load_change callback: ch=%u busy=%u%%",
-		params->rssi_result.channel, params->rssi_result.busy_percentage);
+	trace_event(TRACE_MODEM_CH_LOAD_CHANGE, params->rssi_result.busy_percentage,
+		    params->rssi_result.channel, 0);
 }
 
 static void internal_ntf_neighbor_inactivity_cb(
@@ -372,18 +372,16 @@ static void internal_ntf_capability_cb(
 {
 	LOG_DBG("capability callback: max_mcs=%u, bands=%u", params->max_mcs, params->num_band_info_elems);
 	for (uint8_t i = 0; i < params->num_band_info_elems; i++) {
-		LOG_INF("capability callback band[%u]: band=%u group=%u min=%u max=%u", i,
-			params->band_info_elems[i].band,
-			params->band_info_elems[i].band_group_index,
-			params->band_info_elems[i].min_carrier,
-			params->band_info_elems[i].max_carrier);
+		trace_event(TRACE_MODEM_CAPABILITY_BAND, params->band_info_elems[i].band,
+			    params->band_info_elems[i].min_carrier,
+			    params->band_info_elems[i].max_carrier);
 	}
 }
 
 static void internal_ntf_dlc_flow_control_cb(
 	struct nrf_modem_dect_dlc_flow_control_ntf_cb_params *params)
 {
-	LOG_DBG("ntf dlc_flow_control callback: status=%d", params->status);
+	trace_event(TRACE_MODEM_DLC_FLOW_CONTROL, params->status, 0, 0);
 }
 
 static const struct nrf_modem_dect_mac_op_callbacks internal_op_callbacks = {
@@ -500,8 +498,9 @@ int dect_adapter_control_configure(
 	*/
 	params.stats_averaging_length = 2;
 
-	printk("Device control_configure: tx=%d dBm mcs=%d rd=%u carrier=%u pwrsave=%u \n",
+	LOG_DBG("control_configure: tx=%d dBm mcs=%d rd=%u carrier=%u pwrsave=%u",
 		max_tx_power_dbm, max_mcs, long_rd_id, carrier, powersave);
+	trace_event(TRACE_MODEM_CONTROL_CONFIGURE, max_tx_power_dbm, long_rd_id, carrier);
 	err = nrf_modem_dect_control_configure(&params);
 	if (err != 0) {
 		LOG_ERR("control_configure failed: %d", err);
@@ -544,6 +543,33 @@ int dect_adapter_rssi_scan_start(
 	return err;
 }
 
+int dect_adapter_rssi_scan_channel_start(
+	uint16_t channel,
+	uint16_t scan_frames,
+	int threshold_low,
+	int threshold_high)
+{
+	int err;
+	/* channel_list is a trailing array: room for one entry. */
+	uint8_t buf[sizeof(struct nrf_modem_dect_mac_rssi_scan_params) + sizeof(uint16_t)]
+		__aligned(4) = {0};
+	struct nrf_modem_dect_mac_rssi_scan_params *params = (void *)buf;
+
+	params->channel_scan_length = scan_frames;
+	params->threshold_min = threshold_low;
+	params->threshold_max = threshold_high;
+	params->band = band_from_carrier(channel);
+	params->num_channels = 1;
+	params->channel_list[0] = channel;
+
+	LOG_DBG("rssi_scan: ch=%u frames=%u", channel, scan_frames);
+	err = nrf_modem_dect_mac_rssi_scan(params);
+	if (err != 0) {
+		LOG_WRN("rssi_scan ch=%u failed: %d", channel, err);
+	}
+	return err;
+}
+
 int dect_adapter_rssi_scan_stop(void)
 {
 	int err;
@@ -560,14 +586,15 @@ int dect_adapter_cluster_configure_ft(
 	uint32_t cluster_beacon_period,
 	uint32_t network_id,
 	int tx_power_dbm,
-	uint8_t rach_fill_percentage)
+	const struct dect_adapter_rach_params *rach,
+	uint8_t max_associations)
 {
 	int err;
 	struct nrf_modem_dect_mac_association_config association_config = {0};
 	struct nrf_modem_dect_mac_cluster_config cluster_config = {0};
 	struct nrf_modem_dect_mac_cluster_configure_params params = {0};
 
-	association_config.max_num_neighbours = 4;
+	association_config.max_num_neighbours = max_associations;
 	association_config.max_num_ft_neighbours = 1;
 	association_config.default_tx_flow_config[0].dlc_service_type =
 		NRF_MODEM_DECT_DLC_SERVICE_TYPE_3;
@@ -596,11 +623,13 @@ int dect_adapter_cluster_configure_ft(
 	cluster_config.cluster_channel = channel;
 	cluster_config.network_id = network_id;
 	cluster_config.rach_configuration.policy = NRF_MODEM_DECT_MAC_RACH_CONFIG_POLICY_FILL;
-	cluster_config.rach_configuration.common.response_window_length = 8;
-	cluster_config.rach_configuration.common.max_transmission_length = 8;
-	cluster_config.rach_configuration.common.cw_min_sig = 1;
-	cluster_config.rach_configuration.common.cw_max_sig = 5;
-	cluster_config.rach_configuration.config.fill.percentage = rach_fill_percentage;
+	cluster_config.rach_configuration.common.response_window_length =
+		rach->response_window_length;
+	cluster_config.rach_configuration.common.max_transmission_length =
+		rach->max_transmission_length;
+	cluster_config.rach_configuration.common.cw_min_sig = rach->cw_min_sig;
+	cluster_config.rach_configuration.common.cw_max_sig = rach->cw_max_sig;
+	cluster_config.rach_configuration.config.fill.percentage = rach->fill_percentage;
 	cluster_config.triggers.busy_threshold = 70;
 	cluster_config.ipv6_config.type = NRF_MODEM_DECT_MAC_IPV6_ADDRESS_TYPE_NONE;
 	
@@ -608,8 +637,9 @@ int dect_adapter_cluster_configure_ft(
 	params.association_config = &association_config;
 	params.cluster_config = &cluster_config;
 
-	LOG_INF("cluster_configure_ft: ch=%u period=%u ms nw=%u tx=%d dBm",
-		channel, cluster_beacon_period, network_id, tx_power_dbm);
+	LOG_INF("cluster_configure_ft: ch=%u period=%u ms nw=%u tx=%d dBm rach=%u%% cw=%u..%u",
+		channel, cluster_beacon_period, network_id, tx_power_dbm, rach->fill_percentage,
+		rach->cw_min_sig, rach->cw_max_sig);
 	err = nrf_modem_dect_mac_cluster_configure(&params);
 	if (err != 0) {
 		LOG_ERR("cluster_configure failed: %d", err);
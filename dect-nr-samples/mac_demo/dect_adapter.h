@@ -66,6 +66,22 @@ struct dect_adapter_ntf_callbacks {
 	void (*cluster_beacon_rx_failure_ntf)(uint32_t long_rd_id);
 };
 
+/** FT random access (RACH) resources, fill policy. */
+struct dect_adapter_rach_params {
+	uint8_t fill_percentage;         /**< Share of the beacon interval for RACH, 1-100 */
+	uint8_t cw_min_sig;              /**< Minimum contention window, signalled value 0-7 */
+	uint8_t cw_max_sig;              /**< Maximum contention window, signalled value 0-7 */
+	uint8_t response_window_length;  /**< RACH response window, subslots */
+	uint8_t max_transmission_length; /**< Longest RACH transmission, subslots */
+};
+
+/** RACH parameters used before any tuning. */
+#define DECT_ADAPTER_RACH_PARAMS_DEFAULT                                                          \
+	{                                                                                          \
+		.fill_percentage = 100, .cw_min_sig = 1, .cw_max_sig = 5,                          \
+		.response_window_length = 8, .max_transmission_length = 8,                         \
+	}
+
 /* ============================================================================
  * INITIALIZATION
  * ========================================================================== */
@@ -154,6 +170,24 @@ int dect_adapter_rssi_scan_start(
 	int threshold_low,
 	int threshold_high);
 
+/**
+ * @brief Start RSSI scan on one channel.
+ *
+ * Reports and completes like dect_adapter_rssi_scan_start(). Short enough
+ * to fit between the duties of an active FT, where the modem allows it.
+ *
+ * @param channel        Carrier to measure
+ * @param scan_frames    Measurement length in frames (10 ms each)
+ * @param threshold_low  Lower RSSI threshold in dBm
+ * @param threshold_high Upper RSSI threshold in dBm
+ * @return 0 on success, negative error code on failure
+ */
+int dect_adapter_rssi_scan_channel_start(
+	uint16_t channel,
+	uint16_t scan_frames,
+	int threshold_low,
+	int threshold_high);
+
 /**
  * @brief Stop active RSSI scan.
  *
@@ -172,6 +206,8 @@ int dect_adapter_rssi_scan_stop(void);
  * @param cluster_beacon_period Beacon period in ms (10, 50, 100, 500, 1000, ...)
  * @param network_id            Network identifier
  * @param tx_power_dbm          TX power in dBm
+ * @param rach                  RACH resources and contention window
+ * @param max_associations      PTs the FT accepts (modem max_num_neighbours)
  * @return 0 on success, negative error code on failure
  */
 int dect_adapter_cluster_configure_ft(
@@ -179,7 +215,8 @@ int dect_adapter_cluster_configure_ft(
 	uint32_t cluster_beacon_period,
 	uint32_t network_id,
 	int tx_power_dbm,
-	uint8_t rach_fill_percentage);
+	const struct dect_adapter_rach_params *rach,
+	uint8_t max_associations);
 
 /**
  * @brief Configure network beacon for FT.
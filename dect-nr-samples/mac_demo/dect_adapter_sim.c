@@ -0,0 +1,1066 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Simulated DECT MAC for native_sim (CONFIG_APP_SIM_RADIO), built instead of
+ * dect_adapter.c. Each instance talks to python/radio_medium.py over UDP
+ * (see dect_sim_bottom.c); the medium applies path loss, channel load and
+ * packet errors and forwards frames to the other instances. The MAC behaviour
+ * the application relies on is modelled here: beaconing, network scans,
+ * cluster beacon subscription with RX failure after three missed beacons,
+ * association with NO_RESPONSE timeout, release, and DLC data with
+ * asynchronous TX completions.
+ *
+ * Datagrams, little endian:
+ *   node -> medium: [u8 type][u32 source long RD ID][body]
+ *   medium -> node: [u8 type][u32 source long RD ID][i16 RSSI dBm][body]
+ * Bodies per type are listed in enum sim_msg; frames forwarded by the medium
+ * keep the body they were sent with.
+ */
+
+#include "dect_adapter.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <cmdline.h>
+#include <posix_native_task.h>
+#include "dect_sim_bottom.h"
+#include "trace.h"
+
+LOG_MODULE_REGISTER(dect_adapter, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define SIM_PEER_MAX          64   /* table size; the FT limit is max_associations */
+#define SIM_POLL_MS           1
+#define SIM_BEACON_RX_FAILURES 3
+#define SIM_ASSOC_TIMEOUT_MS  1000
+#define SIM_RSSI_SCAN_TIMEOUT_MS 2000
+#define SIM_STATUS_NO_RESPONSE 8   /* modem association status used by main.c */
+#define SIM_STATUS_REJECTED   1
+#define SIM_CHANNEL_ALL       0
+#define SIM_CHANNEL_OFF       0xffff
+#define SIM_BAND1_FIRST       1657
+#define SIM_BAND1_LAST        1677
+#define SIM_RSSI_SLOTS        48
+#define SIM_HEARD_MAX         8
+
+#define SIM_TX_HDR_LEN        5 /* type, source */
+#define SIM_RX_HDR_LEN        7 /* type, source, RSSI */
+#define SIM_DATA_HDR_LEN      9 /* destination, transaction ID, flow */
+#define SIM_DGRAM_LEN_MAX     (SIM_RX_HDR_LEN + SIM_DATA_HDR_LEN + CONFIG_APP_DLC_SDU_LEN_MAX)
+
+enum sim_msg {
+	/** [u16 channel, 0 = all band 1 channels, 0xffff = radio off, u16 second channel or 0xffff] */
+	SIM_MSG_TUNE = 0x01,
+	/** [u8 kind (0 network, 1 cluster), u16 channel, u32 network ID, u32 cluster period ms] */
+	SIM_MSG_BEACON = 0x02,
+	/** [u32 destination, u32 network ID] */
+	SIM_MSG_ASSOC_REQ = 0x03,
+	/** [u32 destination, i16 status] */
+	SIM_MSG_ASSOC_RESP = 0x04,
+	/** [u32 destination] */
+	SIM_MSG_RELEASE = 0x05,
+	/** [u32 destination, u32 transaction ID, u8 flow, payload] */
+	SIM_MSG_DATA = 0x06,
+	/** medium -> node: [u32 transaction ID, i16 status] */
+	SIM_MSG_TX_RESULT = 0x07,
+	/** [u16 channel] */
+	SIM_MSG_RSSI_REQ = 0x08,
+	/** medium -> node: [u16 channel, u8 busy percentage] */
+	SIM_MSG_RSSI_RESULT = 0x09,
+};
+
+/* Operation completions are delivered from the simulation thread, after the
+ * call that started them has returned, as the modem does. */
+enum sim_op {
+	SIM_OP_FUNCTIONAL_MODE,
+	SIM_OP_CONFIGURE,
+	SIM_OP_SYSTEMMODE,
+	SIM_OP_CLUSTER_CONFIGURE,
+	SIM_OP_CLUSTER_BEACON_RECEIVE,
+	SIM_OP_CLUSTER_BEACON_RECEIVE_STOP,
+	SIM_OP_NETWORK_BEACON_CONFIGURE,
+	SIM_OP_NETWORK_SCAN,
+	SIM_OP_NETWORK_SCAN_STOP,
+	SIM_OP_RSSI_SCAN,
+	SIM_OP_RSSI_SCAN_STOP,
+	SIM_OP_DLC_DATA_TX,
+};
+
+struct sim_completion {
+	uint8_t op;
+	int status;
+	uint32_t transaction_id;
+};
+
+enum sim_ntf_type {
+	SIM_NTF_CLUSTER_BEACON,
+	SIM_NTF_NETWORK_BEACON,
+	SIM_NTF_ASSOCIATION,
+	SIM_NTF_ASSOCIATION_IND,
+	SIM_NTF_ASSOCIATION_RELEASE,
+	SIM_NTF_DLC_DATA_RX,
+	SIM_NTF_RSSI_SCAN,
+	SIM_NTF_BEACON_RX_FAILURE,
+};
+
+/* Notifications are recorded under sim_mutex and delivered after it is
+ * released, so the application's callbacks can take their own locks while
+ * other threads call into the adapter. Only the simulation thread records
+ * and delivers them. */
+struct sim_ntf {
+	uint8_t type;
+	int16_t value;       /* status, RSSI dBm or busy percentage */
+	uint16_t channel;
+	uint32_t long_rd_id;
+	uint32_t network_id;
+	uint32_t period_ms;
+	const uint8_t *data; /* DLC payload in rx_buf */
+	size_t len;
+};
+
+#define SIM_NTF_MAX 4 /* per datagram or timer pass */
+
+static struct dect_adapter_op_callbacks app_op_cbs;
+static struct dect_adapter_ntf_callbacks app_ntf_cbs;
+
+static char *medium_arg;
+
+static struct {
+	uint32_t long_rd_id;
+	uint16_t tuned;
+	uint16_t tuned2; /* second receive channel (relay: the parent's) */
+	/* FT beaconing */
+	bool ft_active;
+	uint16_t ft_channel;
+	uint32_t ft_network_id;
+	uint32_t ft_period_ms;
+	uint32_t nw_period_ms;
+	uint8_t ft_max_peers;
+	int64_t next_cluster_beacon_ms;
+	int64_t next_nw_beacon_ms;
+	/* PT network scan */
+	bool scanning;
+	uint16_t scan_channel;
+	uint32_t scan_network_id;
+	int64_t scan_end_ms;
+	/* PT cluster beacon subscription */
+	bool subscribed;
+	bool sub_failed;
+	uint16_t sub_channel;
+	uint32_t sub_long_rd_id;
+	uint32_t sub_period_ms;
+	int64_t sub_last_ms;
+	/* PT association request in progress */
+	bool assoc_pending;
+	uint16_t assoc_channel;
+	uint32_t assoc_long_rd_id;
+	int64_t assoc_deadline_ms;
+	/* FT RSSI scan */
+	bool rssi_scanning;
+	uint8_t rssi_pending;
+	int64_t rssi_deadline_ms;
+	/* Associated peers */
+	uint32_t peers[SIM_PEER_MAX];
+	/* Channel of recently heard FTs, to tune for association */
+	struct {
+		uint32_t long_rd_id;
+		uint16_t channel;
+	} heard[SIM_HEARD_MAX];
+	uint8_t heard_next;
+} sim;
+
+static K_MUTEX_DEFINE(sim_mutex);
+K_MSGQ_DEFINE(sim_completion_q, sizeof(struct sim_completion), 16, 4);
+
+static uint8_t tx_buf[SIM_DGRAM_LEN_MAX];
+static uint8_t rx_buf[SIM_DGRAM_LEN_MAX];
+static struct sim_ntf ntf_pending[SIM_NTF_MAX];
+static size_t ntf_count;
+
+/* ============================================================================
+ * COMMAND LINE
+ * ========================================================================== */
+
+static void sim_add_options(void)
+{
+	static struct args_struct_t options[] = {
+		{ .option = "dect_medium", .name = "host:port", .type = 's',
+		  .dest = (void *)&medium_arg,
+		  .descript = "UDP address of python/radio_medium.py (default 127.0.0.1:"
+			      STRINGIFY(CONFIG_APP_SIM_RADIO_MEDIUM_PORT) ")" },
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(options);
+}
+
+NATIVE_TASK(sim_add_options, PRE_BOOT_1, 10);
+
+/* ============================================================================
+ * INTERNAL UTILITY FUNCTIONS (not exported)
+ * ========================================================================== */
+
+static void complete_op(uint8_t op, int status, uint32_t transaction_id)
+{
+	struct sim_completion c = {
+		.op = op,
+		.status = status,
+		.transaction_id = transaction_id,
+	};
+
+	if (k_msgq_put(&sim_completion_q, &c, K_NO_WAIT) != 0) {
+		LOG_ERR("sim: completion queue full, op %u lost", op);
+	}
+}
+
+/* Send [type][own RD ID][body] to the medium. Must be called with sim_mutex held. */
+static int send_locked(uint8_t type, const void *body, size_t body_len)
+{
+	if (SIM_TX_HDR_LEN + body_len > sizeof(tx_buf)) {
+		return -EMSGSIZE;
+	}
+	tx_buf[0] = type;
+	sys_put_le32(sim.long_rd_id, &tx_buf[1]);
+	if (body_len > 0) {
+		memcpy(&tx_buf[SIM_TX_HDR_LEN], body, body_len);
+	}
+	return (dect_sim_bottom_send(tx_buf, SIM_TX_HDR_LEN + body_len) == 0) ? 0 : -EIO;
+}
+
+/* Tell the medium which channels the receiver is on. Must be called with sim_mutex held. */
+static void retune_locked(void)
+{
+	uint16_t ch = SIM_CHANNEL_OFF;
+	uint16_t ch2 = SIM_CHANNEL_OFF;
+	uint8_t body[4];
+
+	if (sim.scanning) {
+		ch = sim.scan_channel;
+	} else if (sim.ft_active) {
+		ch = sim.ft_channel;
+		/* Relay: an FT that is also associated upstream follows its parent too. */
+		if (sim.subscribed && sim.sub_channel != ch) {
+			ch2 = sim.sub_channel;
+		}
+	} else if (sim.subscribed) {
+		ch = sim.sub_channel;
+	} else if (sim.assoc_pending) {
+		ch = sim.assoc_channel;
+	} else if (sim.tuned != SIM_CHANNEL_ALL) {
+		/* Associated without subscription: stay where the peer is. */
+		for (int i = 0; i < SIM_PEER_MAX; i++) {
+			if (sim.peers[i] != 0) {
+				ch = sim.tuned;
+			}
+		}
+	}
+
+	if (ch != sim.tuned || ch2 != sim.tuned2) {
+		sim.tuned = ch;
+		sim.tuned2 = ch2;
+		sys_put_le16(ch, body);
+		sys_put_le16(ch2, &body[2]);
+		(void)send_locked(SIM_MSG_TUNE, body, sizeof(body));
+	}
+}
+
+/* Must be called with sim_mutex held. */
+static int peer_find(uint32_t long_rd_id)
+{
+	for (int i = 0; i < SIM_PEER_MAX; i++) {
+		if (sim.peers[i] == long_rd_id) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Must be called with sim_mutex held. Returns false when the table is full;
+ * an FT accepts max_associations PTs, a PT one FT. */
+static bool peer_add(uint32_t long_rd_id)
+{
+	int n = 0;
+
+	if (peer_find(long_rd_id) >= 0) {
+		return true;
+	}
+	for (int i = 0; i < SIM_PEER_MAX; i++) {
+		n += (sim.peers[i] != 0);
+	}
+	if (n >= (sim.ft_active ? sim.ft_max_peers : 1)) {
+		return false;
+	}
+	for (int i = 0; i < SIM_PEER_MAX; i++) {
+		if (sim.peers[i] == 0) {
+			sim.peers[i] = long_rd_id;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Must be called with sim_mutex held. */
+static bool peer_remove(uint32_t long_rd_id)
+{
+	int i = peer_find(long_rd_id);
+
+	if (i < 0) {
+		return false;
+	}
+	sim.peers[i] = 0;
+	return true;
+}
+
+/* Must be called with sim_mutex held. */
+static void heard_note_locked(uint32_t long_rd_id, uint16_t channel)
+{
+	for (int i = 0; i < SIM_HEARD_MAX; i++) {
+		if (sim.heard[i].long_rd_id == long_rd_id) {
+			sim.heard[i].channel = channel;
+			return;
+		}
+	}
+	sim.heard[sim.heard_next].long_rd_id = long_rd_id;
+	sim.heard[sim.heard_next].channel = channel;
+	sim.heard_next = (sim.heard_next + 1) % SIM_HEARD_MAX;
+}
+
+/* Must be called with sim_mutex held. */
+static uint16_t heard_channel_locked(uint32_t long_rd_id)
+{
+	for (int i = 0; i < SIM_HEARD_MAX; i++) {
+		if (sim.heard[i].long_rd_id == long_rd_id) {
+			return sim.heard[i].channel;
+		}
+	}
+	return sim.tuned;
+}
+
+static void send_beacon_locked(uint8_t kind)
+{
+	uint8_t body[11];
+
+	body[0] = kind;
+	sys_put_le16(sim.ft_channel, &body[1]);
+	sys_put_le32(sim.ft_network_id, &body[3]);
+	sys_put_le32(sim.ft_period_ms, &body[7]);
+	(void)send_locked(SIM_MSG_BEACON, body, sizeof(body));
+}
+
+/* Record a notification for ntf_deliver(). Must be called with sim_mutex held. */
+static struct sim_ntf *ntf_add_locked(uint8_t type, uint32_t long_rd_id)
+{
+	struct sim_ntf *n;
+
+	if (ntf_count >= ARRAY_SIZE(ntf_pending)) {
+		LOG_ERR("sim: notification %u for rd=%u lost", type, long_rd_id);
+		return NULL;
+	}
+	n = &ntf_pending[ntf_count++];
+	memset(n, 0, sizeof(*n));
+	n->type = type;
+	n->long_rd_id = long_rd_id;
+	return n;
+}
+
+/* ============================================================================
+ * SIMULATION THREAD — plays the role of the modem callback context
+ * ========================================================================== */
+
+static void deliver_completion(const struct sim_completion *c)
+{
+	void (*cb)(int status) = NULL;
+
+	switch (c->op) {
+	case SIM_OP_FUNCTIONAL_MODE:             cb = app_op_cbs.functional_mode; break;
+	case SIM_OP_CONFIGURE:                   cb = app_op_cbs.configure; break;
+	case SIM_OP_SYSTEMMODE:                  cb = app_op_cbs.systemmode; break;
+	case SIM_OP_CLUSTER_CONFIGURE:           cb = app_op_cbs.cluster_configure; break;
+	case SIM_OP_CLUSTER_BEACON_RECEIVE:      cb = app_op_cbs.cluster_beacon_receive; break;
+	case SIM_OP_CLUSTER_BEACON_RECEIVE_STOP: cb = app_op_cbs.cluster_beacon_receive_stop; break;
+	case SIM_OP_NETWORK_BEACON_CONFIGURE:    cb = app_op_cbs.network_beacon_configure; break;
+	case SIM_OP_NETWORK_SCAN:                cb = app_op_cbs.network_scan; break;
+	case SIM_OP_NETWORK_SCAN_STOP:           cb = app_op_cbs.network_scan_stop; break;
+	case SIM_OP_RSSI_SCAN:                   cb = app_op_cbs.rssi_scan; break;
+	case SIM_OP_RSSI_SCAN_STOP:              cb = app_op_cbs.rssi_scan_stop; break;
+	case SIM_OP_DLC_DATA_TX:
+		LOG_DBG("op dlc_data_tx callback: status=%d tx=%u", c->status, c->transaction_id);
+		if (app_op_cbs.dlc_data_tx) {
+			app_op_cbs.dlc_data_tx(c->status, c->transaction_id);
+		}
+		return;
+	default:
+		return;
+	}
+
+	LOG_DBG("op %u callback: status=%d", c->op, c->status);
+	if (cb) {
+		cb(c->status);
+	}
+}
+
+/* Deliver the recorded notifications. Called without sim_mutex. */
+static void ntf_deliver(void)
+{
+	for (size_t i = 0; i < ntf_count; i++) {
+		const struct sim_ntf *n = &ntf_pending[i];
+		size_t free_slots;
+
+		switch (n->type) {
+		case SIM_NTF_CLUSTER_BEACON:
+			if (app_ntf_cbs.cluster_beacon_ntf) {
+				app_ntf_cbs.cluster_beacon_ntf(n->channel, n->network_id, n->long_rd_id,
+							       n->period_ms, n->value);
+			}
+			break;
+		case SIM_NTF_NETWORK_BEACON:
+			if (app_ntf_cbs.network_beacon_ntf) {
+				app_ntf_cbs.network_beacon_ntf(n->channel, n->network_id, n->long_rd_id,
+							       n->period_ms, n->value);
+			}
+			break;
+		case SIM_NTF_ASSOCIATION:
+			if (app_ntf_cbs.association_ntf) {
+				app_ntf_cbs.association_ntf(n->value, n->long_rd_id);
+			}
+			break;
+		case SIM_NTF_ASSOCIATION_IND:
+			if (app_ntf_cbs.association_ind_ntf) {
+				app_ntf_cbs.association_ind_ntf(n->value, n->long_rd_id);
+			}
+			break;
+		case SIM_NTF_ASSOCIATION_RELEASE:
+			if (app_ntf_cbs.association_release_ntf) {
+				app_ntf_cbs.association_release_ntf(n->long_rd_id);
+			}
+			break;
+		case SIM_NTF_DLC_DATA_RX:
+			if (app_ntf_cbs.dlc_data_rx_ntf) {
+				app_ntf_cbs.dlc_data_rx_ntf(n->long_rd_id, n->data, n->len);
+			}
+			break;
+		case SIM_NTF_RSSI_SCAN:
+			free_slots = SIM_RSSI_SLOTS * (100U - n->value) / 100U;
+			if (app_ntf_cbs.rssi_scan_ntf) {
+				app_ntf_cbs.rssi_scan_ntf(n->channel, (uint8_t)n->value, free_slots,
+							  free_slots, SIM_RSSI_SLOTS);
+			}
+			break;
+		case SIM_NTF_BEACON_RX_FAILURE:
+			if (app_ntf_cbs.cluster_beacon_rx_failure_ntf) {
+				app_ntf_cbs.cluster_beacon_rx_failure_ntf(n->long_rd_id);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	ntf_count = 0;
+}
+
+static void rx_beacon_locked(uint32_t src, int16_t rssi, const uint8_t *body, size_t len)
+{
+	uint8_t kind;
+	uint16_t ch;
+	uint32_t nw;
+	uint32_t period;
+	bool from_parent;
+	bool scan_match;
+	struct sim_ntf *n;
+
+	if (len < 11) {
+		return;
+	}
+	kind = body[0];
+	ch = sys_get_le16(&body[1]);
+	nw = sys_get_le32(&body[3]);
+	period = sys_get_le32(&body[7]);
+
+	from_parent = (kind == 1 && sim.subscribed && src == sim.sub_long_rd_id);
+	scan_match = sim.scanning &&
+		     (sim.scan_channel == SIM_CHANNEL_ALL || sim.scan_channel == ch) &&
+		     (sim.scan_network_id == 0 || sim.scan_network_id == nw);
+
+	if (from_parent) {
+		sim.sub_last_ms = k_uptime_get();
+		sim.sub_failed = false;
+		/* Like the modem, supervise with the period the beacon announces. */
+		if (period != 0) {
+			sim.sub_period_ms = period;
+		}
+	}
+	if (!from_parent && !scan_match) {
+		return;
+	}
+	if (scan_match) {
+		heard_note_locked(src, ch);
+	}
+
+	LOG_DBG("%s beacon ntf: ch=%u nw=%u rd=%u period=%u ms rssi=%d",
+		kind ? "cluster" : "network", ch, nw, src, period, rssi);
+	n = ntf_add_locked(kind ? SIM_NTF_CLUSTER_BEACON : SIM_NTF_NETWORK_BEACON, src);
+	if (n != NULL) {
+		n->channel = ch;
+		n->network_id = nw;
+		n->period_ms = period;
+		n->value = rssi;
+	}
+}
+
+static void rx_assoc_req_locked(uint32_t src, const uint8_t *body, size_t len)
+{
+	uint8_t resp[6];
+	bool known;
+	bool accepted;
+
+	if (len < 8 || !sim.ft_active || sys_get_le32(&body[4]) != sim.ft_network_id) {
+		return;
+	}
+	known = peer_find(src) >= 0;
+	accepted = peer_add(src);
+
+	sys_put_le32(src, resp);
+	sys_put_le16((uint16_t)(accepted ? 0 : SIM_STATUS_REJECTED), &resp[4]);
+	(void)send_locked(SIM_MSG_ASSOC_RESP, resp, sizeof(resp));
+
+	LOG_DBG("ntf association_ind callback: rd=%u %s", src,
+		!accepted ? "rejected (table full)" : known ? "(re-association)" : "");
+	if (accepted) {
+		(void)ntf_add_locked(SIM_NTF_ASSOCIATION_IND, src);
+	}
+}
+
+static void rx_assoc_resp_locked(uint32_t src, const uint8_t *body, size_t len)
+{
+	struct sim_ntf *n;
+	int16_t status;
+
+	if (len < 6 || !sim.assoc_pending || src != sim.assoc_long_rd_id) {
+		return;
+	}
+	status = (int16_t)sys_get_le16(&body[4]);
+	sim.assoc_pending = false;
+	if (status == 0) {
+		(void)peer_add(src);
+	}
+	retune_locked();
+	LOG_DBG("op association callback: status=%d rd=%u", status, src);
+	n = ntf_add_locked(SIM_NTF_ASSOCIATION, src);
+	if (n != NULL) {
+		n->value = status;
+	}
+}
+
+static void rx_data_locked(uint32_t src, const uint8_t *body, size_t len)
+{
+	uint8_t release[4];
+	struct sim_ntf *n;
+
+	if (len <= SIM_DATA_HDR_LEN) {
+		return;
+	}
+	if (peer_find(src) < 0) {
+		/* Not associated with us (e.g. after a restart): tell the sender. */
+		sys_put_le32(src, release);
+		(void)send_locked(SIM_MSG_RELEASE, release, sizeof(release));
+		return;
+	}
+	LOG_DBG("ntf dlc_data_rx callback: rd=%u flow=%u len=%zu", src, body[8],
+		len - SIM_DATA_HDR_LEN);
+	n = ntf_add_locked(SIM_NTF_DLC_DATA_RX, src);
+	if (n != NULL) {
+		n->data = &body[SIM_DATA_HDR_LEN];
+		n->len = len - SIM_DATA_HDR_LEN;
+	}
+}
+
+static void rx_rssi_result_locked(const uint8_t *body, size_t len)
+{
+	struct sim_ntf *n;
+
+	if (len < 3 || !sim.rssi_scanning) {
+		return;
+	}
+	n = ntf_add_locked(SIM_NTF_RSSI_SCAN, 0);
+	if (n != NULL) {
+		n->channel = sys_get_le16(body);
+		n->value = MIN(body[2], 100);
+	}
+	if (--sim.rssi_pending == 0) {
+		sim.rssi_scanning = false;
+		complete_op(SIM_OP_RSSI_SCAN, 0, 0);
+	}
+}
+
+static void rx_dgram(const uint8_t *buf, size_t len)
+{
+	uint32_t src;
+	int16_t rssi;
+	const uint8_t *body = &buf[SIM_RX_HDR_LEN];
+	size_t body_len = len - SIM_RX_HDR_LEN;
+
+	if (len < SIM_RX_HDR_LEN) {
+		return;
+	}
+	src = sys_get_le32(&buf[1]);
+	rssi = (int16_t)sys_get_le16(&buf[5]);
+
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	switch (buf[0]) {
+	case SIM_MSG_BEACON:
+		rx_beacon_locked(src, rssi, body, body_len);
+		break;
+	case SIM_MSG_ASSOC_REQ:
+		rx_assoc_req_locked(src, body, body_len);
+		break;
+	case SIM_MSG_ASSOC_RESP:
+		rx_assoc_resp_locked(src, body, body_len);
+		break;
+	case SIM_MSG_RELEASE:
+		if (peer_remove(src)) {
+			retune_locked();
+			LOG_DBG("ntf association_release callback: rd=%u", src);
+			(void)ntf_add_locked(SIM_NTF_ASSOCIATION_RELEASE, src);
+		}
+		break;
+	case SIM_MSG_DATA:
+		rx_data_locked(src, body, body_len);
+		break;
+	case SIM_MSG_TX_RESULT:
+		if (body_len >= 6) {
+			complete_op(SIM_OP_DLC_DATA_TX, (int16_t)sys_get_le16(&body[4]),
+				    sys_get_le32(body));
+		}
+		break;
+	case SIM_MSG_RSSI_RESULT:
+		rx_rssi_result_locked(body, body_len);
+		break;
+	default:
+		break;
+	}
+	k_mutex_unlock(&sim_mutex);
+	ntf_deliver();
+}
+
+/* Beacon timing, scan dwell and supervision timeouts. */
+static void run_timers(void)
+{
+	int64_t now = k_uptime_get();
+	struct sim_ntf *n;
+
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	if (sim.ft_active && now >= sim.next_cluster_beacon_ms) {
+		send_beacon_locked(1);
+		sim.next_cluster_beacon_ms += sim.ft_period_ms;
+	}
+	if (sim.ft_active && sim.nw_period_ms != 0 && now >= sim.next_nw_beacon_ms) {
+		send_beacon_locked(0);
+		sim.next_nw_beacon_ms += sim.nw_period_ms;
+	}
+	if (sim.scanning && now >= sim.scan_end_ms) {
+		sim.scanning = false;
+		retune_locked();
+		complete_op(SIM_OP_NETWORK_SCAN, 0, 0);
+	}
+	if (sim.subscribed && !sim.sub_failed &&
+	    now - sim.sub_last_ms > (int64_t)SIM_BEACON_RX_FAILURES * sim.sub_period_ms) {
+		sim.sub_failed = true;
+		LOG_DBG("ntf cluster_beacon_rx_failure callback: rd=%u", sim.sub_long_rd_id);
+		(void)ntf_add_locked(SIM_NTF_BEACON_RX_FAILURE, sim.sub_long_rd_id);
+	}
+	if (sim.assoc_pending && now >= sim.assoc_deadline_ms) {
+		sim.assoc_pending = false;
+		retune_locked();
+		n = ntf_add_locked(SIM_NTF_ASSOCIATION, sim.assoc_long_rd_id);
+		if (n != NULL) {
+			n->value = SIM_STATUS_NO_RESPONSE;
+		}
+	}
+	if (sim.rssi_scanning && now >= sim.rssi_deadline_ms) {
+		sim.rssi_scanning = false;
+		LOG_WRN("sim: RSSI scan incomplete, %u channel(s) unanswered — is the medium running?",
+			sim.rssi_pending);
+		complete_op(SIM_OP_RSSI_SCAN, 0, 0);
+	}
+	k_mutex_unlock(&sim_mutex);
+	ntf_deliver();
+}
+
+static void sim_thread(void *p1, void *p2, void *p3)
+{
+	struct sim_completion c;
+	int n;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		while (k_msgq_get(&sim_completion_q, &c, K_NO_WAIT) == 0) {
+			deliver_completion(&c);
+		}
+		n = dect_sim_bottom_recv(rx_buf, sizeof(rx_buf));
+		if (n > 0) {
+			rx_dgram(rx_buf, n);
+			continue;
+		}
+		run_timers();
+		k_sleep(K_MSEC(SIM_POLL_MS));
+	}
+}
+
+K_THREAD_DEFINE(sim_tid, 2048, sim_thread, NULL, NULL, NULL, K_PRIO_COOP(7), 0,
+		SYS_FOREVER_MS);
+
+/* ============================================================================
+ * PUBLIC API
+ * ========================================================================== */
+
+int dect_adapter_init(void)
+{
+	char host[32] = "127.0.0.1";
+	unsigned long port = CONFIG_APP_SIM_RADIO_MEDIUM_PORT;
+
+	if (medium_arg != NULL) {
+		const char *colon = strrchr(medium_arg, ':');
+
+		if (colon == NULL || colon - medium_arg >= (ptrdiff_t)sizeof(host)) {
+			LOG_ERR("--dect_medium must be host:port");
+			return -EINVAL;
+		}
+		memcpy(host, medium_arg, colon - medium_arg);
+		host[colon - medium_arg] = '\0';
+		port = strtoul(colon + 1, NULL, 10);
+	}
+
+	if (dect_sim_bottom_open(host, (uint16_t)port) != 0) {
+		LOG_ERR("sim: cannot open medium socket %s:%lu", host, port);
+		return -EIO;
+	}
+	sim.tuned = SIM_CHANNEL_OFF;
+	sim.tuned2 = SIM_CHANNEL_OFF;
+	LOG_INF("Simulated radio, medium at %s:%lu", host, port);
+	k_thread_start(sim_tid);
+	return 0;
+}
+
+int dect_adapter_callbacks_set(
+	const struct dect_adapter_op_callbacks *op_cbs,
+	const struct dect_adapter_ntf_callbacks *ntf_cbs)
+{
+	if (!op_cbs || !ntf_cbs) {
+		return -EINVAL;
+	}
+
+	app_op_cbs = *op_cbs;
+	app_ntf_cbs = *ntf_cbs;
+	return 0;
+}
+
+int dect_adapter_system_mode_set_mac(void)
+{
+	complete_op(SIM_OP_SYSTEMMODE, 0, 0);
+	return 0;
+}
+
+int dect_adapter_control_configure(
+	int max_tx_power_dbm,
+	int max_mcs,
+	int rx_expected_rssi,
+	uint32_t long_rd_id,
+	uint16_t carrier,
+	bool powersave)
+{
+	uint8_t body[4];
+
+	ARG_UNUSED(rx_expected_rssi);
+
+	LOG_DBG("control_configure: tx=%d dBm mcs=%d rd=%u carrier=%u pwrsave=%u (simulated)",
+		max_tx_power_dbm, max_mcs, long_rd_id, carrier, powersave);
+	trace_event(TRACE_MODEM_CONTROL_CONFIGURE, max_tx_power_dbm, long_rd_id, carrier);
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.long_rd_id = long_rd_id;
+	/* Register with the medium. */
+	sys_put_le16(sim.tuned, body);
+	sys_put_le16(sim.tuned2, &body[2]);
+	(void)send_locked(SIM_MSG_TUNE, body, sizeof(body));
+	k_mutex_unlock(&sim_mutex);
+	complete_op(SIM_OP_CONFIGURE, 0, 0);
+	return 0;
+}
+
+int dect_adapter_functional_mode_set(bool activate)
+{
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	if (!activate) {
+		/* Deactivation drops every radio activity and association. */
+		uint32_t long_rd_id = sim.long_rd_id;
+
+		memset(&sim, 0, sizeof(sim));
+		sim.long_rd_id = long_rd_id;
+		sim.tuned = SIM_CHANNEL_ALL;
+		sim.tuned2 = SIM_CHANNEL_OFF;
+		retune_locked();
+	}
+	k_mutex_unlock(&sim_mutex);
+	complete_op(SIM_OP_FUNCTIONAL_MODE, 0, 0);
+	return 0;
+}
+
+int dect_adapter_rssi_scan_start(
+	uint16_t carrier,
+	int threshold_low,
+	int threshold_high)
+{
+	uint8_t body[2];
+
+	ARG_UNUSED(carrier);
+
+	LOG_INF("FT rssi_scan (simulated): thresholds=%d..%d dBm", threshold_low, threshold_high);
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.rssi_scanning = true;
+	sim.rssi_pending = SIM_BAND1_LAST - SIM_BAND1_FIRST + 1;
+	sim.rssi_deadline_ms = k_uptime_get() + SIM_RSSI_SCAN_TIMEOUT_MS;
+	for (uint16_t ch = SIM_BAND1_FIRST; ch <= SIM_BAND1_LAST; ch++) {
+		sys_put_le16(ch, body);
+		(void)send_locked(SIM_MSG_RSSI_REQ, body, sizeof(body));
+	}
+	k_mutex_unlock(&sim_mutex);
+	return 0;
+}
+
+int dect_adapter_rssi_scan_channel_start(
+	uint16_t channel,
+	uint16_t scan_frames,
+	int threshold_low,
+	int threshold_high)
+{
+	uint8_t body[2];
+
+	ARG_UNUSED(scan_frames);
+	ARG_UNUSED(threshold_low);
+	ARG_UNUSED(threshold_high);
+
+	LOG_DBG("rssi_scan (simulated): ch=%u", channel);
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.rssi_scanning = true;
+	sim.rssi_pending = 1;
+	sim.rssi_deadline_ms = k_uptime_get() + SIM_RSSI_SCAN_TIMEOUT_MS;
+	sys_put_le16(channel, body);
+	(void)send_locked(SIM_MSG_RSSI_REQ, body, sizeof(body));
+	k_mutex_unlock(&sim_mutex);
+	return 0;
+}
+
+int dect_adapter_rssi_scan_stop(void)
+{
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.rssi_scanning = false;
+	k_mutex_unlock(&sim_mutex);
+	complete_op(SIM_OP_RSSI_SCAN_STOP, 0, 0);
+	return 0;
+}
+
+int dect_adapter_cluster_configure_ft(
+	uint16_t channel,
+	uint32_t cluster_beacon_period,
+	uint32_t network_id,
+	int tx_power_dbm,
+	const struct dect_adapter_rach_params *rach,
+	uint8_t max_associations)
+{
+	ARG_UNUSED(rach);
+
+	if (cluster_beacon_period == 0 || max_associations == 0 ||
+	    max_associations > SIM_PEER_MAX) {
+		return -EINVAL;
+	}
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.ft_active = true;
+	sim.ft_channel = channel;
+	sim.ft_network_id = network_id;
+	sim.ft_period_ms = cluster_beacon_period;
+	sim.ft_max_peers = max_associations;
+	sim.next_cluster_beacon_ms = k_uptime_get();
+	retune_locked();
+	k_mutex_unlock(&sim_mutex);
+
+	LOG_INF("FT BEACONING - Cluster configured: ch=%u period=%u ms nw=%u tx=%d dBm (simulated)",
+		channel, cluster_beacon_period, network_id, tx_power_dbm);
+	complete_op(SIM_OP_CLUSTER_CONFIGURE, 0, 0);
+	return 0;
+}
+
+int dect_adapter_network_beacon_configure_ft(
+	uint16_t channel,
+	uint32_t nw_beacon_period)
+{
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.nw_period_ms = nw_beacon_period;
+	sim.next_nw_beacon_ms = k_uptime_get();
+	k_mutex_unlock(&sim_mutex);
+
+	LOG_INF("FT BEACONING - Network beacon configured: ch=%u period=%u ms (simulated)",
+		channel, nw_beacon_period);
+	complete_op(SIM_OP_NETWORK_BEACON_CONFIGURE, 0, 0);
+	return 0;
+}
+
+int dect_adapter_nw_period_from_cluster_period(
+	uint32_t cluster_period_ms,
+	uint32_t *network_period_ms)
+{
+	static const uint32_t periods[] = { 50, 100, 500, 1000, 1500, 2000, 4000 };
+
+	for (size_t i = 0; i < ARRAY_SIZE(periods); i++) {
+		if (cluster_period_ms < periods[i]) {
+			*network_period_ms = periods[i];
+			return 0;
+		}
+	}
+	return -EINVAL;
+}
+
+int dect_adapter_network_scan_start(
+	uint16_t channel,
+	uint32_t scan_time_ms,
+	uint32_t network_id_filter)
+{
+	uint32_t channels = (channel != 0U) ? 1 : (SIM_BAND1_LAST - SIM_BAND1_FIRST + 1);
+
+	LOG_INF("PT network_scan (simulated): channel=%u dwell=%u ms", channel, scan_time_ms);
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.scanning = true;
+	sim.scan_channel = channel;
+	sim.scan_network_id = network_id_filter;
+	/* The modem dwells scan_time_ms on each channel in turn; the medium lets
+	 * an all-channel scan hear every channel at once for the whole time. */
+	sim.scan_end_ms = k_uptime_get() + (int64_t)scan_time_ms * channels;
+	retune_locked();
+	k_mutex_unlock(&sim_mutex);
+	return 0;
+}
+
+int dect_adapter_network_scan_stop(void)
+{
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.scanning = false;
+	retune_locked();
+	k_mutex_unlock(&sim_mutex);
+	complete_op(SIM_OP_NETWORK_SCAN_STOP, 0, 0);
+	return 0;
+}
+
+int dect_adapter_cluster_beacon_receive_start(
+	uint16_t channel,
+	uint32_t cluster_beacon_period,
+	uint32_t parent_long_rd_id,
+	uint32_t network_id)
+{
+	ARG_UNUSED(network_id);
+
+	LOG_DBG("cluster_beacon_receive: ch=%u period=%u ms rd=%u", channel,
+		cluster_beacon_period, parent_long_rd_id);
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.subscribed = true;
+	sim.sub_failed = false;
+	sim.sub_channel = channel;
+	sim.sub_long_rd_id = parent_long_rd_id;
+	sim.sub_period_ms = (cluster_beacon_period != 0) ? cluster_beacon_period : 1000;
+	sim.sub_last_ms = k_uptime_get();
+	retune_locked();
+	k_mutex_unlock(&sim_mutex);
+	complete_op(SIM_OP_CLUSTER_BEACON_RECEIVE, 0, 0);
+	return 0;
+}
+
+int dect_adapter_cluster_beacon_receive_stop(void)
+{
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	sim.subscribed = false;
+	retune_locked();
+	k_mutex_unlock(&sim_mutex);
+	complete_op(SIM_OP_CLUSTER_BEACON_RECEIVE_STOP, 0, 0);
+	return 0;
+}
+
+int dect_adapter_association_request(
+	uint32_t peer_long_rd_id,
+	uint32_t network_id)
+{
+	uint8_t body[8];
+	int err;
+
+	LOG_INF("association_request: rd=%u nw=%u (simulated)", peer_long_rd_id, network_id);
+	sys_put_le32(peer_long_rd_id, body);
+	sys_put_le32(network_id, &body[4]);
+
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	/* Listen on the FT's channel for the response. */
+	sim.assoc_pending = true;
+	sim.assoc_channel = heard_channel_locked(peer_long_rd_id);
+	sim.assoc_long_rd_id = peer_long_rd_id;
+	sim.assoc_deadline_ms = k_uptime_get() + SIM_ASSOC_TIMEOUT_MS;
+	retune_locked();
+	err = send_locked(SIM_MSG_ASSOC_REQ, body, sizeof(body));
+	if (err != 0) {
+		sim.assoc_pending = false;
+	}
+	k_mutex_unlock(&sim_mutex);
+	return err;
+}
+
+int dect_adapter_association_release(uint32_t peer_long_rd_id)
+{
+	uint8_t body[4];
+
+	LOG_INF("association_release: rd=%u (simulated)", peer_long_rd_id);
+	sys_put_le32(peer_long_rd_id, body);
+
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	(void)peer_remove(peer_long_rd_id);
+	(void)send_locked(SIM_MSG_RELEASE, body, sizeof(body));
+	k_mutex_unlock(&sim_mutex);
+	return 0;
+}
+
+int dect_adapter_dlc_data_send(
+	uint32_t transaction_id,
+	uint8_t flow_id,
+	uint32_t peer_long_rd_id,
+	const void *data,
+	size_t data_len)
+{
+	static uint8_t body[SIM_DATA_HDR_LEN + CONFIG_APP_DLC_SDU_LEN_MAX];
+	int err;
+
+	if (!data || data_len == 0 || data_len > CONFIG_APP_DLC_SDU_LEN_MAX) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sim_mutex, K_FOREVER);
+	if (peer_find(peer_long_rd_id) < 0) {
+		/* The modem fails the SDU asynchronously when there is no association. */
+		k_mutex_unlock(&sim_mutex);
+		complete_op(SIM_OP_DLC_DATA_TX, -ENOTCONN, transaction_id);
+		return 0;
+	}
+	sys_put_le32(peer_long_rd_id, body);
+	sys_put_le32(transaction_id, &body[4]);
+	body[8] = flow_id;
+	memcpy(&body[SIM_DATA_HDR_LEN], data, data_len);
+	err = send_locked(SIM_MSG_DATA, body, SIM_DATA_HDR_LEN + data_len);
+	k_mutex_unlock(&sim_mutex);
+
+	if (err != 0) {
+		LOG_ERR("dlc_data_tx failed: %d", err);
+	}
+	return err;
+}
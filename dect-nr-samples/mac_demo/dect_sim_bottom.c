@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Built with the host C library into the native simulator runner, not into
+ * the Zephyr image: no Zephyr headers here. */
+
+#include "dect_sim_bottom.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static int sock_fd = -1;
+
+int dect_sim_bottom_open(const char *host, uint16_t port)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+	};
+
+	if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+		fprintf(stderr, "dect_sim: bad medium address %s\n", host);
+		return -1;
+	}
+
+	sock_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock_fd < 0) {
+		perror("dect_sim: socket");
+		return -1;
+	}
+	if (connect(sock_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+	    fcntl(sock_fd, F_SETFL, fcntl(sock_fd, F_GETFL) | O_NONBLOCK) != 0) {
+		perror("dect_sim: connect");
+		close(sock_fd);
+		sock_fd = -1;
+		return -1;
+	}
+	return 0;
+}
+
+int dect_sim_bottom_send(const void *buf, size_t len)
+{
+	if (sock_fd < 0 || send(sock_fd, buf, len, 0) != (ssize_t)len) {
+		return -1;
+	}
+	return 0;
+}
+
+int dect_sim_bottom_recv(void *buf, size_t len)
+{
+	ssize_t n;
+
+	if (sock_fd < 0) {
+		return -1;
+	}
+	n = recv(sock_fd, buf, len, 0);
+	if (n < 0) {
+		/* ECONNREFUSED: nothing listens yet; keep polling until the medium starts. */
+		return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED) ? 0 : -1;
+	}
+	return (int)n;
+}
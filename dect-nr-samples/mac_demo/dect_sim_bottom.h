@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DECT_SIM_BOTTOM_H__
+#define DECT_SIM_BOTTOM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file dect_sim_bottom.h
+ * @brief Host side of the simulated radio (native_sim only).
+ *
+ * dect_sim_bottom.c is built into the native simulator runner with the host C
+ * library and owns the UDP socket to python/radio_medium.py. Only plain types
+ * cross this interface; errors are reported as -1 because host and Zephyr
+ * errno values differ.
+ */
+
+/**
+ * @brief Open a non-blocking UDP socket connected to the medium.
+ *
+ * @param host Medium IPv4 address, e.g. "127.0.0.1"
+ * @param port Medium UDP port
+ * @return 0 on success, -1 on failure
+ */
+int dect_sim_bottom_open(const char *host, uint16_t port);
+
+/**
+ * @brief Send one datagram to the medium.
+ *
+ * @param buf Datagram
+ * @param len Datagram length
+ * @return 0 on success, -1 on failure
+ */
+int dect_sim_bottom_send(const void *buf, size_t len);
+
+/**
+ * @brief Receive one datagram from the medium without blocking.
+ *
+ * @param buf Buffer
+ * @param len Buffer size
+ * @return Datagram length, 0 if none is pending, -1 on failure
+ */
+int dect_sim_bottom_recv(void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DECT_SIM_BOTTOM_H__ */
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "dlc_ep.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include "app_dlc.h"
+
+LOG_MODULE_REGISTER(dlc_ep, CONFIG_LOG_DEFAULT_LEVEL);
+
+struct ep_buf {
+	void *fifo_reserved;
+	uint32_t long_rd_id;
+	uint16_t len;
+	uint8_t data[APP_DLC_PAYLOAD_LEN_MAX];
+};
+
+K_MEM_SLAB_DEFINE_STATIC(ep_slab, ROUND_UP(sizeof(struct ep_buf), 4), CONFIG_APP_DLC_EP_BUF_COUNT, 4);
+
+static struct dlc_ep *eps[CONFIG_APP_DLC_EP_MAX];
+static uint32_t rx_direct;
+static uint32_t rx_dispatched;
+/* Leaf lock for the endpoint table; taken from the modem RX callback. */
+static struct k_spinlock ep_lock;
+/* Serialises open and close with the port registration. */
+static K_MUTEX_DEFINE(ep_mutex);
+
+/* Endpoint for a payload: the one for the sender, else the one for any peer.
+ * Must be called with ep_lock held. */
+static struct dlc_ep *find_locked(uint8_t port, uint32_t long_rd_id)
+{
+	struct dlc_ep *any = NULL;
+
+	for (int i = 0; i < CONFIG_APP_DLC_EP_MAX; i++) {
+		if (eps[i] == NULL || eps[i]->port != port) {
+			continue;
+		}
+		if (eps[i]->peer == long_rd_id) {
+			return eps[i];
+		}
+		if (eps[i]->peer == 0) {
+			any = eps[i];
+		}
+	}
+	return any;
+}
+
+/* Copy a payload into an endpoint's queue; false if no endpoint takes the
+ * port. Callable from the modem RX callback. */
+static bool enqueue(uint32_t long_rd_id, uint8_t port, const uint8_t *data, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&ep_lock);
+	struct dlc_ep *ep = find_locked(port, long_rd_id);
+	struct ep_buf *buf;
+
+	if (ep == NULL) {
+		k_spin_unlock(&ep_lock, key);
+		return false;
+	}
+	if (atomic_get(&ep->queued) >= CONFIG_APP_DLC_EP_QUEUE_LEN ||
+	    k_mem_slab_alloc(&ep_slab, (void **)&buf, K_NO_WAIT) != 0) {
+		ep->rx_drop++;
+		k_spin_unlock(&ep_lock, key);
+		return true;
+	}
+
+	buf->long_rd_id = long_rd_id;
+	buf->len = (uint16_t)len;
+	memcpy(buf->data, data, len);
+	atomic_inc(&ep->queued);
+	ep->rx_count++;
+	/* Under the lock so dlc_ep_close() cannot drain the queue in between. */
+	k_fifo_put(&ep->rxq, buf);
+	k_spin_unlock(&ep_lock, key);
+	return true;
+}
+
+bool dlc_ep_rx_direct(uint32_t long_rd_id, const uint8_t *sdu, size_t len)
+{
+	if (len <= APP_DLC_PORT_HDR_LEN || sdu[0] < APP_DLC_PORT_USER ||
+	    !enqueue(long_rd_id, sdu[0], &sdu[APP_DLC_PORT_HDR_LEN], len - APP_DLC_PORT_HDR_LEN)) {
+		return false;
+	}
+	K_SPINLOCK(&ep_lock) {
+		rx_direct++;
+	}
+	return true;
+}
+
+/* Port handler for payloads the event loop unwrapped from another SDU. */
+static void ep_port_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	if (!enqueue(long_rd_id, app_dlc_rx_port(), data, len)) {
+		LOG_WRN("EP: no endpoint on port %u for rd=%u", app_dlc_rx_port(), long_rd_id);
+		return;
+	}
+	K_SPINLOCK(&ep_lock) {
+		rx_dispatched++;
+	}
+}
+
+int dlc_ep_open(struct dlc_ep *ep, uint32_t peer, uint8_t flow, uint8_t port)
+{
+	int slot = -1;
+	int err = 0;
+
+	if (flow == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ep_mutex, K_FOREVER);
+	K_SPINLOCK(&ep_lock) {
+		for (int i = 0; i < CONFIG_APP_DLC_EP_MAX; i++) {
+			if (eps[i] != NULL && eps[i]->port == port && eps[i]->peer == peer) {
+				err = -EADDRINUSE;
+				break;
+			}
+			if (eps[i] == NULL && slot < 0) {
+				slot = i;
+			}
+		}
+	}
+	if (err == 0 && slot < 0) {
+		err = -ENOMEM;
+	}
+	if (err == 0) {
+		/* Also checks the port; a no-op if other endpoints hold it. */
+		err = app_dlc_port_register(port, ep_port_rx);
+	}
+	if (err != 0) {
+		k_mutex_unlock(&ep_mutex);
+		return err;
+	}
+
+	memset(ep, 0, sizeof(*ep));
+	k_fifo_init(&ep->rxq);
+	ep->peer = peer;
+	ep->flow = flow;
+	ep->port = port;
+	ep->open = true;
+	K_SPINLOCK(&ep_lock) {
+		eps[slot] = ep;
+	}
+	k_mutex_unlock(&ep_mutex);
+	return 0;
+}
+
+void dlc_ep_close(struct dlc_ep *ep)
+{
+	bool port_used = false;
+	struct ep_buf *buf;
+
+	k_mutex_lock(&ep_mutex, K_FOREVER);
+	K_SPINLOCK(&ep_lock) {
+		for (int i = 0; i < CONFIG_APP_DLC_EP_MAX; i++) {
+			if (eps[i] == ep) {
+				eps[i] = NULL;
+			} else if (eps[i] != NULL && eps[i]->port == ep->port) {
+				port_used = true;
+			}
+		}
+		ep->open = false;
+	}
+	if (!port_used) {
+		(void)app_dlc_port_register(ep->port, NULL);
+	}
+	k_mutex_unlock(&ep_mutex);
+
+	while ((buf = k_fifo_get(&ep->rxq, K_NO_WAIT)) != NULL) {
+		k_mem_slab_free(&ep_slab, buf);
+	}
+	atomic_set(&ep->queued, 0);
+	k_fifo_cancel_wait(&ep->rxq);
+}
+
+int dlc_ep_sendto(struct dlc_ep *ep, uint32_t long_rd_id, const void *data, size_t len)
+{
+	if (!ep->open) {
+		return -ENOTCONN;
+	}
+	return app_dlc_flow_send(long_rd_id, ep->flow, ep->port, data, len, NULL);
+}
+
+int dlc_ep_send(struct dlc_ep *ep, const void *data, size_t len)
+{
+	return dlc_ep_sendto(ep, ep->peer, data, len);
+}
+
+int dlc_ep_recv(struct dlc_ep *ep, void *buf, size_t size, uint32_t *long_rd_id,
+		k_timeout_t timeout)
+{
+	struct ep_buf *rx;
+	size_t len;
+
+	if (!ep->open) {
+		return -ENOTCONN;
+	}
+	rx = k_fifo_get(&ep->rxq, timeout);
+	if (rx == NULL) {
+		return ep->open ? -EAGAIN : -ENOTCONN;
+	}
+	atomic_dec(&ep->queued);
+
+	len = MIN(rx->len, size);
+	memcpy(buf, rx->data, len);
+	if (long_rd_id != NULL) {
+		*long_rd_id = rx->long_rd_id;
+	}
+	k_mem_slab_free(&ep_slab, rx);
+	return (int)len;
+}
+
+void dlc_ep_poll_event_init(struct dlc_ep *ep, struct k_poll_event *event)
+{
+	k_poll_event_init(event, K_POLL_TYPE_FIFO_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+			  &ep->rxq);
+}
+
+static int cmd_ep(const struct shell *shell, size_t argc, char **argv)
+{
+	struct {
+		uint32_t peer;
+		uint8_t port;
+		uint8_t flow;
+		uint32_t queued;
+		uint32_t rx_count;
+		uint32_t rx_drop;
+	} copy[CONFIG_APP_DLC_EP_MAX];
+	uint32_t direct, dispatched;
+	int n = 0;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	K_SPINLOCK(&ep_lock) {
+		for (int i = 0; i < CONFIG_APP_DLC_EP_MAX; i++) {
+			if (eps[i] == NULL) {
+				continue;
+			}
+			copy[n].peer = eps[i]->peer;
+			copy[n].port = eps[i]->port;
+			copy[n].flow = eps[i]->flow;
+			copy[n].queued = (uint32_t)atomic_get(&eps[i]->queued);
+			copy[n].rx_count = eps[i]->rx_count;
+			copy[n].rx_drop = eps[i]->rx_drop;
+			n++;
+		}
+		direct = rx_direct;
+		dispatched = rx_dispatched;
+	}
+
+	shell_print(shell, "EP: %d of %u endpoint(s) open, %u buffer(s) free; RX %u from the "
+		    "modem callback, %u through the port dispatch", n, CONFIG_APP_DLC_EP_MAX,
+		    k_mem_slab_num_free_get(&ep_slab), direct, dispatched);
+	for (int i = 0; i < n; i++) {
+		if (copy[i].peer != 0) {
+			shell_print(shell, "  port %u rd=%u flow %u: queued=%u rx=%u dropped=%u",
+				    copy[i].port, copy[i].peer, copy[i].flow, copy[i].queued,
+				    copy[i].rx_count, copy[i].rx_drop);
+		} else {
+			shell_print(shell, "  port %u any peer flow %u: queued=%u rx=%u dropped=%u",
+				    copy[i].port, copy[i].flow, copy[i].queued, copy[i].rx_count,
+				    copy[i].rx_drop);
+		}
+	}
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(EP, NULL, "EP — open DLC endpoints: queued, received and dropped payloads", cmd_ep, 1, 0);
+SHELL_CMD_ARG_REGISTER(ep, NULL, "ep — open dlc endpoints: queued, received and dropped payloads", cmd_ep, 1, 0);
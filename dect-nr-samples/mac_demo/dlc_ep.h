@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DLC_EP_H__
+#define DLC_EP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file dlc_ep.h
+ * @brief Socket-like DLC endpoints for application threads.
+ *
+ * An endpoint is bound to a user port (APP_DLC_PORT_USER and up) and a peer,
+ * or to any peer with peer 0, and sends on the DLC flow given at open. Each
+ * endpoint has its own RX queue, so several threads can block in
+ * dlc_ep_recv() or k_poll() on their own traffic without going through the
+ * shell or the main event loop.
+ *
+ * Plain SDUs for an open endpoint are queued straight from the modem RX
+ * callback; the event loop only accounts them. Payloads unwrapped from
+ * batches, compression, sequence numbers or multi-hop routing reach the
+ * endpoint through the port dispatch. An SDU for a peer with its own
+ * endpoint goes there, otherwise to the endpoint for any peer on the port.
+ * Payloads are dropped when the endpoint already holds
+ * CONFIG_APP_DLC_EP_QUEUE_LEN or the CONFIG_APP_DLC_EP_BUF_COUNT buffers
+ * shared by all endpoints are in use.
+ */
+
+/** A DLC endpoint. Owned by the caller; the fields are private to dlc_ep.c. */
+struct dlc_ep {
+	struct k_fifo rxq;
+	atomic_t queued;
+	uint32_t peer;
+	uint8_t port;
+	uint8_t flow;
+	bool open;
+	uint32_t rx_count;
+	uint32_t rx_drop;
+};
+
+/**
+ * @brief Open an endpoint.
+ *
+ * @param ep   Endpoint to initialise
+ * @param peer Peer long RD ID, or 0 to receive from any peer and send to the
+ *             associated peer (the parent FT on a PT)
+ * @param flow DLC flow for sends (APP_DLC_FLOW_SIGNALLING or APP_DLC_FLOW_USER)
+ * @param port User port, APP_DLC_PORT_USER..APP_DLC_PORT_USER +
+ *             CONFIG_APP_DLC_USER_PORTS - 1
+ * @return 0 on success, -EINVAL for a bad port or flow, -EBUSY if another
+ *         service holds the port, -EADDRINUSE if an endpoint for the same port
+ *         and peer is open, -ENOMEM if CONFIG_APP_DLC_EP_MAX endpoints are open
+ */
+int dlc_ep_open(struct dlc_ep *ep, uint32_t peer, uint8_t flow, uint8_t port);
+
+/**
+ * @brief Close an endpoint and drop what it has queued.
+ *
+ * Threads blocked in dlc_ep_recv() return -ENOTCONN.
+ *
+ * @param ep Endpoint
+ */
+void dlc_ep_close(struct dlc_ep *ep);
+
+/**
+ * @brief Send a payload to the endpoint's peer.
+ *
+ * The payload is queued to the TX scheduler and the call returns at once;
+ * callable from any thread.
+ *
+ * @param ep   Endpoint
+ * @param data Payload
+ * @param len  Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @return 0 on success, -ENOTCONN if the endpoint is closed or the peer is
+ *         not associated, or a send error as for app_dlc_flow_send()
+ */
+int dlc_ep_send(struct dlc_ep *ep, const void *data, size_t len);
+
+/**
+ * @brief Send a payload to a given peer, e.g. a reply on an any-peer endpoint.
+ *
+ * @param ep         Endpoint
+ * @param long_rd_id Destination, or 0 for the associated peer
+ * @param data       Payload
+ * @param len        Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @return As for dlc_ep_send()
+ */
+int dlc_ep_sendto(struct dlc_ep *ep, uint32_t long_rd_id, const void *data, size_t len);
+
+/**
+ * @brief Take the next received payload.
+ *
+ * A payload longer than @p size is truncated, as with a datagram socket.
+ *
+ * @param ep         Endpoint
+ * @param buf        Output buffer
+ * @param size       Buffer size
+ * @param long_rd_id Output: sender long RD ID (may be NULL)
+ * @param timeout    K_NO_WAIT for a non-blocking call
+ * @return Number of bytes copied, -EAGAIN if nothing arrived in time, or
+ *         -ENOTCONN if the endpoint is closed
+ */
+int dlc_ep_recv(struct dlc_ep *ep, void *buf, size_t size, uint32_t *long_rd_id,
+		k_timeout_t timeout);
+
+/**
+ * @brief Prepare a k_poll() event that signals received payloads.
+ *
+ * The event is K_POLL_TYPE_FIFO_DATA_AVAILABLE on the endpoint's RX queue;
+ * after k_poll() returns, reset its state to K_POLL_STATE_NOT_READY and call
+ * dlc_ep_recv() with K_NO_WAIT.
+ *
+ * @param ep    Endpoint
+ * @param event Event to initialise
+ */
+void dlc_ep_poll_event_init(struct dlc_ep *ep, struct k_poll_event *event);
+
+#if defined(CONFIG_APP_DLC_EP)
+
+/**
+ * @brief Queue an SDU to an endpoint from the modem RX callback.
+ *
+ * Called by main.c for every received SDU before it is copied for the event
+ * loop; callable from the callback context.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param sdu        SDU, port byte first
+ * @param len        SDU length
+ * @return true if the SDU belongs to an open endpoint (queued or dropped),
+ *         false to hand it to the event loop
+ */
+bool dlc_ep_rx_direct(uint32_t long_rd_id, const uint8_t *sdu, size_t len);
+
+#else
+
+static inline bool dlc_ep_rx_direct(uint32_t long_rd_id, const uint8_t *sdu, size_t len)
+{
+	return false;
+}
+
+#endif /* CONFIG_APP_DLC_EP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLC_EP_H__ */
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "dlc_net.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+#include "app_dlc.h"
+#include "ft_assoc.h"
+
+LOG_MODULE_REGISTER(dlc_net, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define DLC_NET_MTU       APP_DLC_PAYLOAD_LEN_MAX
+#define DLC_NET_IPV6_HDR  40
+#define DLC_NET_DST_OFF   24 /* destination address in the IPv6 header */
+#define DLC_NET_PEER_MAX  CONFIG_APP_FT_MAX_PTS
+
+#define DLC_NET_L2_CTX_TYPE void *
+
+static struct net_if *dlc_iface;
+static uint32_t own_rd_id;
+static struct net_if_router *parent_router;
+static const struct in6_addr ll_prefix = {.s6_addr = {0xfe, 0x80}};
+
+static struct {
+	uint32_t tx_pkts;
+	uint64_t tx_bytes;
+	uint64_t tx_hdr_bytes;  /* IPv6 and transport headers */
+	uint32_t tx_linearized; /* packets spread over several net_bufs */
+	uint32_t tx_err;
+	uint32_t tx_cpu_us;
+	uint32_t rx_pkts;
+	uint64_t rx_bytes;
+	uint32_t rx_drop;
+	uint32_t rx_cpu_us;
+} stats;
+
+/* Taken before app_mutex (the sends below); serialises tx_buf and the counters. */
+static K_MUTEX_DEFINE(dlc_net_mutex);
+static uint8_t tx_buf[DLC_NET_MTU];
+
+/* Interface identifier of a device: what IPv6 autoconfiguration makes of the
+ * EUI-64 link-layer address (U/L bit inverted). */
+static void iid_fill(uint8_t *iid, uint32_t long_rd_id)
+{
+	iid[0] = 0x02;
+	iid[1] = 0;
+	iid[2] = 0;
+	iid[3] = 0;
+	sys_put_be32(long_rd_id, &iid[4]);
+}
+
+/* IPv6 and transport header bytes of an outgoing packet. */
+static size_t header_len(const uint8_t *ip, size_t len)
+{
+	switch (ip[6]) {
+	case IPPROTO_UDP:
+		return DLC_NET_IPV6_HDR + 8;
+	case IPPROTO_ICMPV6:
+		return DLC_NET_IPV6_HDR + 4;
+	case IPPROTO_TCP:
+		return len > DLC_NET_IPV6_HDR + 12 ? DLC_NET_IPV6_HDR + (ip[DLC_NET_IPV6_HDR + 12] >> 4) * 4
+						   : DLC_NET_IPV6_HDR;
+	default:
+		return DLC_NET_IPV6_HDR;
+	}
+}
+
+/* Multicast: to the parent on a PT, to every associated PT on an FT. */
+static int send_multicast(const uint8_t *ip, size_t len)
+{
+	uint32_t peers[DLC_NET_PEER_MAX];
+	size_t count;
+	int err = -ENOTCONN;
+
+	if (app_dlc_parent_get(&peers[0]) == 0) {
+		return app_dlc_port_send(peers[0], APP_DLC_PORT_IP, ip, len, NULL);
+	}
+	count = ft_assoc_list(peers, ARRAY_SIZE(peers));
+	for (size_t i = 0; i < count; i++) {
+		if (app_dlc_port_send(peers[i], APP_DLC_PORT_IP, ip, len, NULL) == 0) {
+			err = 0;
+		}
+	}
+	return err;
+}
+
+/* Unicast: the device named by the interface identifier if it is a neighbour,
+ * else the parent FT. */
+static int send_unicast(const uint8_t *ip, size_t len)
+{
+	uint32_t dst = sys_get_be32(&ip[DLC_NET_DST_OFF + 12]);
+	uint32_t peer;
+
+	if (dst == 0 || app_dlc_peer_resolve(dst, &peer) != 0) {
+		int err = app_dlc_parent_get(&peer);
+
+		if (err != 0) {
+			return err;
+		}
+	}
+	return app_dlc_port_send(peer, APP_DLC_PORT_IP, ip, len, NULL);
+}
+
+static int dlc_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	uint32_t start = k_cycle_get_32();
+	const uint8_t *ip;
+	int err;
+
+	ARG_UNUSED(iface);
+
+	if (len < DLC_NET_IPV6_HDR || len > DLC_NET_MTU) {
+		k_mutex_lock(&dlc_net_mutex, K_FOREVER);
+		stats.tx_err++;
+		k_mutex_unlock(&dlc_net_mutex);
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&dlc_net_mutex, K_FOREVER);
+	if (pkt->buffer->frags == NULL) {
+		/* The whole packet is in one net_buf: hand it over as it is. */
+		ip = pkt->buffer->data;
+	} else {
+		net_pkt_cursor_init(pkt);
+		(void)net_pkt_read(pkt, tx_buf, len);
+		ip = tx_buf;
+		stats.tx_linearized++;
+	}
+
+	if ((ip[0] & 0xf0) != 0x60) {
+		err = -EAFNOSUPPORT;
+	} else if (ip[DLC_NET_DST_OFF] == 0xff) {
+		err = send_multicast(ip, len);
+	} else {
+		err = send_unicast(ip, len);
+	}
+
+	if (err == 0) {
+		stats.tx_pkts++;
+		stats.tx_bytes += len;
+		stats.tx_hdr_bytes += header_len(ip, len);
+		stats.tx_cpu_us += k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	} else {
+		stats.tx_err++;
+	}
+	k_mutex_unlock(&dlc_net_mutex);
+
+	if (err != 0) {
+		LOG_DBG("IP TX of %zu B failed: %d", len, err);
+		return err;
+	}
+	net_pkt_unref(pkt);
+	return (int)len;
+}
+
+static enum net_verdict dlc_l2_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	/* No L2 header: the port byte was stripped by the DLC dispatch. */
+	return NET_CONTINUE;
+}
+
+static int dlc_l2_enable(struct net_if *iface, bool state)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(state);
+
+	return 0;
+}
+
+static enum net_l2_flags dlc_l2_flags(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return NET_L2_MULTICAST;
+}
+
+NET_L2_INIT(DLC_NET_L2, dlc_l2_recv, dlc_l2_send, dlc_l2_enable, dlc_l2_flags);
+
+void dlc_net_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	uint32_t start = k_cycle_get_32();
+	struct net_pkt *pkt = NULL;
+	int err = -ENETDOWN;
+
+	if (len < DLC_NET_IPV6_HDR || (data[0] & 0xf0) != 0x60) {
+		err = -EPROTONOSUPPORT;
+	} else if (dlc_iface != NULL && net_if_is_up(dlc_iface)) {
+		pkt = net_pkt_rx_alloc_with_buffer(dlc_iface, len, AF_INET6, 0, K_NO_WAIT);
+		err = pkt == NULL ? -ENOMEM : net_pkt_write(pkt, data, len);
+		if (err == 0) {
+			err = net_recv_data(dlc_iface, pkt);
+		}
+		if (err != 0 && pkt != NULL) {
+			net_pkt_unref(pkt);
+		}
+	}
+
+	k_mutex_lock(&dlc_net_mutex, K_FOREVER);
+	if (err == 0) {
+		stats.rx_pkts++;
+		stats.rx_bytes += len;
+		stats.rx_cpu_us += k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	} else {
+		stats.rx_drop++;
+	}
+	k_mutex_unlock(&dlc_net_mutex);
+
+	if (err != 0) {
+		LOG_DBG("IP RX of %zu B from rd=%u dropped: %d", len, long_rd_id, err);
+	}
+}
+
+/* Add this device's address in a /64 and make a global /64 on-link. */
+static void prefix_addr_add(const struct in6_addr *prefix)
+{
+	struct in6_addr addr = *prefix;
+
+	iid_fill(&addr.s6_addr[8], own_rd_id);
+	if (net_if_ipv6_addr_add(dlc_iface, &addr, NET_ADDR_MANUAL, 0) == NULL) {
+		LOG_WRN("Cannot add an IPv6 address to dect0");
+	}
+	if (!net_ipv6_is_ll_addr(prefix)) {
+		(void)net_if_ipv6_prefix_add(dlc_iface, (struct in6_addr *)prefix, 64,
+					     NET_IPV6_ND_INFINITE_LIFETIME);
+	}
+}
+
+void dlc_net_init(uint32_t own_long_rd_id)
+{
+	static uint8_t lladdr[8];
+	int err;
+
+	if (dlc_iface == NULL) {
+		LOG_ERR("DLC network interface missing");
+		return;
+	}
+	own_rd_id = own_long_rd_id;
+	sys_put_be32(own_long_rd_id, &lladdr[4]);
+	err = net_if_set_link_addr(dlc_iface, lladdr, sizeof(lladdr), NET_LINK_DUMMY);
+	if (err != 0) {
+		LOG_ERR("net_if_set_link_addr failed: %d", err);
+		return;
+	}
+
+	/* Without neighbour discovery the stack does not autoconfigure fe80::. */
+	prefix_addr_add(&ll_prefix);
+	if (CONFIG_APP_DLC_NET_PREFIX[0] != '\0') {
+		struct in6_addr prefix;
+
+		if (net_addr_pton(AF_INET6, CONFIG_APP_DLC_NET_PREFIX, &prefix) != 0) {
+			LOG_ERR("Bad CONFIG_APP_DLC_NET_PREFIX \"%s\"", CONFIG_APP_DLC_NET_PREFIX);
+		} else {
+			memset(&prefix.s6_addr[8], 0, 8);
+			prefix_addr_add(&prefix);
+		}
+	}
+
+	err = net_if_up(dlc_iface);
+	if (err != 0 && err != -EALREADY) {
+		LOG_ERR("net_if_up failed: %d", err);
+	}
+}
+
+void dlc_net_parent_set(uint32_t parent_long_rd_id)
+{
+	struct in6_addr ll = ll_prefix;
+
+	if (dlc_iface == NULL) {
+		return;
+	}
+	iid_fill(&ll.s6_addr[8], parent_long_rd_id);
+	if (parent_router != NULL) {
+		(void)net_if_ipv6_router_rm(parent_router);
+	}
+	parent_router = net_if_ipv6_router_add(dlc_iface, &ll, 0);
+}
+
+static void dlc_net_iface_init(struct net_if *iface)
+{
+	dlc_iface = iface;
+	/* Up once dlc_net_init() has set the link-layer address. */
+	net_if_flag_set(iface, NET_IF_NO_AUTO_START);
+	net_if_flag_set(iface, NET_IF_IPV6_NO_ND);
+	net_if_flag_set(iface, NET_IF_IPV6_NO_MLD);
+}
+
+static const struct net_if_api dlc_net_if_api = {
+	.init = dlc_net_iface_init,
+};
+
+static int dlc_net_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+NET_DEVICE_INIT(dlc_net, "dect0", dlc_net_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dlc_net_if_api, DLC_NET_L2,
+		NET_L2_GET_CTX_TYPE(DLC_NET_L2), DLC_NET_MTU);
+
+static int cmd_ip(const struct shell *shell, size_t argc, char **argv)
+{
+	char addr_str[NET_IPV6_ADDR_LEN];
+	struct in6_addr ll = ll_prefix;
+
+	if (argc > 1 && (strcmp(argv[1], "RESET") == 0 || strcmp(argv[1], "reset") == 0)) {
+		k_mutex_lock(&dlc_net_mutex, K_FOREVER);
+		memset(&stats, 0, sizeof(stats));
+		k_mutex_unlock(&dlc_net_mutex);
+	} else if (argc > 1) {
+		shell_error(shell, "Usage: IP [RESET]");
+		return -EINVAL;
+	}
+
+	iid_fill(&ll.s6_addr[8], own_rd_id);
+	shell_print(shell, "IP: dect0 %s, MTU %u, %s%s%s", dlc_iface != NULL && net_if_is_up(dlc_iface) ?
+		    "up" : "down", DLC_NET_MTU,
+		    net_addr_ntop(AF_INET6, &ll, addr_str, sizeof(addr_str)) != NULL ? addr_str : "?",
+		    CONFIG_APP_DLC_NET_PREFIX[0] != '\0' ? ", prefix " : "", CONFIG_APP_DLC_NET_PREFIX);
+
+	k_mutex_lock(&dlc_net_mutex, K_FOREVER);
+	shell_print(shell, "IP TX: %u pkts / %llu B, err=%u, multi-buffer=%u, L2 CPU avg %u us",
+		    stats.tx_pkts, (unsigned long long)stats.tx_bytes, stats.tx_err,
+		    stats.tx_linearized, stats.tx_pkts ? stats.tx_cpu_us / stats.tx_pkts : 0U);
+	if (stats.tx_pkts != 0) {
+		shell_print(shell, "IP TX: headers avg %u B of avg %u B per packet (%u%%); raw DLC "
+			    "carries the same payload with the %u B port byte only",
+			    (uint32_t)(stats.tx_hdr_bytes / stats.tx_pkts),
+			    (uint32_t)(stats.tx_bytes / stats.tx_pkts),
+			    (uint32_t)(stats.tx_hdr_bytes * 100U / stats.tx_bytes), APP_DLC_PORT_HDR_LEN);
+	}
+	shell_print(shell, "IP RX: %u pkts / %llu B, dropped=%u, L2 CPU avg %u us", stats.rx_pkts,
+		    (unsigned long long)stats.rx_bytes, stats.rx_drop,
+		    stats.rx_pkts ? stats.rx_cpu_us / stats.rx_pkts : 0U);
+	k_mutex_unlock(&dlc_net_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(IP, NULL, "IP [RESET] — IPv6 interface over DLC: addresses, packets, header overhead", cmd_ip, 1, 1);
+SHELL_CMD_ARG_REGISTER(ip, NULL, "ip [reset] — ipv6 interface over dlc: addresses, packets, header overhead", cmd_ip, 1, 1);
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DLC_NET_H__
+#define DLC_NET_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file dlc_net.h
+ * @brief IPv6 network interface (Zephyr net_if with its own L2) over DLC.
+ *
+ * Each IPv6 packet travels as one SDU on APP_DLC_PORT_IP, with no L2 header
+ * beyond the port byte, so the interface MTU is APP_DLC_PAYLOAD_LEN_MAX
+ * (CONFIG_APP_DLC_SDU_LEN_MAX of at least 1281 for the IPv6 minimum of 1280).
+ *
+ * The link-layer address is the 8-byte EUI-64 00:00:00:00 + long RD ID, so
+ * the interface identifier of every address is 0200:0000:<long RD ID> and the
+ * destination device is read straight from the destination address: no
+ * neighbour discovery runs on the link. Addresses are fe80::/64 and, with
+ * CONFIG_APP_DLC_NET_PREFIX, one /64 shared by the whole network, on-link
+ * for all devices. A PT routes other destinations, and any neighbour it does
+ * not have, to its parent FT; multicast goes to the parent on a PT and to
+ * every associated PT on an FT.
+ */
+
+#if defined(CONFIG_APP_DLC_NET)
+
+/**
+ * @brief Set the link-layer address and bring the interface up.
+ *
+ * @param own_long_rd_id This device's long RD ID
+ */
+void dlc_net_init(uint32_t own_long_rd_id);
+
+/**
+ * @brief Make the parent FT the default router after a PT association.
+ *
+ * @param parent_long_rd_id Long RD ID of the parent FT
+ */
+void dlc_net_parent_set(uint32_t parent_long_rd_id);
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_IP.
+ *
+ * Called from the main event loop; the packet is copied into a net_pkt and
+ * handed to the IP stack.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       IPv6 packet
+ * @param len        Packet length
+ */
+void dlc_net_rx(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+#else
+
+static inline void dlc_net_init(uint32_t own_long_rd_id) {}
+static inline void dlc_net_parent_set(uint32_t parent_long_rd_id) {}
+
+#endif /* CONFIG_APP_DLC_NET */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLC_NET_H__ */
@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "frag.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include "app_dlc.h"
+
+LOG_MODULE_REGISTER(frag, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Fragment header after the port byte (little endian):
+ *   [0..1]  message ID, per destination
+ *   [2..3]  fragment index, 0..count-1
+ *   [4..5]  fragment count
+ *   [6..7]  fragment size used by the sender (all but the last fragment)
+ *   [8..11] total message length
+ * The sender's fragment size travels in every header, so devices built with a
+ * different CONFIG_APP_DLC_SDU_LEN_MAX still interoperate. */
+#define FRAG_HDR_LEN       12
+#define FRAG_DATA_MAX      (APP_DLC_PAYLOAD_LEN_MAX - FRAG_HDR_LEN)
+#define FRAG_TX_WINDOW     CONFIG_APP_FRAG_TX_WINDOW
+#define FRAG_MSG_LEN_MAX   CONFIG_APP_FRAG_MSG_LEN_MAX
+#define FRAG_RX_BUF_COUNT  CONFIG_APP_FRAG_RX_BUF_COUNT
+/* Per message on RX, bounds the received-fragment bitmap: a full-size message
+ * in fragments of this build's size. */
+#define FRAG_RX_MAX_FRAGS  DIV_ROUND_UP(FRAG_MSG_LEN_MAX, FRAG_DATA_MAX)
+#define FRAG_PEER_SLOTS    8   /* destinations with their own message ID counter */
+#define FRAG_SEND_RETRIES  50  /* transient send errors before giving up */
+#define FRAG_RETRY_MS      10
+
+BUILD_ASSERT(FRAG_DATA_MAX > 0, "CONFIG_APP_DLC_SDU_LEN_MAX too small for fragment header");
+/* A full window must fit the peer's TX scheduler queue, or every window stalls
+ * on -ENOBUFS retries. */
+BUILD_ASSERT(FRAG_TX_WINDOW <= CONFIG_APP_TX_SCHED_PEER_QUEUE_MAX,
+	     "CONFIG_APP_FRAG_TX_WINDOW exceeds CONFIG_APP_TX_SCHED_PEER_QUEUE_MAX");
+BUILD_ASSERT(FRAG_RX_MAX_FRAGS <= UINT16_MAX,
+	     "CONFIG_APP_FRAG_MSG_LEN_MAX needs more fragments than the header counts");
+
+struct frag_rx_ctx {
+	bool in_use;
+	bool delivering; /* handler running; sweep must not reclaim */
+	uint32_t long_rd_id;
+	uint16_t msg_id;
+	uint16_t count;
+	uint16_t received;
+	uint16_t frag_size;
+	uint32_t total_len;
+	uint32_t last_rx_ms;
+	uint8_t map[DIV_ROUND_UP(FRAG_RX_MAX_FRAGS, 8)];
+	uint8_t *buf;
+};
+
+struct frag_peer_id {
+	uint32_t long_rd_id;
+	uint16_t next_msg_id;
+	uint32_t last_use_ms;
+};
+
+static struct {
+	uint32_t tx_msgs;
+	uint32_t tx_frags;
+	uint32_t tx_failed;
+	uint32_t rx_msgs;
+	uint32_t rx_frags;
+	uint32_t rx_dup;
+	uint32_t rx_timeout;
+	uint32_t rx_no_buf;
+	uint32_t rx_too_big;
+	uint32_t rx_malformed;
+} stats;
+
+/* TX state shared between frag_send() and frag_tx_done(); guarded by frag_mutex. */
+static struct {
+	bool active;
+	int status;
+	bool used[FRAG_TX_WINDOW];
+	uint32_t transaction_id[FRAG_TX_WINDOW];
+} tx;
+
+static K_MUTEX_DEFINE(frag_mutex);    /* rx contexts, tx window, stats */
+static K_MUTEX_DEFINE(frag_tx_mutex); /* one frag_send() at a time */
+static K_SEM_DEFINE(frag_tx_sem, 0, FRAG_TX_WINDOW);
+
+static struct frag_rx_ctx rx_ctx[FRAG_RX_BUF_COUNT];
+static uint8_t rx_bufs[FRAG_RX_BUF_COUNT][FRAG_MSG_LEN_MAX];
+static struct frag_peer_id peer_ids[FRAG_PEER_SLOTS];
+static frag_rx_cb_t rx_cb;
+
+static void frag_sweep_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(frag_sweep_work, frag_sweep_work_handler);
+
+/* ============================================================================
+ * TX
+ * ========================================================================== */
+
+/* Message IDs count up per destination; the least recently used slot is recycled. */
+static uint16_t next_msg_id(uint32_t long_rd_id)
+{
+	struct frag_peer_id *slot = &peer_ids[0];
+	uint32_t now = k_uptime_get_32();
+
+	for (size_t i = 0; i < ARRAY_SIZE(peer_ids); i++) {
+		if (peer_ids[i].long_rd_id == long_rd_id) {
+			slot = &peer_ids[i];
+			break;
+		}
+		if (now - peer_ids[i].last_use_ms > now - slot->last_use_ms) {
+			slot = &peer_ids[i];
+		}
+	}
+
+	if (slot->long_rd_id != long_rd_id) {
+		slot->long_rd_id = long_rd_id;
+		slot->next_msg_id = (uint16_t)k_cycle_get_32();
+	}
+	slot->last_use_ms = now;
+	return slot->next_msg_id++;
+}
+
+/* Send one fragment, retrying transient modem and TX queue errors. The transaction is
+ * recorded under frag_mutex before its completion can be processed. */
+static int send_fragment(uint32_t long_rd_id, const uint8_t *hdr, const uint8_t *data, size_t n)
+{
+	int err = 0;
+
+	for (int attempt = 0; attempt < FRAG_SEND_RETRIES; attempt++) {
+		uint32_t transaction_id;
+
+		k_mutex_lock(&frag_mutex, K_FOREVER);
+		err = app_dlc_port_send_hdr(long_rd_id, APP_DLC_PORT_FRAG, hdr, FRAG_HDR_LEN,
+					    data, n, &transaction_id);
+		if (err == 0) {
+			for (size_t i = 0; i < FRAG_TX_WINDOW; i++) {
+				if (!tx.used[i]) {
+					tx.used[i] = true;
+					tx.transaction_id[i] = transaction_id;
+					break;
+				}
+			}
+			stats.tx_frags++;
+		}
+		k_mutex_unlock(&frag_mutex);
+
+		if (err != -ENOMEM && err != -ENOBUFS && err != -EBUSY && err != -EAGAIN) {
+			break;
+		}
+		k_msleep(FRAG_RETRY_MS);
+	}
+	return err;
+}
+
+int frag_send(uint32_t long_rd_id, const void *data, size_t len, k_timeout_t timeout)
+{
+	const uint8_t *msg = data;
+	uint32_t count;
+	uint16_t msg_id;
+	int err = 0;
+
+	if (data == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	/* The receiver reassembles at most FRAG_MSG_LEN_MAX bytes. */
+	if (len > FRAG_MSG_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+	count = DIV_ROUND_UP(len, FRAG_DATA_MAX);
+
+	k_mutex_lock(&frag_tx_mutex, K_FOREVER);
+	k_sem_init(&frag_tx_sem, FRAG_TX_WINDOW, FRAG_TX_WINDOW);
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	msg_id = next_msg_id(long_rd_id);
+	memset(&tx, 0, sizeof(tx));
+	tx.active = true;
+	k_mutex_unlock(&frag_mutex);
+
+	for (uint32_t i = 0; i < count; i++) {
+		size_t off = (size_t)i * FRAG_DATA_MAX;
+		size_t n = MIN(len - off, (size_t)FRAG_DATA_MAX);
+		uint8_t hdr[FRAG_HDR_LEN];
+
+		if (k_sem_take(&frag_tx_sem, timeout) != 0) {
+			err = -ETIMEDOUT;
+			break;
+		}
+
+		k_mutex_lock(&frag_mutex, K_FOREVER);
+		err = tx.status;
+		k_mutex_unlock(&frag_mutex);
+		if (err != 0) {
+			k_sem_give(&frag_tx_sem);
+			break;
+		}
+
+		sys_put_le16(msg_id, &hdr[0]);
+		sys_put_le16((uint16_t)i, &hdr[2]);
+		sys_put_le16((uint16_t)count, &hdr[4]);
+		sys_put_le16(FRAG_DATA_MAX, &hdr[6]);
+		sys_put_le32((uint32_t)len, &hdr[8]);
+
+		err = send_fragment(long_rd_id, hdr, &msg[off], n);
+		if (err != 0) {
+			k_sem_give(&frag_tx_sem);
+			break;
+		}
+	}
+
+	/* Drain: the window is full again once every sent fragment has completed. */
+	for (uint32_t i = 0; i < FRAG_TX_WINDOW; i++) {
+		if (k_sem_take(&frag_tx_sem, timeout) != 0) {
+			err = (err != 0) ? err : -ETIMEDOUT;
+			break;
+		}
+	}
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	if (err == 0 && tx.status != 0) {
+		err = tx.status;
+	}
+	tx.active = false;
+	if (err == 0) {
+		stats.tx_msgs++;
+	} else {
+		stats.tx_failed++;
+	}
+	k_mutex_unlock(&frag_mutex);
+
+	k_mutex_unlock(&frag_tx_mutex);
+	return err;
+}
+
+bool frag_tx_done(uint32_t transaction_id, int status)
+{
+	bool found = false;
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	for (size_t i = 0; tx.active && i < FRAG_TX_WINDOW; i++) {
+		if (tx.used[i] && tx.transaction_id[i] == transaction_id) {
+			tx.used[i] = false;
+			if (status != 0 && tx.status == 0) {
+				tx.status = -EIO;
+			}
+			k_sem_give(&frag_tx_sem);
+			found = true;
+			break;
+		}
+	}
+	k_mutex_unlock(&frag_mutex);
+	return found;
+}
+
+/* ============================================================================
+ * RX
+ * ========================================================================== */
+
+static void deliver(uint32_t long_rd_id, const uint8_t *msg, size_t len)
+{
+	frag_rx_cb_t cb;
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	cb = rx_cb;
+	stats.rx_msgs++;
+	k_mutex_unlock(&frag_mutex);
+
+	if (cb != NULL) {
+		cb(long_rd_id, msg, len);
+	} else {
+		printk("FRAG RX from rd=%u: %zu bytes crc32=%08x\n", long_rd_id, len,
+		       crc32_ieee(msg, len));
+	}
+}
+
+/* Must be called with frag_mutex held. */
+static struct frag_rx_ctx *rx_ctx_find(uint32_t long_rd_id, uint16_t msg_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rx_ctx); i++) {
+		if (rx_ctx[i].in_use && rx_ctx[i].long_rd_id == long_rd_id &&
+		    rx_ctx[i].msg_id == msg_id) {
+			return &rx_ctx[i];
+		}
+	}
+	return NULL;
+}
+
+/* Must be called with frag_mutex held. */
+static struct frag_rx_ctx *rx_ctx_alloc(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rx_ctx); i++) {
+		if (!rx_ctx[i].in_use) {
+			struct frag_rx_ctx *ctx = &rx_ctx[i];
+
+			memset(ctx, 0, sizeof(*ctx));
+			ctx->in_use = true;
+			ctx->buf = rx_bufs[i];
+			return ctx;
+		}
+	}
+	return NULL;
+}
+
+void frag_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	struct frag_rx_ctx *ctx;
+	uint16_t msg_id, index, count, frag_size;
+	uint32_t total_len;
+	size_t n;
+	size_t expected;
+
+	if (len <= FRAG_HDR_LEN) {
+		k_mutex_lock(&frag_mutex, K_FOREVER);
+		stats.rx_malformed++;
+		k_mutex_unlock(&frag_mutex);
+		return;
+	}
+
+	n = len - FRAG_HDR_LEN;
+	msg_id = sys_get_le16(&data[0]);
+	index = sys_get_le16(&data[2]);
+	count = sys_get_le16(&data[4]);
+	frag_size = sys_get_le16(&data[6]);
+	total_len = sys_get_le32(&data[8]);
+	expected = (index + 1U < count) ? frag_size : total_len - (uint32_t)index * frag_size;
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	stats.rx_frags++;
+	if (frag_size == 0 || count == 0 || index >= count ||
+	    count != DIV_ROUND_UP(total_len, frag_size) || n != expected) {
+		stats.rx_malformed++;
+		k_mutex_unlock(&frag_mutex);
+		return;
+	}
+
+	if (count == 1) {
+		/* Unfragmented: hand over the RX buffer directly. */
+		k_mutex_unlock(&frag_mutex);
+		deliver(long_rd_id, &data[FRAG_HDR_LEN], n);
+		return;
+	}
+
+	if (total_len > FRAG_MSG_LEN_MAX || count > FRAG_RX_MAX_FRAGS) {
+		if (index == 0) {
+			stats.rx_too_big++;
+		}
+		k_mutex_unlock(&frag_mutex);
+		return;
+	}
+
+	ctx = rx_ctx_find(long_rd_id, msg_id);
+	if (ctx == NULL) {
+		ctx = rx_ctx_alloc();
+		if (ctx == NULL) {
+			stats.rx_no_buf++;
+			k_mutex_unlock(&frag_mutex);
+			return;
+		}
+		ctx->long_rd_id = long_rd_id;
+		ctx->msg_id = msg_id;
+		ctx->count = count;
+		ctx->frag_size = frag_size;
+		ctx->total_len = total_len;
+		k_work_reschedule(&frag_sweep_work,
+				  K_MSEC(CONFIG_APP_FRAG_REASSEMBLY_TIMEOUT_MS / 2));
+	} else if (ctx->count != count || ctx->frag_size != frag_size ||
+		   ctx->total_len != total_len || ctx->delivering) {
+		stats.rx_malformed++;
+		k_mutex_unlock(&frag_mutex);
+		return;
+	}
+
+	ctx->last_rx_ms = k_uptime_get_32();
+	if (ctx->map[index / 8] & BIT(index % 8)) {
+		stats.rx_dup++;
+		k_mutex_unlock(&frag_mutex);
+		return;
+	}
+
+	memcpy(&ctx->buf[(size_t)index * frag_size], &data[FRAG_HDR_LEN], n);
+	ctx->map[index / 8] |= BIT(index % 8);
+	ctx->received++;
+	if (ctx->received < ctx->count) {
+		k_mutex_unlock(&frag_mutex);
+		return;
+	}
+
+	ctx->delivering = true;
+	k_mutex_unlock(&frag_mutex);
+
+	deliver(long_rd_id, ctx->buf, ctx->total_len);
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	ctx->in_use = false;
+	k_mutex_unlock(&frag_mutex);
+}
+
+static void frag_sweep_work_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	bool pending = false;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(rx_ctx); i++) {
+		struct frag_rx_ctx *ctx = &rx_ctx[i];
+
+		if (!ctx->in_use || ctx->delivering) {
+			continue;
+		}
+		if (now - ctx->last_rx_ms >= CONFIG_APP_FRAG_REASSEMBLY_TIMEOUT_MS) {
+			LOG_WRN("FRAG: rd=%u msg=%u timed out with %u/%u fragments",
+				ctx->long_rd_id, ctx->msg_id, ctx->received, ctx->count);
+			ctx->in_use = false;
+			stats.rx_timeout++;
+		} else {
+			pending = true;
+		}
+	}
+	if (pending) {
+		k_work_reschedule(&frag_sweep_work,
+				  K_MSEC(CONFIG_APP_FRAG_REASSEMBLY_TIMEOUT_MS / 2));
+	}
+	k_mutex_unlock(&frag_mutex);
+}
+
+void frag_rx_cb_set(frag_rx_cb_t cb)
+{
+	k_mutex_lock(&frag_mutex, K_FOREVER);
+	rx_cb = cb;
+	k_mutex_unlock(&frag_mutex);
+}
+
+/* ============================================================================
+ * SHELL COMMANDS
+ * ========================================================================== */
+
+/* FRAG [SEND <len>] — show statistics or send a test pattern message. */
+static int cmd_frag(const struct shell *shell, size_t argc, char **argv)
+{
+	static uint8_t test_msg[FRAG_MSG_LEN_MAX];
+	long len;
+	int err;
+
+	if (argc < 2) {
+		k_mutex_lock(&frag_mutex, K_FOREVER);
+		shell_print(shell, "FRAG TX: msgs=%u frags=%u failed=%u", stats.tx_msgs,
+			    stats.tx_frags, stats.tx_failed);
+		shell_print(shell, "FRAG RX: msgs=%u frags=%u dup=%u timeout=%u no_buf=%u "
+			    "too_big=%u malformed=%u", stats.rx_msgs, stats.rx_frags,
+			    stats.rx_dup, stats.rx_timeout, stats.rx_no_buf, stats.rx_too_big,
+			    stats.rx_malformed);
+		k_mutex_unlock(&frag_mutex);
+		shell_print(shell, "Fragment payload %u B, RX limit %u B x %u buffers",
+			    FRAG_DATA_MAX, FRAG_MSG_LEN_MAX, FRAG_RX_BUF_COUNT);
+		return 0;
+	}
+
+	if ((strcmp(argv[1], "SEND") != 0 && strcmp(argv[1], "send") != 0) || argc < 3) {
+		shell_error(shell, "Usage: FRAG [SEND <len>]");
+		return -EINVAL;
+	}
+
+	len = strtol(argv[2], NULL, 10);
+	if (len < 1 || len > FRAG_MSG_LEN_MAX) {
+		shell_error(shell, "Length must be between 1 and %u", FRAG_MSG_LEN_MAX);
+		return -EINVAL;
+	}
+
+	for (long i = 0; i < len; i++) {
+		test_msg[i] = (uint8_t)(i * 7 + 1);
+	}
+
+	shell_print(shell, "FRAG: sending %ld bytes in %u fragment(s), crc32=%08x", len,
+		    (uint32_t)DIV_ROUND_UP(len, FRAG_DATA_MAX), crc32_ieee(test_msg, len));
+	err = frag_send(0, test_msg, (size_t)len, K_SECONDS(10));
+	if (err != 0) {
+		shell_error(shell, "FRAG send failed: %d", err);
+		return err;
+	}
+	shell_print(shell, "FRAG: sent");
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(FRAG, NULL, "FRAG [SEND <len>] — fragmentation stats / test message", cmd_frag, 1, 2);
+SHELL_CMD_ARG_REGISTER(frag, NULL, "frag [send <len>] — fragmentation stats / test message", cmd_frag, 1, 2);
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FRAG_H__
+#define FRAG_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file frag.h
+ * @brief Segmentation and reassembly of messages larger than one DLC SDU.
+ *
+ * frag_send() splits a message into fragments on APP_DLC_PORT_FRAG, keeping up
+ * to CONFIG_APP_FRAG_TX_WINDOW of them in flight. The receiver reassembles
+ * per (sender, message ID) into a fixed pool of CONFIG_APP_FRAG_RX_BUF_COUNT
+ * buffers of CONFIG_APP_FRAG_MSG_LEN_MAX bytes; incomplete messages are
+ * discarded after CONFIG_APP_FRAG_REASSEMBLY_TIMEOUT_MS without progress.
+ */
+
+/**
+ * @brief Completed-message handler.
+ *
+ * Called from the main event loop with a pointer into the reassembly buffer
+ * (no copy). The buffer is returned to the pool when the handler returns, so
+ * the handler must not block or keep @p msg.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param msg        Reassembled message
+ * @param len        Message length
+ */
+typedef void (*frag_rx_cb_t)(uint32_t long_rd_id, const uint8_t *msg, size_t len);
+
+/**
+ * @brief Send a message as a pipelined series of fragments.
+ *
+ * Blocks until every fragment has a TX completion. @p data must stay valid
+ * until then. Must not be called from the main event loop, which delivers
+ * the TX completions this call waits for. One message is sent at a time;
+ * concurrent callers are serialised.
+ *
+ * @param long_rd_id Destination, or 0 for the associated peer
+ * @param data       Message bytes
+ * @param len        Message length, 1..CONFIG_APP_FRAG_MSG_LEN_MAX
+ * @param timeout    Maximum wait for each TX window slot
+ * @return 0 on success, -EMSGSIZE if the message is longer than
+ *         CONFIG_APP_FRAG_MSG_LEN_MAX, -EIO if a fragment failed in the modem, -ETIMEDOUT if
+ *         the window did not open in time, or a send error
+ */
+int frag_send(uint32_t long_rd_id, const void *data, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Register the completed-message handler.
+ *
+ * @param cb Handler, or NULL to print a summary of each message
+ */
+void frag_rx_cb_set(frag_rx_cb_t cb);
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_FRAG.
+ *
+ * Called from the main event loop.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload (port byte stripped)
+ * @param len        Payload length
+ */
+void frag_rx(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+/**
+ * @brief Offer a DLC TX completion to the fragmentation layer.
+ *
+ * @param transaction_id Transaction ID of the completed SDU
+ * @param status         Modem completion status (0 = success)
+ * @return true if the transaction was a fragment sent by frag_send()
+ */
+bool frag_tx_done(uint32_t transaction_id, int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAG_H__ */
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "ft_assoc.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(ft_assoc, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define FT_ASSOC_MAX        CONFIG_APP_FT_MAX_PTS
+/* Index size: a power of two at least twice the capacity keeps probes short. */
+#define FT_ASSOC_INDEX_BITS (LOG2CEIL(FT_ASSOC_MAX) + 1)
+#define FT_ASSOC_INDEX_SIZE BIT(FT_ASSOC_INDEX_BITS)
+#define FT_ASSOC_INDEX_MASK (FT_ASSOC_INDEX_SIZE - 1)
+#define FT_ASSOC_EMPTY      0xff
+
+BUILD_ASSERT(FT_ASSOC_MAX < FT_ASSOC_EMPTY, "slot numbers must fit the index");
+
+struct ft_assoc_slot {
+	struct ft_assoc_peer peer; /* long_rd_id 0 = free */
+	uint32_t seq;              /* association order, for ft_assoc_latest() */
+};
+
+static struct ft_assoc_slot slots[FT_ASSOC_MAX];
+/* Open-addressing index with linear probing: slot number or FT_ASSOC_EMPTY. */
+static uint8_t index_tbl[FT_ASSOC_INDEX_SIZE];
+static size_t count;
+static uint32_t next_seq;
+static bool index_ready;
+
+/* Leaf lock: taken with app_mutex or tx_sched_mutex held. */
+static K_MUTEX_DEFINE(ft_assoc_mutex);
+
+static uint32_t hash(uint32_t long_rd_id)
+{
+	/* Fibonacci hashing: RD IDs are often sequential or share high bits. */
+	return (long_rd_id * 2654435761U) >> (32 - FT_ASSOC_INDEX_BITS);
+}
+
+/* Must be called with ft_assoc_mutex held. */
+static void index_init_locked(void)
+{
+	if (!index_ready) {
+		memset(index_tbl, FT_ASSOC_EMPTY, sizeof(index_tbl));
+		index_ready = true;
+	}
+}
+
+/* Must be called with ft_assoc_mutex held. Returns the index position holding
+ * long_rd_id, or the empty position where it would go. */
+static uint32_t probe_locked(uint32_t long_rd_id)
+{
+	uint32_t pos = hash(long_rd_id);
+
+	index_init_locked();
+	while (index_tbl[pos] != FT_ASSOC_EMPTY &&
+	       slots[index_tbl[pos]].peer.long_rd_id != long_rd_id) {
+		pos = (pos + 1) & FT_ASSOC_INDEX_MASK;
+	}
+	return pos;
+}
+
+/* Must be called with ft_assoc_mutex held. */
+static struct ft_assoc_slot *find_locked(uint32_t long_rd_id)
+{
+	uint32_t pos;
+
+	if (long_rd_id == 0) {
+		return NULL;
+	}
+	pos = probe_locked(long_rd_id);
+	return (index_tbl[pos] == FT_ASSOC_EMPTY) ? NULL : &slots[index_tbl[pos]];
+}
+
+/* Must be called with ft_assoc_mutex held. Backward-shift deletion keeps every
+ * remaining entry reachable from its home position without tombstones. */
+static void index_delete_locked(uint32_t pos)
+{
+	uint32_t next = pos;
+
+	index_tbl[pos] = FT_ASSOC_EMPTY;
+	for (;;) {
+		uint32_t home;
+
+		next = (next + 1) & FT_ASSOC_INDEX_MASK;
+		if (index_tbl[next] == FT_ASSOC_EMPTY) {
+			return;
+		}
+		home = hash(slots[index_tbl[next]].peer.long_rd_id);
+		/* Move the entry into the hole unless its home lies cyclically in (pos, next]. */
+		if (((next - home) & FT_ASSOC_INDEX_MASK) >= ((next - pos) & FT_ASSOC_INDEX_MASK)) {
+			index_tbl[pos] = index_tbl[next];
+			index_tbl[next] = FT_ASSOC_EMPTY;
+			pos = next;
+		}
+	}
+}
+
+int ft_assoc_add(uint32_t long_rd_id)
+{
+	struct ft_assoc_slot *slot;
+	uint32_t associations = 0;
+	uint32_t pos;
+	int err = 0;
+
+	if (long_rd_id == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	pos = probe_locked(long_rd_id);
+	if (index_tbl[pos] != FT_ASSOC_EMPTY) {
+		slot = &slots[index_tbl[pos]];
+		associations = slot->peer.associations;
+	} else if (count >= FT_ASSOC_MAX) {
+		slot = NULL;
+		err = -ENOMEM;
+	} else {
+		slot = NULL;
+		for (int i = 0; i < FT_ASSOC_MAX; i++) {
+			if (slots[i].peer.long_rd_id == 0) {
+				slot = &slots[i];
+				index_tbl[pos] = (uint8_t)i;
+				count++;
+				break;
+			}
+		}
+	}
+	if (slot != NULL) {
+		memset(slot, 0, sizeof(*slot));
+		slot->peer.long_rd_id = long_rd_id;
+		slot->peer.associated_ms = k_uptime_get_32();
+		slot->peer.associations = associations + 1;
+		slot->seq = ++next_seq;
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+	return err;
+}
+
+bool ft_assoc_remove(uint32_t long_rd_id)
+{
+	uint32_t pos;
+	bool found = false;
+
+	if (long_rd_id == 0) {
+		return false;
+	}
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	pos = probe_locked(long_rd_id);
+	if (index_tbl[pos] != FT_ASSOC_EMPTY) {
+		memset(&slots[index_tbl[pos]], 0, sizeof(slots[0]));
+		index_delete_locked(pos);
+		count--;
+		found = true;
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+	return found;
+}
+
+void ft_assoc_clear(void)
+{
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	memset(slots, 0, sizeof(slots));
+	memset(index_tbl, FT_ASSOC_EMPTY, sizeof(index_tbl));
+	index_ready = true;
+	count = 0;
+	k_mutex_unlock(&ft_assoc_mutex);
+}
+
+bool ft_assoc_contains(uint32_t long_rd_id)
+{
+	bool found;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	found = find_locked(long_rd_id) != NULL;
+	k_mutex_unlock(&ft_assoc_mutex);
+	return found;
+}
+
+size_t ft_assoc_count(void)
+{
+	size_t n;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	n = count;
+	k_mutex_unlock(&ft_assoc_mutex);
+	return n;
+}
+
+uint32_t ft_assoc_latest(void)
+{
+	const struct ft_assoc_slot *latest = NULL;
+	uint32_t long_rd_id;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	for (int i = 0; i < FT_ASSOC_MAX; i++) {
+		if (slots[i].peer.long_rd_id != 0 && (latest == NULL || slots[i].seq > latest->seq)) {
+			latest = &slots[i];
+		}
+	}
+	long_rd_id = (latest != NULL) ? latest->peer.long_rd_id : 0;
+	k_mutex_unlock(&ft_assoc_mutex);
+	return long_rd_id;
+}
+
+int ft_assoc_get(uint32_t long_rd_id, struct ft_assoc_peer *out)
+{
+	const struct ft_assoc_slot *slot;
+	int err = -ENOENT;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	slot = find_locked(long_rd_id);
+	if (slot != NULL) {
+		*out = slot->peer;
+		err = 0;
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+	return err;
+}
+
+size_t ft_assoc_list(uint32_t *long_rd_ids, size_t max)
+{
+	size_t n = 0;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	for (int i = 0; i < FT_ASSOC_MAX && n < max; i++) {
+		if (slots[i].peer.long_rd_id != 0) {
+			long_rd_ids[n++] = slots[i].peer.long_rd_id;
+		}
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+	return n;
+}
+
+void ft_assoc_foreach(ft_assoc_foreach_cb_t cb, void *user_data)
+{
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	for (int i = 0; i < FT_ASSOC_MAX; i++) {
+		if (slots[i].peer.long_rd_id != 0) {
+			cb(&slots[i].peer, user_data);
+		}
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+}
+
+void ft_assoc_note_tx(uint32_t long_rd_id, size_t sdu_len, int status)
+{
+	struct ft_assoc_slot *slot;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	slot = find_locked(long_rd_id);
+	if (slot != NULL) {
+		if (status == 0) {
+			slot->peer.tx_ok++;
+			slot->peer.tx_bytes += sdu_len;
+		} else {
+			slot->peer.tx_fail++;
+		}
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+}
+
+void ft_assoc_note_rx(uint32_t long_rd_id, size_t len)
+{
+	struct ft_assoc_slot *slot;
+
+	k_mutex_lock(&ft_assoc_mutex, K_FOREVER);
+	slot = find_locked(long_rd_id);
+	if (slot != NULL) {
+		slot->peer.rx_sdus++;
+		slot->peer.rx_bytes += len;
+		slot->peer.last_rx_ms = k_uptime_get_32();
+	}
+	k_mutex_unlock(&ft_assoc_mutex);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FT_ASSOC_H__
+#define FT_ASSOC_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ft_assoc.h
+ * @brief FT association table: the PTs associated with this FT.
+ *
+ * Holds up to CONFIG_APP_FT_MAX_PTS PTs, which is also the neighbour limit
+ * given to the modem. Lookup by long RD ID is O(1) (open addressing over a
+ * power-of-two index). The table has its own mutex, taken below app_mutex
+ * and tx_sched; every function may be called from thread context with or
+ * without those held.
+ */
+
+/** One associated PT and its counters since it (re)associated. */
+struct ft_assoc_peer {
+	uint32_t long_rd_id;
+	uint32_t associated_ms;   /**< Uptime at the latest association */
+	uint32_t last_rx_ms;      /**< Uptime of the latest RX, 0 = none */
+	uint32_t associations;    /**< Association indications while in the table */
+	uint32_t tx_ok;
+	uint32_t tx_fail;
+	uint32_t tx_bytes;
+	uint32_t rx_sdus;
+	uint32_t rx_bytes;
+};
+
+/**
+ * @brief Callback for ft_assoc_foreach().
+ *
+ * Runs with the table mutex held; must not call back into ft_assoc.
+ */
+typedef void (*ft_assoc_foreach_cb_t)(const struct ft_assoc_peer *peer, void *user_data);
+
+/**
+ * @brief Add a PT, or refresh it if already present.
+ *
+ * A known PT keeps its slot; its counters restart and its association
+ * count goes up.
+ *
+ * @param long_rd_id PT long RD ID (non-zero)
+ * @return 0 on success, -ENOMEM if the table is full, -EINVAL for RD ID 0
+ */
+int ft_assoc_add(uint32_t long_rd_id);
+
+/**
+ * @brief Remove a PT.
+ *
+ * @param long_rd_id PT long RD ID
+ * @return true if it was in the table
+ */
+bool ft_assoc_remove(uint32_t long_rd_id);
+
+/** @brief Remove every PT. */
+void ft_assoc_clear(void);
+
+/**
+ * @brief Check whether a PT is associated.
+ *
+ * @param long_rd_id PT long RD ID
+ * @return true if it is in the table
+ */
+bool ft_assoc_contains(uint32_t long_rd_id);
+
+/** @brief Number of associated PTs. */
+size_t ft_assoc_count(void);
+
+/**
+ * @brief Most recently associated PT still in the table.
+ *
+ * This is the peer that long RD ID 0 ("the associated peer") means on an FT.
+ *
+ * @return Long RD ID, or 0 if the table is empty
+ */
+uint32_t ft_assoc_latest(void);
+
+/**
+ * @brief Copy one PT's entry.
+ *
+ * @param long_rd_id PT long RD ID
+ * @param out        Copy of the entry
+ * @return 0 on success, -ENOENT if not associated
+ */
+int ft_assoc_get(uint32_t long_rd_id, struct ft_assoc_peer *out);
+
+/**
+ * @brief Snapshot the RD IDs of all associated PTs, in slot order.
+ *
+ * @param long_rd_ids Output array
+ * @param max         Size of @p long_rd_ids
+ * @return Number of RD IDs written
+ */
+size_t ft_assoc_list(uint32_t *long_rd_ids, size_t max);
+
+/**
+ * @brief Call @p cb for every associated PT.
+ *
+ * @param cb        Callback
+ * @param user_data Passed to @p cb
+ */
+void ft_assoc_foreach(ft_assoc_foreach_cb_t cb, void *user_data);
+
+/**
+ * @brief Count a modem TX completion towards a PT; ignored for unknown RD IDs.
+ *
+ * @param long_rd_id Destination long RD ID
+ * @param sdu_len    SDU length in bytes
+ * @param status     Completion status (0 = success)
+ */
+void ft_assoc_note_tx(uint32_t long_rd_id, size_t sdu_len, int status);
+
+/**
+ * @brief Count a received SDU from a PT; ignored for unknown RD IDs.
+ *
+ * @param long_rd_id Source long RD ID
+ * @param len        SDU length in bytes
+ */
+void ft_assoc_note_rx(uint32_t long_rd_id, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FT_ASSOC_H__ */
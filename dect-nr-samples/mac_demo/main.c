@@ -15,13 +15,39 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/base64.h>
+#include <zephyr/sys/util.h>
+#if defined(CONFIG_DK_LIBRARY)
 #include <dk_buttons_and_leds.h>
+#endif
+#include "app_dlc.h"
+#include "bcast.h"
+#include "beacon_adapt.h"
+#include "chan_db.h"
+#include "coalesce.h"
+#include "compress.h"
 #include "dect_adapter.h"
+#include "dlc_ep.h"
+#include "dlc_net.h"
+#include "frag.h"
+#include "ft_assoc.h"
+#include "outbox.h"
+#include "perf.h"
+#include "ping.h"
+#include "power.h"
+#include "rach_tune.h"
+#include "relay.h"
+#include "rpc.h"
+#include "seqtrack.h"
+#include "spectrum.h"
+#include "telemetry.h"
+#include "timesync.h"
+#include "trace.h"
+#include "tx_sched.h"
 
 LOG_MODULE_REGISTER(app, CONFIG_LOG_DEFAULT_LEVEL);
 
-#define APP_DATA_LEN_MAX 96
-#define APP_FLOW_ID 1
 #define APP_POLL_DELAY_MS 100
 #define PT_BEACON_TABLE_SIZE 20
 
@@ -51,6 +77,7 @@ enum app_event_type {
 	APP_EVT_ASSOCIATION_IND,
 	APP_EVT_ASSOCIATION_RELEASE,
 	APP_EVT_DLC_RX,
+	APP_EVT_DLC_TX,
 	APP_EVT_OP_NETWORK_SCAN,
 	APP_EVT_OP_CLUSTER_BEACON_RECEIVE,
 	APP_EVT_OP_CLUSTER_BEACON_RECEIVE_STOP,
@@ -85,8 +112,14 @@ struct app_event {
 		struct {
 			uint32_t long_rd_id;
 			size_t len;
-			char text[APP_DATA_LEN_MAX + 1];
+			uint8_t *data; /* block from dlc_rx_slab, freed by the event loop */
+			int64_t rx_ticks;
+			uint8_t port;  /* data NULL: SDU already queued to a DLC endpoint */
 		} dlc_rx;
+		struct {
+			int status;
+			uint32_t transaction_id;
+		} dlc_tx;
 		struct {
 			int status;
 		} op_network_scan;
@@ -119,6 +152,7 @@ struct pt_beacon_entry {
 static K_MUTEX_DEFINE(app_mutex);
 static K_SEM_DEFINE(op_sem, 0, 1);
 K_MSGQ_DEFINE(app_evt_msgq, sizeof(struct app_event), 16, 4);
+K_MEM_SLAB_DEFINE_STATIC(dlc_rx_slab, APP_DLC_SDU_LEN_MAX, CONFIG_APP_DLC_RX_BUF_COUNT, 4);
 
 static void led_work_handler(struct k_work *work);
 static void pt_scan_work_handler(struct k_work *work);
@@ -126,8 +160,14 @@ static void pt_associate_work_handler(struct k_work *work);
 static void pt_subscribe_timeout_handler(struct k_work *work);
 static void pt_recovery_work_handler(struct k_work *work);
 static void pt_resubscribe_work_handler(struct k_work *work);
+static void pt_subscribe_work_handler(struct k_work *work);
 static void pt_schedule_fast_recovery(const char *reason);
+static void relay_cluster_work_handler(struct k_work *work);
+static void rach_tune_work_handler(struct k_work *work);
+static void beacon_adapt_work_handler(struct k_work *work);
+static void spectrum_work_handler(struct k_work *work);
 static int apply_control_configure(void);
+static void dlc_tx_flushed(int status, uint32_t transaction_id);
 
 static K_WORK_DELAYABLE_DEFINE(led_work, led_work_handler);
 static K_WORK_DELAYABLE_DEFINE(pt_scan_work, pt_scan_work_handler);
@@ -135,6 +175,11 @@ static K_WORK_DELAYABLE_DEFINE(pt_associate_work, pt_associate_work_handler);
 static K_WORK_DELAYABLE_DEFINE(pt_subscribe_timeout_work, pt_subscribe_timeout_handler);
 static K_WORK_DELAYABLE_DEFINE(pt_recovery_work, pt_recovery_work_handler);
 static K_WORK_DELAYABLE_DEFINE(pt_resubscribe_work, pt_resubscribe_work_handler);
+static K_WORK_DELAYABLE_DEFINE(pt_subscribe_work, pt_subscribe_work_handler);
+static K_WORK_DELAYABLE_DEFINE(relay_cluster_work, relay_cluster_work_handler);
+static K_WORK_DELAYABLE_DEFINE(rach_tune_work, rach_tune_work_handler);
+static K_WORK_DELAYABLE_DEFINE(beacon_adapt_work, beacon_adapt_work_handler);
+static K_WORK_DELAYABLE_DEFINE(spectrum_work, spectrum_work_handler);
 
 static enum app_mode current_mode = APP_MODE_IDLE;
 static uint16_t current_carrier = (CONFIG_APP_FIXED_CHANNEL != 0) ? CONFIG_APP_FIXED_CHANNEL : 1657;
@@ -142,10 +187,10 @@ static bool use_fixed_channel = (CONFIG_APP_FIXED_CHANNEL != 0);
 static uint32_t pt_scan_time_ms = CONFIG_APP_DEFAULT_PT_SCAN_TIME_PER_CHANNEL_MS;
 static uint32_t ft_period_ms = CONFIG_APP_DEFAULT_FT_PERIOD_MS;
 static uint32_t nw_period_ms = CONFIG_APP_DEFAULT_NW_BEACON_PERIOD_MS;
+static uint32_t ft_period_active_ms = CONFIG_APP_DEFAULT_FT_PERIOD_MS; /* in use; ft_period_ms when idle */
 static bool power_save_enabled;
 static uint32_t device_long_rd_id;
 static bool app_ready;
-static bool ft_child_associated;
 static bool pt_associated;
 static bool pt_scan_in_progress;
 static bool pt_association_pending;
@@ -153,7 +198,6 @@ static bool pt_network_found;
 static bool ft_scan_result_valid;
 static bool ft_post_scan; /* set after RSSI scan; configure_ft skips functional_mode bounce */
 static bool pt_pending_subscribe; /* cmd_pt: waiting for beacon to sync timing before subscribe */
-static uint32_t ft_child_long_rd_id;
 static uint16_t ft_scan_best_channel = 1657;
 static uint8_t ft_scan_best_busy = UINT8_MAX;
 static uint32_t pt_parent_long_rd_id;
@@ -163,15 +207,28 @@ static uint32_t pt_parent_ft_period_ms; /* FT beacon period learned from beacon
 static uint8_t pt_association_retries;  /* failed attempts since last successful association */
 static uint8_t pt_recovery_attempts;   /* consecutive auto-recovery cycles; reset on success */
 static uint8_t pt_dlc_tx_fail_count;   /* consecutive DLC TX failures while associated */
-static uint8_t ft_rach_fill_percentage = 100; /* RACH fill percentage (1-100) for FT cluster config */
+static struct dect_adapter_rach_params ft_rach = DECT_ADAPTER_RACH_PARAMS_DEFAULT; /* FT cluster RACH */
+static uint8_t ft_rach_ceiling = 100; /* RACH tuning: highest fill, from PROFILE */
+static uint16_t relay_channel;  /* RELAY: downstream cluster carrier, 0 = plain PT */
+static bool relay_cluster_up;   /* RELAY: downstream cluster configured */
 static struct pt_beacon_entry pt_beacon_table[PT_BEACON_TABLE_SIZE];
 static uint8_t pt_beacon_table_count;
 static uint32_t tx_transaction_id = 1;
 static uint32_t pending_tx_transaction_id;
+static atomic_t dlc_rx_drop_count; /* SDUs dropped in callback: no RX buffer or queue full */
+static atomic_t app_evt_drop_count; /* app events lost to a full app_evt_msgq */
+static uint32_t pt_recovery_count;  /* auto-recovery cycles started since boot */
+static app_dlc_rx_cb_t dlc_rx_cb;
 static int scan_threshold_min = -85; /* dBm: carrier free if RSSI below this */
 static int scan_threshold_max = -70; /* dBm: carrier busy if RSSI above this */
 static volatile enum wait_reason current_wait = WAIT_NONE;
 static volatile int wait_status;
+/* One modem operation at a time: held from prepare_wait() until
+ * wait_for_prepared_operation() or cancel_wait(), so the shell, the event loop
+ * and the background work handlers cannot take each other's completion on
+ * op_sem. Recursive, so multi-step sequences hold it across their steps.
+ * Taken before app_mutex. */
+static K_MUTEX_DEFINE(modem_op_mutex);
 
 static const char *mode_name(enum app_mode mode)
 {
@@ -182,19 +239,22 @@ static const char *mode_name(enum app_mode mode)
 	}
 }
 
-static void app_event_put(const struct app_event *evt)
+static int app_event_put(const struct app_event *evt)
 {
 	int err = k_msgq_put(&app_evt_msgq, evt, K_NO_WAIT);
 
 	if (err != 0) {
-		LOG_ERR("Dropping app event %d", evt->type);
+		atomic_val_t dropped = atomic_inc(&app_evt_drop_count) + 1;
+
+		trace_event(TRACE_APP_EVT_DROP, evt->type, (uint32_t)dropped, 0);
 	}
+	return err;
 }
 
 static void complete_wait(enum wait_reason reason, int status)
 {
 	if (current_wait != reason) {
-		LOG_ERR("Received completion for wait reason %d, but current wait is %d", reason, current_wait);
+		trace_event(TRACE_WAIT_MISMATCH, 0, reason, current_wait);
 		return;
 	}
 
@@ -204,6 +264,7 @@ static void complete_wait(enum wait_reason reason, int status)
 
 static void prepare_wait(enum wait_reason reason)
 {
+	k_mutex_lock(&modem_op_mutex, K_FOREVER);
 	while (k_sem_take(&op_sem, K_NO_WAIT) == 0) {
 	}
 
@@ -216,46 +277,58 @@ static void cancel_wait(enum wait_reason reason)
 	if (current_wait == reason) {
 		current_wait = WAIT_NONE;
 	}
+	k_mutex_unlock(&modem_op_mutex);
 }
 
 static int wait_for_prepared_operation(enum wait_reason reason, k_timeout_t timeout)
 {
-	if (current_wait != reason) {
-		return -EINVAL;
-	}
+	int err;
 
-	if (k_sem_take(&op_sem, timeout) != 0) {
+	if (current_wait != reason) {
+		err = -EINVAL;
+	} else if (k_sem_take(&op_sem, timeout) != 0) {
+		current_wait = WAIT_NONE;
+		err = -ETIMEDOUT;
+	} else {
 		current_wait = WAIT_NONE;
-		return -ETIMEDOUT;
+		err = wait_status;
 	}
+	k_mutex_unlock(&modem_op_mutex);
+	return err;
+}
 
-	current_wait = WAIT_NONE;
-	return wait_status;
+/* All LEDs on or off; a no-op without the DK library (native_sim). */
+static void leds_set(bool on)
+{
+#if defined(CONFIG_DK_LIBRARY)
+	dk_set_leds(on ? DK_ALL_LEDS_MSK : 0);
+#else
+	ARG_UNUSED(on);
+#endif
 }
 
 static void led_apply(void)
 {
 	switch (current_mode) {
 	case APP_MODE_FT:
-		dk_set_leds(DK_ALL_LEDS_MSK);
+		leds_set(true);
 		break;
 	case APP_MODE_PT:
 		k_work_reschedule(&led_work, K_NO_WAIT);
 		break;
 	default:
-		dk_set_leds(0);
+		leds_set(false);
 		break;
 	}
 }
 
 static void reset_link_state(void)
 {
-	ft_child_associated = false;
+	ft_assoc_clear();
 	pt_associated = false;
 	pt_scan_in_progress = false;
 	pt_association_pending = false;
 	pt_network_found = false;
-	ft_child_long_rd_id = 0;
 	pt_parent_long_rd_id = 0;
 	pt_parent_channel = current_carrier;
 	pt_network_id = CONFIG_APP_NETWORK_ID;
@@ -264,6 +337,8 @@ static void reset_link_state(void)
 	pt_recovery_attempts = 0;
 	pt_dlc_tx_fail_count = 0;
 	pt_pending_subscribe = false;
+	relay_cluster_up = false;
+	relay_reset();
 	/* Note: pt_beacon_table is NOT cleared here; it persists across resets
 	 * so that PT <channel> can be called after PT_SCAN without rescanning. */
 }
@@ -285,7 +360,12 @@ static int stop_pt_activity(void)
 
 	k_work_cancel_delayable(&pt_scan_work);
 	k_work_cancel_delayable(&pt_subscribe_timeout_work);
+	k_work_cancel_delayable(&pt_subscribe_work);
 	k_work_cancel_delayable(&pt_recovery_work);
+	k_work_cancel_delayable(&relay_cluster_work);
+	k_work_cancel_delayable(&rach_tune_work);
+	k_work_cancel_delayable(&beacon_adapt_work);
+	k_work_cancel_delayable(&spectrum_work);
 	return 0;
 }
 
@@ -364,13 +444,18 @@ static int run_rssi_scan(void)
 		return err;
 	}
 
+	/* Choose from the accumulated history, not just this pass. */
+	if (ft_scan_result_valid &&
+	    chan_db_best(&ft_scan_best_channel, &ft_scan_best_busy) != 0) {
+		ft_scan_result_valid = false;
+	}
 	if (ft_scan_result_valid) {
 		if (!use_fixed_channel) {
 			current_carrier = ft_scan_best_channel;
-			LOG_INF("RSSI scan best: ch=%u busy=%u%% -> current_carrier set",
+			LOG_INF("RSSI scan best: ch=%u avg busy=%u%% -> current_carrier set",
 				ft_scan_best_channel, ft_scan_best_busy);
 		} else {
-			LOG_INF("RSSI scan best: ch=%u busy=%u%% (fixed channel %u, current_carrier unchanged)",
+			LOG_INF("RSSI scan best: ch=%u avg busy=%u%% (fixed channel %u, current_carrier unchanged)",
 				ft_scan_best_channel, ft_scan_best_busy, current_carrier);
 		}
 	} else {
@@ -382,34 +467,25 @@ static int run_rssi_scan(void)
 	return 0;
 }
 
-static int configure_ft(void)
+/* Cluster and network beacon configuration; see cluster_start(). */
+static int cluster_configure(uint16_t carrier)
 {
+	uint32_t nw_ms = nw_period_ms;
 	int err;
-	uint32_t nw_beacon_period_ms;
 
-	if (ft_post_scan) {
-		/* Modem is already activated and idle after RSSI scan.
-		 * Skip the functional_mode bounce — the NCS driver goes directly
-		 * from scan completion to cluster_configure. */
-		ft_post_scan = false;
-		(void)stop_pt_activity();
-		reset_link_state();
-		ft_scan_result_valid = false;
-		ft_scan_best_channel = current_carrier;
-		ft_scan_best_busy = UINT8_MAX;
-	} else {
-		err = init_mac(false);
-		if (err != 0) {
-			return err;
-		}
+	/* An adaptive cluster period takes the network beacon along, so a short
+	 * period also speeds up discovery by joining PTs. */
+	if (beacon_adapt_enabled() &&
+	    dect_adapter_nw_period_from_cluster_period(ft_period_active_ms, &nw_ms) != 0) {
+		nw_ms = nw_period_ms;
 	}
 
 	LOG_INF("FT cluster configure: ch=%u nw=%u period=%u ms",
-		current_carrier, CONFIG_APP_NETWORK_ID, ft_period_ms);
+		carrier, CONFIG_APP_NETWORK_ID, ft_period_active_ms);
 	prepare_wait(WAIT_CLUSTER_CONFIGURE);
 	err = dect_adapter_cluster_configure_ft(
-		current_carrier, ft_period_ms, CONFIG_APP_NETWORK_ID, CONFIG_APP_TX_POWER,
-		ft_rach_fill_percentage);
+		carrier, ft_period_active_ms, CONFIG_APP_NETWORK_ID, CONFIG_APP_TX_POWER,
+		&ft_rach, CONFIG_APP_FT_MAX_PTS);
 	if (err != 0) {
 		cancel_wait(WAIT_CLUSTER_CONFIGURE);
 		LOG_ERR("FT cluster configure submit failed: %d", err);
@@ -422,12 +498,10 @@ static int configure_ft(void)
 		return err;
 	}
 
-	nw_beacon_period_ms = nw_period_ms;
-
 	LOG_DBG("FT network beacon configure: ch=%u period=%u ms (cluster=%u ms)",
-		current_carrier, nw_beacon_period_ms, ft_period_ms);
+		carrier, nw_ms, ft_period_active_ms);
 	prepare_wait(WAIT_NETWORK_BEACON_CONFIGURE);
-	err = dect_adapter_network_beacon_configure_ft(current_carrier, nw_beacon_period_ms);
+	err = dect_adapter_network_beacon_configure_ft(carrier, nw_ms);
 	if (err != 0) {
 		cancel_wait(WAIT_NETWORK_BEACON_CONFIGURE);
 		LOG_ERR("FT network beacon submit failed: %d", err);
@@ -440,8 +514,55 @@ static int configure_ft(void)
 		return err;
 	}
 
+	return 0;
+}
+
+/* Configure the cluster and network beacons on carrier: the whole FT role on
+ * top of an activated modem. Also used for the downstream side of a relay.
+ * Both steps run under one hold of the modem lock, so no other operation
+ * lands between them. */
+static int cluster_start(uint16_t carrier)
+{
+	int err;
+
+	k_mutex_lock(&modem_op_mutex, K_FOREVER);
+	err = cluster_configure(carrier);
+	k_mutex_unlock(&modem_op_mutex);
+	return err;
+}
+
+static int configure_ft(void)
+{
+	int err;
+
+	if (ft_post_scan) {
+		/* Modem is already activated and idle after RSSI scan.
+		 * Skip the functional_mode bounce — the NCS driver goes directly
+		 * from scan completion to cluster_configure. */
+		ft_post_scan = false;
+		(void)stop_pt_activity();
+		reset_link_state();
+		ft_scan_result_valid = false;
+		ft_scan_best_channel = current_carrier;
+		ft_scan_best_busy = UINT8_MAX;
+	} else {
+		err = init_mac(false);
+		if (err != 0) {
+			return err;
+		}
+	}
+
+	ft_period_active_ms = ft_period_ms;
+	err = cluster_start(current_carrier);
+	if (err != 0) {
+		return err;
+	}
+
 	current_mode = APP_MODE_FT;
 	led_apply();
+	k_work_reschedule(&rach_tune_work, K_MSEC(CONFIG_APP_RACH_TUNE_INTERVAL_MS));
+	k_work_reschedule(&beacon_adapt_work, K_MSEC(CONFIG_APP_BEACON_ADAPT_INTERVAL_MS));
+	k_work_reschedule(&spectrum_work, K_MSEC(CONFIG_APP_SPECTRUM_INTERVAL_MS));
 	LOG_DBG("FT beacon started: rd=%u ch=%u nw=%u period=%u ms",
 		device_long_rd_id, current_carrier, CONFIG_APP_NETWORK_ID, ft_period_ms);
 	return 0;
@@ -495,26 +616,34 @@ static int start_pt_scan_mode(uint16_t channel)
 	int err;
 	uint16_t scan_channel;
 
+	/* Called without app_mutex: the modem operations take modem_op_mutex,
+	 * which comes first in the lock order. */
 	err = init_mac(true);
 	if (err != 0) {
 		return err;
 	}
 
+	k_mutex_lock(&app_mutex, K_FOREVER);
 	current_mode = APP_MODE_PT;
-	led_apply();
 
 	/* Clear table for a fresh scan */
 	memset(pt_beacon_table, 0, sizeof(pt_beacon_table));
 	pt_beacon_table_count = 0;
 
 	scan_channel = (channel != 0) ? channel : (use_fixed_channel ? current_carrier : 0);
+	/* Set before the start, so the scan-done event cannot be overtaken. */
+	pt_scan_in_progress = true;
+	k_mutex_unlock(&app_mutex);
+	led_apply();
 
 	LOG_INF("PT network scan: channel=%u dwell=%u ms nw=%u",
 		scan_channel, pt_scan_time_ms, CONFIG_APP_NETWORK_ID);
 	err = dect_adapter_network_scan_start(scan_channel, pt_scan_time_ms,
 					      CONFIG_APP_NETWORK_ID);
-	if (err == 0) {
-		pt_scan_in_progress = true;
+	if (err != 0) {
+		k_mutex_lock(&app_mutex, K_FOREVER);
+		pt_scan_in_progress = false;
+		k_mutex_unlock(&app_mutex);
 	}
 
 	return err;
@@ -573,39 +702,216 @@ static int restart_current_mode(void)
 	}
 }
 
-static int send_ascii(enum app_mode source_mode, const char *text)
+/* Resolve a destination: 0 is the parent FT on a PT, the most recently
+ * associated PT on an FT; anything else must be associated. A relay reaches
+ * its parent and its own PTs. Must be called with app_mutex held. */
+static int resolve_peer(enum app_mode source_mode, uint32_t long_rd_id, uint32_t *peer)
 {
-	int err;
-	uint32_t target_long_rd_id;
-	char tx_buf[APP_DATA_LEN_MAX + 1];
-
 	if (source_mode == APP_MODE_FT) {
-		if (!ft_child_associated) {
+		if (long_rd_id == 0) {
+			long_rd_id = ft_assoc_latest();
+		}
+		if (long_rd_id == 0 || !ft_assoc_contains(long_rd_id)) {
 			return -ENOTCONN;
 		}
-		target_long_rd_id = ft_child_long_rd_id;
+	} else if (relay_cluster_up && long_rd_id != 0 && ft_assoc_contains(long_rd_id)) {
+		/* Relay: one of the PTs of the downstream cluster. */
 	} else {
-		if (!pt_associated) {
+		if (!pt_associated || (long_rd_id != 0 && long_rd_id != pt_parent_long_rd_id)) {
 			return -ENOTCONN;
 		}
-		target_long_rd_id = pt_parent_long_rd_id;
+		long_rd_id = pt_parent_long_rd_id;
+	}
+	*peer = long_rd_id;
+	return 0;
+}
+
+/* Queue one SDU on a port and flow to long_rd_id, resolved by resolve_peer().
+ * The payload is hdr followed by data; either part may be empty. Must be
+ * called with app_mutex held. */
+static int send_data(enum app_mode source_mode, uint32_t long_rd_id, uint8_t flow_id,
+		     uint8_t port, const void *hdr, size_t hdr_len, const void *data, size_t len,
+		     uint32_t *transaction_id)
+{
+	int err;
+	uint32_t target_long_rd_id;
+
+	if ((hdr == NULL && hdr_len != 0) || (data == NULL && len != 0) || hdr_len + len == 0) {
+		return -EINVAL;
+	}
+	if (hdr_len + len > APP_DLC_PAYLOAD_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+
+	err = resolve_peer(source_mode, long_rd_id, &target_long_rd_id);
+	if (err != 0) {
+		return err;
 	}
 
-	snprintk(tx_buf, sizeof(tx_buf), "%s", text);
-	printk("SEND MESSAGE: target_rd=%u len=%zu data=%s\n", target_long_rd_id, strlen(tx_buf) + 1, tx_buf);
 	pending_tx_transaction_id = tx_transaction_id++;
 
-	err = dect_adapter_dlc_data_send(
-		pending_tx_transaction_id, APP_FLOW_ID,
-		target_long_rd_id, tx_buf, strlen(tx_buf) + 1);
+	err = tx_sched_enqueue(pending_tx_transaction_id, flow_id, target_long_rd_id, port,
+			       hdr, hdr_len, data, len);
 	if (err != 0) {
 		return err;
 	}
 
-	printk("SEND queued: tx=%u\n", pending_tx_transaction_id);
+	if (transaction_id != NULL) {
+		*transaction_id = pending_tx_transaction_id;
+	}
+	LOG_DBG("SEND queued: tx=%u rd=%u flow=%u port=%u len=%zu", pending_tx_transaction_id,
+		target_long_rd_id, flow_id, port, hdr_len + len);
 	return 0;
 }
 
+/* Source mode for SEND: FT talks to its children, anything else to the parent FT. */
+static enum app_mode send_source_mode(void)
+{
+	return current_mode == APP_MODE_FT ? APP_MODE_FT : APP_MODE_PT;
+}
+
+/* PT: payloads for the parent go to the outbox while there is no parent or
+ * older payloads are still waiting in it, so the FT gets them in order. */
+static bool send_to_outbox(uint32_t long_rd_id)
+{
+	bool store;
+
+	if (!outbox_enabled()) {
+		return false;
+	}
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	store = current_mode == APP_MODE_PT &&
+		(long_rd_id == 0 || long_rd_id == pt_parent_long_rd_id) &&
+		(!pt_associated || outbox_count() != 0);
+	k_mutex_unlock(&app_mutex);
+	return store;
+}
+
+int app_dlc_send(const void *data, size_t len)
+{
+	if (send_to_outbox(0)) {
+		return outbox_put(APP_DLC_PORT_DATA, data, len);
+	}
+	return coalesce_send(0, APP_DLC_PORT_DATA, data, len);
+}
+
+int app_dlc_port_send(uint32_t long_rd_id, uint8_t port, const void *data, size_t len,
+		      uint32_t *transaction_id)
+{
+	int err;
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	err = send_data(send_source_mode(), long_rd_id, APP_DLC_FLOW_USER, port, NULL, 0, data,
+			len, transaction_id);
+	k_mutex_unlock(&app_mutex);
+	return err;
+}
+
+int app_dlc_flow_send(uint32_t long_rd_id, uint8_t flow_id, uint8_t port, const void *data,
+		      size_t len, uint32_t *transaction_id)
+{
+	int err;
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	err = send_data(send_source_mode(), long_rd_id, flow_id, port, NULL, 0, data, len,
+			transaction_id);
+	k_mutex_unlock(&app_mutex);
+	return err;
+}
+
+int app_dlc_port_send_hdr(uint32_t long_rd_id, uint8_t port, const void *hdr, size_t hdr_len,
+			  const void *data, size_t len, uint32_t *transaction_id)
+{
+	int err;
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	err = send_data(send_source_mode(), long_rd_id, APP_DLC_FLOW_USER, port, hdr, hdr_len,
+			data, len, transaction_id);
+	k_mutex_unlock(&app_mutex);
+	return err;
+}
+
+int app_dlc_peer_get(uint32_t *long_rd_id)
+{
+	return app_dlc_peer_resolve(0, long_rd_id);
+}
+
+int app_dlc_peer_resolve(uint32_t long_rd_id, uint32_t *peer)
+{
+	int err;
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	err = resolve_peer(send_source_mode(), long_rd_id, peer);
+	k_mutex_unlock(&app_mutex);
+	return err;
+}
+
+int app_dlc_parent_get(uint32_t *long_rd_id)
+{
+	int err = -ENOTCONN;
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	if (current_mode == APP_MODE_PT && pt_associated) {
+		*long_rd_id = pt_parent_long_rd_id;
+		err = 0;
+	}
+	k_mutex_unlock(&app_mutex);
+	return err;
+}
+
+void app_power_state_get(struct power_state *st)
+{
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	st->power_save = power_save_enabled;
+	st->rach_fill_percentage = ft_rach.fill_percentage;
+	st->beacon_period_ms = ft_period_active_ms;
+	if (current_mode == APP_MODE_FT) {
+		st->activity = POWER_ACTIVITY_FT;
+	} else if (current_mode == APP_MODE_PT && pt_associated) {
+		st->activity = POWER_ACTIVITY_PT;
+		st->beacon_period_ms = pt_parent_ft_period_ms;
+	} else if (current_mode == APP_MODE_PT &&
+		   (pt_scan_in_progress || pt_association_pending)) {
+		st->activity = POWER_ACTIVITY_SCAN;
+	} else {
+		st->activity = POWER_ACTIVITY_IDLE;
+	}
+	k_mutex_unlock(&app_mutex);
+}
+
+void app_status_get(struct app_status *st)
+{
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	st->mode = (uint8_t)current_mode;
+	st->device_long_rd_id = device_long_rd_id;
+	st->rach_fill_percentage = ft_rach.fill_percentage;
+	st->power_save = power_save_enabled;
+	st->dlc_rx_dropped = (uint32_t)atomic_get(&dlc_rx_drop_count);
+	st->evt_dropped = (uint32_t)atomic_get(&app_evt_drop_count);
+	st->recoveries = pt_recovery_count;
+	st->associated = false;
+	st->peer_long_rd_id = 0;
+	st->carrier = current_carrier;
+	st->beacon_period_ms = ft_period_active_ms;
+	if (current_mode == APP_MODE_FT) {
+		st->peer_long_rd_id = ft_assoc_latest();
+		st->associated = st->peer_long_rd_id != 0;
+	} else if (current_mode == APP_MODE_PT) {
+		st->associated = pt_associated;
+		st->peer_long_rd_id = pt_parent_long_rd_id;
+		st->carrier = pt_parent_channel;
+		st->beacon_period_ms = pt_parent_ft_period_ms;
+	}
+	k_mutex_unlock(&app_mutex);
+}
+
+void app_dlc_rx_cb_set(app_dlc_rx_cb_t cb)
+{
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	dlc_rx_cb = cb;
+	k_mutex_unlock(&app_mutex);
+}
+
 /* ============================================================================
  * APP EVENT PROCESSING
  * ========================================================================== */
@@ -619,6 +925,12 @@ static void log_status(const char *tag, int status)
 
 static void process_network_beacon_event(const struct app_event *evt)
 {
+	rpc_event_beacon(false, evt->network_beacon.channel, evt->network_beacon.long_rd_id,
+			 evt->network_beacon.network_id,
+			 evt->network_beacon.cluster_beacon_period_ms,
+			 evt->network_beacon.rssi_dbm);
+	chan_db_note_beacon(evt->network_beacon.channel, evt->network_beacon.long_rd_id,
+			    evt->network_beacon.rssi_dbm);
 	if (current_mode == APP_MODE_PT && !pt_associated) {
 		LOG_INF("Network beacon candidate: rd=%u ch=%u nw=%u period=%u ms rssi=%d dBm",
 			evt->network_beacon.long_rd_id, evt->network_beacon.channel,
@@ -632,6 +944,13 @@ static void process_cluster_beacon_event(const struct app_event *evt)
 	if (current_mode != APP_MODE_PT) {
 		return;
 	}
+	rpc_event_beacon(true, evt->cluster_beacon.channel, evt->cluster_beacon.long_rd_id,
+			 evt->cluster_beacon.network_id,
+			 evt->cluster_beacon.cluster_beacon_period_ms,
+			 evt->cluster_beacon.rssi_dbm);
+	telemetry_note_rssi(evt->cluster_beacon.long_rd_id, evt->cluster_beacon.rssi_dbm);
+	chan_db_note_beacon(evt->cluster_beacon.channel, evt->cluster_beacon.long_rd_id,
+			    evt->cluster_beacon.rssi_dbm);
 
 	/* Resync path: cmd_pt did init_mac + network_scan to acquire timing.
 	 * Now that we have a beacon from the target channel, stop the scan
@@ -645,28 +964,31 @@ static void process_cluster_beacon_event(const struct app_event *evt)
 	k_mutex_unlock(&app_mutex);
 
 	if (do_subscribe) {
-		uint32_t period_ms = evt->cluster_beacon.cluster_beacon_period_ms;
-
 		printk("FT found on ch=%u rd=%u — stopping scan and subscribing\n",
 			evt->cluster_beacon.channel, evt->cluster_beacon.long_rd_id);
-		/* stop_pt_activity() blocks until cb_op_network_scan_stop fires the semaphore
-		 * from the modem callback thread — safe to call from the event loop. */
-		stop_pt_activity();
 
 		/* Update state from beacon (fast path launched with unknown rd/nw/period). */
 		k_mutex_lock(&app_mutex, K_FOREVER);
 		pt_parent_long_rd_id   = evt->cluster_beacon.long_rd_id;
 		pt_network_id          = evt->cluster_beacon.network_id;
-		pt_parent_ft_period_ms = period_ms;
+		pt_parent_ft_period_ms = evt->cluster_beacon.cluster_beacon_period_ms;
 		k_mutex_unlock(&app_mutex);
 
-		(void)dect_adapter_cluster_beacon_receive_start(
-			pt_parent_channel, period_ms,
-			evt->cluster_beacon.long_rd_id, evt->cluster_beacon.network_id);
-		k_work_reschedule(&pt_subscribe_timeout_work, K_MSEC(2 * period_ms));
+		/* Stopping the scan waits for the modem lock: not in the event loop. */
+		k_work_reschedule(&pt_subscribe_work, K_NO_WAIT);
 		return;
 	}
 
+	/* The FT may adapt its beacon period; follow it from the parent's beacons. */
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	if (pt_associated && evt->cluster_beacon.long_rd_id == pt_parent_long_rd_id &&
+	    evt->cluster_beacon.cluster_beacon_period_ms != pt_parent_ft_period_ms) {
+		LOG_INF("PT: parent beacon period %u -> %u ms", pt_parent_ft_period_ms,
+			evt->cluster_beacon.cluster_beacon_period_ms);
+		pt_parent_ft_period_ms = evt->cluster_beacon.cluster_beacon_period_ms;
+	}
+	k_mutex_unlock(&app_mutex);
+
 	/* Normal PT_SCAN path: store and print beacon */
 	pt_table_store_beacon(
 		evt->cluster_beacon.channel, evt->cluster_beacon.network_id,
@@ -684,26 +1006,36 @@ static void process_cluster_beacon_event(const struct app_event *evt)
 /* FT side: a PT has associated with us */
 static void process_association_ind_event(const struct app_event *evt)
 {
-	if (evt->association_ind.status == 0) {
-		LOG_INF("process_association_ind_event status=%d rd=%u",
-			evt->association_ind.status, evt->association_ind.long_rd_id);
-	} else {
+	rach_tune_note_assoc(evt->association_ind.status);
+	beacon_adapt_note_assoc();
+	if (evt->association_ind.status != 0) {
 		LOG_ERR("process_association_ind_event status=%d rd=%u",
 			evt->association_ind.status, evt->association_ind.long_rd_id);
+		return;
 	}
-	k_mutex_lock(&app_mutex, K_FOREVER);
-	ft_child_associated = true;
-	ft_child_long_rd_id = evt->association_ind.long_rd_id;
-	k_mutex_unlock(&app_mutex);
+	LOG_INF("process_association_ind_event status=%d rd=%u",
+		evt->association_ind.status, evt->association_ind.long_rd_id);
+	if (ft_assoc_add(evt->association_ind.long_rd_id) != 0) {
+		/* The modem enforces the same limit; only a stale entry gets here. */
+		LOG_WRN("FT association table full (%u PTs), releasing rd=%u",
+			CONFIG_APP_FT_MAX_PTS, evt->association_ind.long_rd_id);
+		(void)dect_adapter_association_release(evt->association_ind.long_rd_id);
+		return;
+	}
+	LOG_INF("FT: %zu/%u PTs associated", ft_assoc_count(), CONFIG_APP_FT_MAX_PTS);
+	compress_peer_up(evt->association_ind.long_rd_id);
+	rpc_event_association(RPC_ASSOC_UP, evt->association_ind.long_rd_id,
+			      evt->association_ind.status);
 }
 
 static void process_association_release_event(const struct app_event *evt)
 {
+	compress_peer_down(evt->association_release.long_rd_id);
+	relay_peer_down(evt->association_release.long_rd_id);
+	tx_sched_peer_flush(evt->association_release.long_rd_id, dlc_tx_flushed);
+	rpc_event_association(RPC_ASSOC_RELEASED, evt->association_release.long_rd_id, 0);
 	k_mutex_lock(&app_mutex, K_FOREVER);
-	if (evt->association_release.long_rd_id == ft_child_long_rd_id) {
-		ft_child_associated = false;
-		ft_child_long_rd_id = 0;
-	}
+	(void)ft_assoc_remove(evt->association_release.long_rd_id);
 	if (evt->association_release.long_rd_id == pt_parent_long_rd_id) {
 		pt_associated = false;
 		pt_association_pending = false;
@@ -720,12 +1052,253 @@ static void process_association_release_event(const struct app_event *evt)
 	k_mutex_unlock(&app_mutex);
 }
 
+/* Print a received payload: as text when it is printable ASCII (a trailing NUL from
+ * older firmware is tolerated), otherwise as hex, 32 bytes per line. */
+static void print_dlc_payload(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	size_t text_len = (len > 0 && data[len - 1] == '\0') ? len - 1 : len;
+	bool printable = true;
+	char hex[2 * 32 + 1];
+
+	for (size_t i = 0; i < text_len; i++) {
+		if (data[i] < 0x20 || data[i] > 0x7e) {
+			printable = false;
+			break;
+		}
+	}
+
+	if (printable) {
+		printk("Received from rd=%u len=%zu: %.*s\n", long_rd_id, len, (int)text_len,
+		       (const char *)data);
+		return;
+	}
+
+	printk("Received from rd=%u len=%zu (hex):\n", long_rd_id, len);
+	for (size_t off = 0; off < len; off += 32) {
+		size_t n = MIN(len - off, (size_t)32);
+
+		bin2hex(&data[off], n, hex, sizeof(hex));
+		printk("  %04zx: %s\n", off, hex);
+	}
+}
+
+static void dispatch_dlc_payload(uint32_t long_rd_id, uint8_t port, const uint8_t *payload,
+				 size_t len);
+
+static void data_port_rx(uint32_t long_rd_id, const uint8_t *payload, size_t len)
+{
+	app_dlc_rx_cb_t cb;
+
+	rpc_event_dlc_rx(long_rd_id, payload, len);
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	cb = dlc_rx_cb;
+	k_mutex_unlock(&app_mutex);
+
+	if (cb != NULL) {
+		cb(long_rd_id, payload, len);
+	} else {
+		print_dlc_payload(long_rd_id, payload, len);
+	}
+}
+
+static void batch_port_rx(uint32_t long_rd_id, const uint8_t *payload, size_t len)
+{
+	coalesce_rx(long_rd_id, payload, len, dispatch_dlc_payload);
+}
+
+static void compressed_port_rx(uint32_t long_rd_id, const uint8_t *payload, size_t len)
+{
+	compress_rx(long_rd_id, payload, len, dispatch_dlc_payload);
+}
+
+static void route_port_rx(uint32_t long_rd_id, const uint8_t *payload, size_t len)
+{
+	relay_rx(long_rd_id, payload, len, dispatch_dlc_payload);
+}
+
+static void seq_port_rx(uint32_t long_rd_id, const uint8_t *payload, size_t len)
+{
+	seqtrack_rx(long_rd_id, payload, len, dispatch_dlc_payload);
+}
+
+/* RX demultiplexer: the port byte indexes a handler table. Built-in services
+ * are fixed at build time; user ports are claimed with app_dlc_port_register(). */
+static const app_dlc_rx_cb_t port_handlers[APP_DLC_PORT_USER] = {
+	[APP_DLC_PORT_DATA] = data_port_rx,
+	[APP_DLC_PORT_PERF] = perf_rx,
+	[APP_DLC_PORT_ECHO] = ping_rx,
+	[APP_DLC_PORT_FRAG] = frag_rx,
+	[APP_DLC_PORT_BATCH] = batch_port_rx,
+	[APP_DLC_PORT_COMPRESSED] = compressed_port_rx,
+	[APP_DLC_PORT_ROUTE] = route_port_rx,
+	[APP_DLC_PORT_SEQ] = seq_port_rx,
+	[APP_DLC_PORT_TIME] = timesync_rx,
+#if defined(CONFIG_APP_DLC_NET)
+	[APP_DLC_PORT_IP] = dlc_net_rx,
+#endif
+};
+static app_dlc_rx_cb_t user_port_handlers[CONFIG_APP_DLC_USER_PORTS];
+static uint32_t port_rx_count[APP_DLC_PORT_USER + CONFIG_APP_DLC_USER_PORTS];
+static uint32_t port_rx_unknown;
+/* Leaf lock for the user port table and the counters; never held across a handler. */
+static struct k_spinlock port_lock;
+/* Port of the payload being dispatched; event loop only. */
+static uint8_t dlc_rx_port;
+
+uint8_t app_dlc_rx_port(void)
+{
+	return dlc_rx_port;
+}
+
+int app_dlc_port_register(uint8_t port, app_dlc_rx_cb_t cb)
+{
+	size_t idx = (size_t)port - APP_DLC_PORT_USER;
+	int err = 0;
+
+	if (port < APP_DLC_PORT_USER || idx >= ARRAY_SIZE(user_port_handlers)) {
+		return -EINVAL;
+	}
+	K_SPINLOCK(&port_lock) {
+		if (cb != NULL && user_port_handlers[idx] != NULL && user_port_handlers[idx] != cb) {
+			err = -EBUSY;
+		} else {
+			user_port_handlers[idx] = cb;
+		}
+	}
+	return err;
+}
+
+/* Hand a payload to the service on its port. Also used for each payload
+ * unwrapped from a batch, a compressed SDU or a routed SDU. */
+static void dispatch_dlc_payload(uint32_t long_rd_id, uint8_t port, const uint8_t *payload,
+				 size_t len)
+{
+	app_dlc_rx_cb_t cb = NULL;
+
+	K_SPINLOCK(&port_lock) {
+		if (port < APP_DLC_PORT_USER) {
+			cb = port_handlers[port];
+		} else if ((size_t)(port - APP_DLC_PORT_USER) < ARRAY_SIZE(user_port_handlers)) {
+			cb = user_port_handlers[port - APP_DLC_PORT_USER];
+		}
+		if (cb != NULL) {
+			port_rx_count[port]++;
+		} else {
+			port_rx_unknown++;
+		}
+	}
+
+	if (cb == NULL) {
+		LOG_WRN("DLC RX from rd=%u: no service on port %u", long_rd_id, port);
+		return;
+	}
+	dlc_rx_port = port;
+	cb(long_rd_id, payload, len);
+}
+
+/* Modem callback time of the SDU being dispatched; event loop only. */
+static int64_t dlc_rx_ticks;
+
+uint64_t app_dlc_rx_time_us(void)
+{
+	return k_ticks_to_us_floor64(dlc_rx_ticks);
+}
+
 static void process_dlc_rx_event(const struct app_event *evt)
 {
-	const char *text = evt->dlc_rx.text;
 	uint32_t long_rd_id = evt->dlc_rx.long_rd_id;
 
-	printk("Received from rd=%u: %s\n", long_rd_id, text);
+	dlc_rx_ticks = evt->dlc_rx.rx_ticks;
+
+	power_note_rx(evt->dlc_rx.len);
+	telemetry_note_rx(long_rd_id, evt->dlc_rx.len);
+	ft_assoc_note_rx(long_rd_id, evt->dlc_rx.len);
+	if (ft_assoc_contains(long_rd_id)) {
+		rach_tune_note_rx();
+		beacon_adapt_note_sdu();
+	}
+	if (evt->dlc_rx.data == NULL) {
+		/* Queued to a DLC endpoint by the RX callback: only counted here. */
+		K_SPINLOCK(&port_lock) {
+			port_rx_count[evt->dlc_rx.port]++;
+		}
+		return;
+	}
+	if (evt->dlc_rx.len <= APP_DLC_PORT_HDR_LEN) {
+		LOG_WRN("DLC RX from rd=%u: SDU too short (%zu)", long_rd_id, evt->dlc_rx.len);
+	} else {
+		dispatch_dlc_payload(long_rd_id, evt->dlc_rx.data[0],
+				     &evt->dlc_rx.data[APP_DLC_PORT_HDR_LEN],
+				     evt->dlc_rx.len - APP_DLC_PORT_HDR_LEN);
+	}
+
+	k_mem_slab_free(&dlc_rx_slab, evt->dlc_rx.data);
+}
+
+/* PT: track consecutive SEND failures (queueing errors and failed TX
+ * completions) and trigger recovery after three. Must be called with app_mutex held. */
+static void pt_note_tx_result(int err)
+{
+	if (current_mode != APP_MODE_PT) {
+		return;
+	}
+	if (err == 0) {
+		pt_dlc_tx_fail_count = 0;
+	} else if (pt_associated) {
+		pt_dlc_tx_fail_count++;
+		if (pt_dlc_tx_fail_count >= 3) {
+			printk("PT: DLC TX failed %u times — triggering recovery\n",
+				pt_dlc_tx_fail_count);
+			pt_dlc_tx_fail_count = 0;
+			pt_associated = false;
+			pt_schedule_fast_recovery("DLC TX repeated failure");
+		}
+	}
+}
+
+/* One DLC TX completion. Runs in the event loop. link_result: the status says
+ * something about the link to the parent (false for SDUs flushed on release). */
+static void dlc_tx_complete(int status, uint32_t transaction_id, bool link_result)
+{
+	uint32_t long_rd_id = tx_sched_tx_done(transaction_id, status);
+
+	outbox_tx_done();
+	if (ft_assoc_contains(long_rd_id)) {
+		beacon_adapt_note_sdu();
+	}
+	if (perf_tx_done(transaction_id, status) || frag_tx_done(transaction_id, status) ||
+	    bcast_tx_done(transaction_id, status)) {
+		return;
+	}
+
+	trace_event(TRACE_DLC_TX_DONE, status, transaction_id, 0);
+	if (!link_result) {
+		return;
+	}
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	/* A relay's TX towards its own PTs says nothing about the upstream link. */
+	if (!ft_assoc_contains(long_rd_id)) {
+		pt_note_tx_result(status);
+	}
+	k_mutex_unlock(&app_mutex);
+
+	if (status != 0) {
+		LOG_WRN("TX failed: tx=%u status=%d", transaction_id, status);
+	}
+}
+
+/* An SDU dropped by tx_sched_peer_flush() when its peer went away: release
+ * it upstream, but do not count it against the link, which the release path
+ * handles (a PT would otherwise start a second recovery). */
+static void dlc_tx_flushed(int status, uint32_t transaction_id)
+{
+	dlc_tx_complete(status, transaction_id, false);
+}
+
+static void process_dlc_tx_event(const struct app_event *evt)
+{
+	dlc_tx_complete(evt->dlc_tx.status, evt->dlc_tx.transaction_id, true);
 }
 
 static void process_op_network_scan_event(const struct app_event *evt)
@@ -801,10 +1374,19 @@ static void process_ntf_association_event(const struct app_event *evt)
 		pt_recovery_attempts = 0;
 		pt_dlc_tx_fail_count = 0;
 		pt_parent_long_rd_id = long_rd_id;
+		if (relay_channel != 0 && !relay_cluster_up) {
+			k_work_reschedule(&relay_cluster_work, K_NO_WAIT);
+		}
 		k_mutex_unlock(&app_mutex);
 		printk("PT associated with FT rd=%u\n", long_rd_id);
+		compress_peer_up(long_rd_id);
+		outbox_link_up();
+		timesync_link_up();
+		dlc_net_parent_set(long_rd_id);
+		rpc_event_association(RPC_ASSOC_UP, long_rd_id, status);
 	} else {
 		LOG_ERR("cb_ntf_association status=%d rd=%u", status, long_rd_id);
+		rpc_event_association(RPC_ASSOC_FAILED, long_rd_id, status);
 		k_mutex_lock(&app_mutex, K_FOREVER);
 		pt_association_pending = false;
 
@@ -851,6 +1433,9 @@ static void process_app_event(const struct app_event *evt)
 	case APP_EVT_DLC_RX:
 		process_dlc_rx_event(evt);
 		break;
+	case APP_EVT_DLC_TX:
+		process_dlc_tx_event(evt);
+		break;
 	case APP_EVT_OP_NETWORK_SCAN:
 		process_op_network_scan_event(evt);
 		break;
@@ -882,14 +1467,14 @@ static void led_work_handler(struct k_work *work)
 	ARG_UNUSED(work);
 	if (current_mode == APP_MODE_PT) {
 		on = !on;
-		dk_set_leds(on ? DK_ALL_LEDS_MSK : 0);
+		leds_set(on);
 		k_work_reschedule(&led_work, K_MSEC(300));
 	} else if (current_mode == APP_MODE_FT) {
 		on = true;
-		dk_set_leds(DK_ALL_LEDS_MSK);
+		leds_set(true);
 	} else {
 		on = false;
-		dk_set_leds(0);
+		leds_set(false);
 	}
 }
 
@@ -909,12 +1494,242 @@ static void pt_associate_work_handler(struct k_work *work)
 	k_mutex_unlock(&app_mutex);
 }
 
+/* RELAY: once associated upstream, start the downstream cluster. Blocks on
+ * the configure operations, so it runs here rather than in the event loop. */
+static void relay_cluster_work_handler(struct k_work *work)
+{
+	uint16_t channel;
+	int err;
+
+	ARG_UNUSED(work);
+
+	/* Held from the state check through the cluster start, so a mode change
+	 * from the shell cannot slip in between. */
+	k_mutex_lock(&modem_op_mutex, K_FOREVER);
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	channel = (current_mode == APP_MODE_PT && pt_associated) ? relay_channel : 0;
+	ft_period_active_ms = ft_period_ms;
+	k_mutex_unlock(&app_mutex);
+	if (channel == 0) {
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+
+	err = cluster_start(channel);
+	k_mutex_unlock(&modem_op_mutex);
+	if (err != 0) {
+		LOG_ERR("RELAY: downstream cluster on ch=%u failed: %d", channel, err);
+		return;
+	}
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	relay_cluster_up = true;
+	k_mutex_unlock(&app_mutex);
+	k_work_reschedule(&rach_tune_work, K_MSEC(CONFIG_APP_RACH_TUNE_INTERVAL_MS));
+	k_work_reschedule(&beacon_adapt_work, K_MSEC(CONFIG_APP_BEACON_ADAPT_INTERVAL_MS));
+	relay_start();
+	printk("RELAY: beaconing for PTs on ch=%u\n", channel);
+}
+
+/* Carrier of the cluster this device beacons: the FT's, or the downstream
+ * side of a relay; 0 if none. Must be called with app_mutex held. */
+static uint16_t cluster_carrier_locked(void)
+{
+	if (current_mode == APP_MODE_FT) {
+		return current_carrier;
+	}
+	if (current_mode == APP_MODE_PT && relay_cluster_up) {
+		return relay_channel;
+	}
+	return 0;
+}
+
+/* RACH tuning: resize the RACH of the running cluster (FT, or the downstream
+ * side of a relay) to the observed demand. The new parameters are applied by
+ * reconfiguring the cluster in place, which keeps the associations. */
+static void rach_tune_work_handler(struct k_work *work)
+{
+	struct dect_adapter_rach_params prev, next;
+	uint16_t carrier;
+	bool apply;
+	int err;
+
+	ARG_UNUSED(work);
+
+	/* The modem lock is held from the step through the reconfigure, so the
+	 * shell cannot reconfigure the cluster in between. If another operation
+	 * owns the modem, try again next interval instead of blocking the
+	 * workqueue. */
+	if (k_mutex_lock(&modem_op_mutex, K_NO_WAIT) != 0) {
+		k_work_reschedule(&rach_tune_work, K_MSEC(CONFIG_APP_RACH_TUNE_INTERVAL_MS));
+		return;
+	}
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	carrier = cluster_carrier_locked();
+	if (carrier == 0) {
+		k_mutex_unlock(&app_mutex);
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+	prev = ft_rach;
+	apply = rach_tune_step(ft_assoc_count(), ft_rach_ceiling, &ft_rach, &next) &&
+		rach_tune_enabled();
+	if (apply) {
+		ft_rach = next;
+	}
+	k_mutex_unlock(&app_mutex);
+	k_work_reschedule(&rach_tune_work, K_MSEC(CONFIG_APP_RACH_TUNE_INTERVAL_MS));
+	if (!apply) {
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+
+	LOG_INF("RACH tune: fill %u%% -> %u%%, cw %u..%u -> %u..%u", prev.fill_percentage,
+		next.fill_percentage, prev.cw_min_sig, prev.cw_max_sig, next.cw_min_sig,
+		next.cw_max_sig);
+	err = cluster_start(carrier);
+	if (err != 0) {
+		/* Do not retry every interval against a modem that refuses. */
+		LOG_ERR("RACH tune: cluster reconfigure failed: %d, back to manual", err);
+		rach_tune_enable(false);
+		k_mutex_lock(&app_mutex, K_FOREVER);
+		ft_rach = prev;
+		k_mutex_unlock(&app_mutex);
+	}
+	k_mutex_unlock(&modem_op_mutex);
+}
+
+/* Beacon adaptation: shorten the cluster beacon period under load, lengthen
+ * it again when quiet. Reconfigures the running cluster in place; PTs pick
+ * the new period up from the next beacon. */
+static void beacon_adapt_work_handler(struct k_work *work)
+{
+	uint32_t prev, next;
+	uint16_t carrier;
+	bool apply;
+	int err;
+
+	ARG_UNUSED(work);
+
+	/* Held through the reconfigure, as in rach_tune_work_handler(). */
+	if (k_mutex_lock(&modem_op_mutex, K_NO_WAIT) != 0) {
+		k_work_reschedule(&beacon_adapt_work, K_MSEC(CONFIG_APP_BEACON_ADAPT_INTERVAL_MS));
+		return;
+	}
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	carrier = cluster_carrier_locked();
+	if (carrier == 0) {
+		k_mutex_unlock(&app_mutex);
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+	prev = ft_period_active_ms;
+	apply = beacon_adapt_step(prev, ft_period_ms, &next);
+	if (!beacon_adapt_enabled()) {
+		/* Switched off: settle on the PERIOD value. */
+		next = ft_period_ms;
+		apply = (next != prev);
+	}
+	if (apply) {
+		ft_period_active_ms = next;
+	}
+	k_mutex_unlock(&app_mutex);
+	k_work_reschedule(&beacon_adapt_work, K_MSEC(CONFIG_APP_BEACON_ADAPT_INTERVAL_MS));
+	if (!apply) {
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+
+	LOG_INF("Beacon adapt: cluster period %u -> %u ms", prev, next);
+	err = cluster_start(carrier);
+	if (err != 0) {
+		/* Do not retry every interval against a modem that refuses. */
+		LOG_ERR("Beacon adapt: cluster reconfigure failed: %d, adaptation off", err);
+		beacon_adapt_enable(false);
+		k_mutex_lock(&app_mutex, K_FOREVER);
+		ft_period_active_ms = prev;
+		k_mutex_unlock(&app_mutex);
+	}
+	k_mutex_unlock(&modem_op_mutex);
+}
+
+/* Spectrum monitor: one short RSSI sample of the own or an alternative
+ * carrier between cluster duties, folded into the channel history. A sample
+ * is skipped while another modem operation (e.g. a shell SCAN) runs. */
+static void spectrum_work_handler(struct k_work *work)
+{
+	uint16_t carrier, channel;
+	int err;
+
+	ARG_UNUSED(work);
+
+	if (k_mutex_lock(&modem_op_mutex, K_NO_WAIT) != 0) {
+		k_work_reschedule(&spectrum_work, K_MSEC(CONFIG_APP_SPECTRUM_INTERVAL_MS));
+		return;
+	}
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	carrier = (current_mode == APP_MODE_FT) ? current_carrier : 0;
+	k_mutex_unlock(&app_mutex);
+	if (carrier == 0) {
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+	k_work_reschedule(&spectrum_work, K_MSEC(CONFIG_APP_SPECTRUM_INTERVAL_MS));
+	if (!spectrum_enabled()) {
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+
+	channel = spectrum_next_channel(carrier);
+	/* Nested in modem_op_mutex; released again by the wait or cancel. */
+	prepare_wait(WAIT_RSSI_SCAN);
+	err = dect_adapter_rssi_scan_channel_start(channel, SPECTRUM_SCAN_FRAMES,
+						   scan_threshold_min, scan_threshold_max);
+	if (err != 0) {
+		cancel_wait(WAIT_RSSI_SCAN);
+	} else {
+		err = wait_for_prepared_operation(WAIT_RSSI_SCAN, K_SECONDS(2));
+	}
+	k_mutex_unlock(&modem_op_mutex);
+	spectrum_note_scan(channel, carrier, err);
+}
+
 /* Kept for k_work_cancel_delayable() in stop_pt_activity(). */
 static void pt_scan_work_handler(struct k_work *work)
 {
 	ARG_UNUSED(work);
 }
 
+/* Resync path, after the first beacon from the target FT: stop the network
+ * scan and subscribe to the FT's cluster beacons. */
+static void pt_subscribe_work_handler(struct k_work *work)
+{
+	uint32_t rd_id, nw_id, period_ms;
+	uint16_t channel;
+
+	ARG_UNUSED(work);
+
+	/* Held through the subscribe, so no shell operation runs in between. */
+	k_mutex_lock(&modem_op_mutex, K_FOREVER);
+	(void)stop_pt_activity();
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	if (current_mode != APP_MODE_PT || pt_parent_long_rd_id == 0) {
+		/* Stopped or restarted meanwhile. */
+		k_mutex_unlock(&app_mutex);
+		k_mutex_unlock(&modem_op_mutex);
+		return;
+	}
+	channel   = pt_parent_channel;
+	rd_id     = pt_parent_long_rd_id;
+	nw_id     = pt_network_id;
+	period_ms = pt_parent_ft_period_ms;
+	k_mutex_unlock(&app_mutex);
+
+	(void)dect_adapter_cluster_beacon_receive_start(channel, period_ms, rd_id, nw_id);
+	k_mutex_unlock(&modem_op_mutex);
+	k_work_reschedule(&pt_subscribe_timeout_work, K_MSEC(2 * period_ms));
+}
+
 static void pt_resubscribe_work_handler(struct k_work *work)
 {
 	ARG_UNUSED(work);
@@ -967,6 +1782,7 @@ static void pt_schedule_fast_recovery(const char *reason)
 		return;
 	}
 	pt_recovery_attempts++;
+	pt_recovery_count++;
 	printk("PT: auto-recovery %u/5 on ch=%u (%s)\n",
 		pt_recovery_attempts, pt_parent_channel, reason);
 	k_work_reschedule(&pt_recovery_work, K_MSEC(100));
@@ -1043,25 +1859,21 @@ static void pt_recovery_work_handler(struct k_work *work)
 
 static void cb_op_functional_mode(int status)
 {
-	log_status("cb_op_functional_mode", status);
 	complete_wait(WAIT_FUNCTIONAL, status);
 }
 
 static void cb_op_configure(int status)
 {
-	log_status("cb_op_configure", status);
 	complete_wait(WAIT_CONFIGURE, status);
 }
 
 static void cb_op_systemmode(int status)
 {
-	log_status("cb_op_systemmode", status);
 	complete_wait(WAIT_SYSTEMMODE, status);
 }
 
 static void cb_op_cluster_configure(int status)
 {
-	log_status("cb_op_cluster_configure", status);
 	complete_wait(WAIT_CLUSTER_CONFIGURE, status);
 }
 
@@ -1089,7 +1901,6 @@ static void cb_op_cluster_beacon_receive_stop(int status)
 
 static void cb_op_network_beacon_configure(int status)
 {
-	log_status("cb_op_network_beacon_configure", status);
 	complete_wait(WAIT_NETWORK_BEACON_CONFIGURE, status);
 }
 
@@ -1116,17 +1927,17 @@ static void cb_op_network_scan_stop(int status)
 
 static void cb_op_rssi_scan(int status)
 {
-	log_status("cb_op_rssi_scan", status);
 	complete_wait(WAIT_RSSI_SCAN, status);
 }
 
 static void cb_op_dlc_data_tx(int status, uint32_t transaction_id)
 {
-	if (status == 0) {
-		LOG_INF("TX done: tx=%u", transaction_id);
-	} else {
-		LOG_WRN("TX failed: tx=%u status=%d", transaction_id, status);
-	}
+	struct app_event evt = {
+		.type = APP_EVT_DLC_TX,
+		.dlc_tx = { .status = status, .transaction_id = transaction_id },
+	};
+
+	app_event_put(&evt);
 }
 
 /* PT side: our association with FT completed */
@@ -1137,12 +1948,12 @@ static void cb_ntf_association(int status, uint32_t long_rd_id)
 		.ntf_association = { .status = status, .long_rd_id = long_rd_id },
 	};
 
+	trace_event(TRACE_ASSOC, status, long_rd_id, 0);
 	app_event_put(&evt);
 }
 
 static void cb_ntf_association_release(uint32_t long_rd_id)
 {
-	LOG_WRN("association_release: rd=%u\n", long_rd_id);
 	struct app_event evt = {
 		.type = APP_EVT_ASSOCIATION_RELEASE,
 		.association_release = {
@@ -1150,17 +1961,13 @@ static void cb_ntf_association_release(uint32_t long_rd_id)
 		},
 	};
 
+	trace_event(TRACE_ASSOC_RELEASE, 0, long_rd_id, 0);
 	app_event_put(&evt);
 }
 
 /* FT side: a PT has associated with us */
 static void cb_ntf_association_ind(int status, uint32_t long_rd_id)
 {
-	if (status == 0) {
-		LOG_INF("cb_ntf_association_ind status=%d rd=%u", status, long_rd_id);
-	} else {
-		LOG_ERR("cb_ntf_association_ind status=%d rd=%u", status, long_rd_id);
-	}
 	struct app_event evt = {
 		.type = APP_EVT_ASSOCIATION_IND,
 		.association_ind = {
@@ -1168,6 +1975,8 @@ static void cb_ntf_association_ind(int status, uint32_t long_rd_id)
 			.long_rd_id = long_rd_id,
 		},
 	};
+
+	trace_event(TRACE_ASSOC_IND, status, long_rd_id, 0);
 	app_event_put(&evt);
 }
 
@@ -1178,13 +1987,9 @@ static void cb_ntf_rssi_scan(uint16_t channel, uint8_t busy_percentage,
 	if (channel % 2 == 0) {
 		return;
 	}
-	LOG_INF("  ch=%u busy=%u%% free=%zu possible=%zu/%zu slots", channel, busy_percentage,
-		free_slots, possible_slots, total_slots);
-	if (!ft_scan_result_valid || busy_percentage < ft_scan_best_busy) {
-		ft_scan_result_valid = true;
-		ft_scan_best_channel = channel;
-		ft_scan_best_busy = busy_percentage;
-	}
+	trace_event(TRACE_RSSI_SCAN, busy_percentage, channel, free_slots);
+	chan_db_note_scan(channel, busy_percentage, free_slots, possible_slots, total_slots);
+	ft_scan_result_valid = true;
 }
 
 static void cb_ntf_cluster_beacon(uint16_t channel, uint32_t network_id, uint32_t long_rd_id,
@@ -1223,23 +2028,45 @@ static void cb_ntf_network_beacon(uint16_t channel, uint32_t network_id, uint32_
 
 static void cb_ntf_dlc_data_rx(uint32_t long_rd_id, const void *data, size_t data_len)
 {
+	void *buf;
 	struct app_event evt = {
 		.type = APP_EVT_DLC_RX,
 		.dlc_rx = {
 			.long_rd_id = long_rd_id,
-			.len = MIN(data_len, (size_t)APP_DATA_LEN_MAX),
+			.len = data_len,
+			.rx_ticks = k_uptime_ticks(),
 		},
 	};
 
-	memcpy(evt.dlc_rx.text, data, evt.dlc_rx.len);
-	evt.dlc_rx.text[evt.dlc_rx.len] = '\0';
-	printk("DLC RX ntf: rd=%u len=%zu data=%s\n", long_rd_id, data_len, evt.dlc_rx.text);
-	app_event_put(&evt);
+	/* Plain SDUs for an open endpoint skip the event loop's copy and dispatch. */
+	if (data_len != 0 && data_len <= APP_DLC_SDU_LEN_MAX &&
+	    dlc_ep_rx_direct(long_rd_id, data, data_len)) {
+		evt.dlc_rx.port = *(const uint8_t *)data;
+		trace_event(TRACE_DLC_RX, (int16_t)data_len, long_rd_id, 0);
+		(void)app_event_put(&evt);
+		return;
+	}
+
+	if (data_len == 0 || data_len > APP_DLC_SDU_LEN_MAX ||
+	    k_mem_slab_alloc(&dlc_rx_slab, &buf, K_NO_WAIT) != 0) {
+		trace_event(TRACE_DLC_RX_DROP, (int16_t)data_len, long_rd_id,
+			    (uint32_t)atomic_inc(&dlc_rx_drop_count) + 1);
+		return;
+	}
+
+	memcpy(buf, data, data_len);
+	evt.dlc_rx.data = buf;
+	trace_event(TRACE_DLC_RX, (int16_t)data_len, long_rd_id, 0);
+	if (app_event_put(&evt) != 0) {
+		trace_event(TRACE_DLC_RX_DROP, (int16_t)data_len, long_rd_id,
+			    (uint32_t)atomic_inc(&dlc_rx_drop_count) + 1);
+		k_mem_slab_free(&dlc_rx_slab, buf);
+	}
 }
 
 static void cb_ntf_cluster_beacon_rx_failure(uint32_t long_rd_id)
 {
-	LOG_WRN("cluster_beacon_rx_failure: rd=%u — releasing and resubscribing", long_rd_id);
+	trace_event(TRACE_BEACON_RX_FAILURE, 0, long_rd_id, 0);
 	k_mutex_lock(&app_mutex, K_FOREVER);
 	pt_associated = false;
 	pt_association_pending = false;
@@ -1278,74 +2105,332 @@ static const struct dect_adapter_ntf_callbacks app_ntf_callbacks = {
  * SHELL COMMANDS
  * ========================================================================== */
 
-static int cmd_send(const struct shell *shell, size_t argc, char **argv)
+/* Shell TX buffer. Commands run on the shell thread and, through RPC EXEC,
+ * on the RPC thread, so the SEND commands hold shell_tx_mutex while they use
+ * it and their static text buffers. */
+static uint8_t shell_tx_buf[APP_DLC_PAYLOAD_LEN_MAX];
+static K_MUTEX_DEFINE(shell_tx_mutex);
+
+/* Join argv[1..] into buf: separated by sep (0 = no separator). Returns length or -EMSGSIZE. */
+static int join_args(size_t argc, char **argv, char sep, char *buf, size_t size)
 {
-	int err;
-	char text[APP_DATA_LEN_MAX + 1];
 	size_t pos = 0;
-	enum app_mode source_mode;
 
 	for (size_t i = 1; i < argc; i++) {
-		int written = snprintk(text + pos, sizeof(text) - pos, "%s%s",
-				       i > 1 ? " " : "", argv[i]);
-		if (written < 0 || written >= (int)(sizeof(text) - pos)) {
-			shell_error(shell, "Message too long");
-			return -EINVAL;
+		size_t n = strlen(argv[i]);
+
+		if (i > 1 && sep != 0) {
+			if (pos >= size) {
+				return -EMSGSIZE;
+			}
+			buf[pos++] = sep;
+		}
+		if (n > size - pos) {
+			return -EMSGSIZE;
 		}
-		pos += written;
+		memcpy(&buf[pos], argv[i], n);
+		pos += n;
 	}
+	return (int)pos;
+}
 
-	k_mutex_lock(&app_mutex, K_FOREVER);
-	source_mode = current_mode == APP_MODE_FT ? APP_MODE_FT : APP_MODE_PT;
-	err = send_ascii(source_mode, text);
-	if (source_mode == APP_MODE_PT) {
-		if (err == 0) {
-			pt_dlc_tx_fail_count = 0;
-		} else if (pt_associated) {
-			pt_dlc_tx_fail_count++;
-			if (pt_dlc_tx_fail_count >= 3) {
-				printk("PT: DLC TX failed %u times — triggering recovery\n",
-					pt_dlc_tx_fail_count);
-				pt_dlc_tx_fail_count = 0;
-				pt_associated = false;
-				pt_schedule_fast_recovery("DLC TX repeated failure");
-			}
+/* Destination of SEND/SENDHEX/SENDB64: an optional first argument @<rd> picks
+ * one peer (multi-hop through relays if it is not a neighbour), @ALL every PT
+ * associated with this FT, @ROOT the FT at the top of a relay tree. */
+struct send_target {
+	uint32_t long_rd_id; /* 0 = the associated peer */
+	bool all;
+	bool root;
+};
+
+/* Returns the number of arguments the target took (0 or 1), or -EINVAL. */
+static int parse_send_target(const struct shell *shell, size_t argc, char **argv,
+			     struct send_target *target)
+{
+	char *end;
+	unsigned long rd;
+
+	target->long_rd_id = 0;
+	target->all = false;
+	target->root = false;
+	if (argc < 3 || argv[1][0] != '@') {
+		return 0;
+	}
+	if (strcmp(&argv[1][1], "ALL") == 0 || strcmp(&argv[1][1], "all") == 0) {
+		target->all = true;
+		return 1;
+	}
+	if (strcmp(&argv[1][1], "ROOT") == 0 || strcmp(&argv[1][1], "root") == 0) {
+		target->root = true;
+		return 1;
+	}
+	rd = strtoul(&argv[1][1], &end, 10);
+	if (end == &argv[1][1] || *end != '\0' || rd == 0 || rd > UINT32_MAX) {
+		shell_error(shell, "Destination must be @<long RD ID>, @ALL or @ROOT");
+		return -EINVAL;
+	}
+	target->long_rd_id = (uint32_t)rd;
+	return 1;
+}
+
+/* Send through the relay tree to a device that is not a neighbour. */
+static int shell_send_routed(const struct shell *shell, uint32_t long_rd_id,
+			     const uint8_t *data, size_t len)
+{
+	int err = relay_send(long_rd_id, APP_DLC_PORT_DATA, data, len);
+
+	if (err != 0) {
+		shell_error(shell, "SEND failed: %d", err);
+		return err;
+	}
+	if (long_rd_id != 0) {
+		shell_print(shell, "Routed to rd=%u: %zu bytes", long_rd_id, len);
+	} else {
+		shell_print(shell, "Routed to root: %zu bytes", len);
+	}
+	return 0;
+}
+
+/* Send to one peer and maintain the PT TX failure counter. */
+static int shell_send_one(const struct shell *shell, uint32_t long_rd_id, const uint8_t *data,
+			  size_t len)
+{
+	int err;
+	enum app_mode source_mode;
+	uint32_t transaction_id = 0;
+	uint32_t peer;
+
+	if (send_to_outbox(long_rd_id)) {
+		err = outbox_put(APP_DLC_PORT_DATA, data, len);
+		if (err != 0) {
+			shell_error(shell, "SEND failed: %d", err);
+			return err;
+		}
+		shell_print(shell, "Stored for the parent FT: %zu bytes (%zu waiting, see OUTBOX)",
+			    len, outbox_count());
+		return 0;
+	}
+
+	if (long_rd_id != 0 && app_dlc_peer_resolve(long_rd_id, &peer) != 0) {
+		return shell_send_routed(shell, long_rd_id, data, len);
+	}
+
+	if (coalesce_enabled()) {
+		/* Queued for a batch SDU; TX failures show up in COALESCE stats. */
+		err = coalesce_send(long_rd_id, APP_DLC_PORT_DATA, data, len);
+		if (err != 0) {
+			shell_error(shell, "SEND failed: %d", err);
+			return err;
 		}
+		shell_print(shell, "Queued: %zu bytes (coalescing)", len);
+		return 0;
 	}
+
+	/* compress_send() takes app_mutex itself; it must not be held here. */
+	err = compress_send(long_rd_id, APP_DLC_PORT_DATA, data, len, &transaction_id);
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	source_mode = send_source_mode();
+	pt_note_tx_result(err);
 	k_mutex_unlock(&app_mutex);
 	if (err != 0) {
 		shell_error(shell, "SEND failed: %d", err);
 		return err;
 	}
 
-	shell_print(shell, "Sent from %s: %s", mode_name(source_mode), text);
+	if (long_rd_id != 0) {
+		shell_print(shell, "Sent from %s to rd=%u: %zu bytes (tx=%u)",
+			    mode_name(source_mode), long_rd_id, len, transaction_id);
+	} else {
+		shell_print(shell, "Sent from %s: %zu bytes (tx=%u)", mode_name(source_mode), len,
+			    transaction_id);
+	}
+	return 0;
+}
+
+/* Common tail of SEND/SENDHEX/SENDB64. */
+static int shell_send(const struct shell *shell, const struct send_target *target,
+		      const uint8_t *data, size_t len)
+{
+	int err;
+
+	if (target->root) {
+		return shell_send_routed(shell, 0, data, len);
+	}
+	if (!target->all) {
+		return shell_send_one(shell, target->long_rd_id, data, len);
+	}
+
+	err = bcast_send(APP_DLC_PORT_DATA, data, len);
+	if (err == -ENOTCONN) {
+		shell_error(shell, "SEND failed: no PT associated");
+		return err;
+	}
+	if (err != 0) {
+		shell_error(shell, "SEND failed: %d%s", err,
+			    err == -EBUSY ? " (group send in progress, see BCAST)" : "");
+		return err;
+	}
+	shell_print(shell, "Group send of %zu bytes to %zu PTs started (BCAST shows progress)",
+		    len, ft_assoc_count());
 	return 0;
 }
 
+static int cmd_send(const struct shell *shell, size_t argc, char **argv)
+{
+	struct send_target target;
+	int skip = parse_send_target(shell, argc, argv, &target);
+	int len;
+	int err;
+
+	if (skip < 0) {
+		return skip;
+	}
+	k_mutex_lock(&shell_tx_mutex, K_FOREVER);
+	len = join_args(argc - skip, argv + skip, ' ', (char *)shell_tx_buf, sizeof(shell_tx_buf));
+
+	if (len < 0) {
+		k_mutex_unlock(&shell_tx_mutex);
+		shell_error(shell, "Message too long (max %u bytes)", APP_DLC_PAYLOAD_LEN_MAX);
+		return len;
+	}
+
+	err = shell_send(shell, &target, shell_tx_buf, (size_t)len);
+	k_mutex_unlock(&shell_tx_mutex);
+	return err;
+}
+
+/* SENDHEX <hex> — hex digits may be split over several arguments. */
+static int cmd_sendhex(const struct shell *shell, size_t argc, char **argv)
+{
+	static char hex[2 * APP_DLC_PAYLOAD_LEN_MAX];
+	struct send_target target;
+	int skip = parse_send_target(shell, argc, argv, &target);
+	int hex_len;
+	size_t len;
+	int err;
+
+	if (skip < 0) {
+		return skip;
+	}
+	k_mutex_lock(&shell_tx_mutex, K_FOREVER);
+	hex_len = join_args(argc - skip, argv + skip, 0, hex, sizeof(hex));
+	if (hex_len < 0) {
+		shell_error(shell, "Payload too long (max %u bytes)", APP_DLC_PAYLOAD_LEN_MAX);
+		err = hex_len;
+	} else if (hex_len == 0 || (hex_len % 2) != 0) {
+		shell_error(shell, "SENDHEX needs an even number of hex digits");
+		err = -EINVAL;
+	} else {
+		len = hex2bin(hex, (size_t)hex_len, shell_tx_buf, sizeof(shell_tx_buf));
+		if (len != (size_t)hex_len / 2) {
+			shell_error(shell, "Invalid hex string");
+			err = -EINVAL;
+		} else {
+			err = shell_send(shell, &target, shell_tx_buf, len);
+		}
+	}
+	k_mutex_unlock(&shell_tx_mutex);
+	return err;
+}
+
+/* SENDB64 <base64> — standard alphabet with padding. */
+static int cmd_sendb64(const struct shell *shell, size_t argc, char **argv)
+{
+	static char b64[4 * DIV_ROUND_UP(APP_DLC_PAYLOAD_LEN_MAX, 3)];
+	struct send_target target;
+	int skip = parse_send_target(shell, argc, argv, &target);
+	int b64_len;
+	size_t len;
+	int err;
+
+	if (skip < 0) {
+		return skip;
+	}
+	k_mutex_lock(&shell_tx_mutex, K_FOREVER);
+	b64_len = join_args(argc - skip, argv + skip, 0, b64, sizeof(b64));
+	if (b64_len < 0) {
+		shell_error(shell, "Payload too long (max %u bytes)", APP_DLC_PAYLOAD_LEN_MAX);
+		err = b64_len;
+	} else if (base64_decode(shell_tx_buf, sizeof(shell_tx_buf), &len,
+				 (const uint8_t *)b64, (size_t)b64_len) != 0 || len == 0) {
+		shell_error(shell, "Invalid base64 string");
+		err = -EINVAL;
+	} else {
+		err = shell_send(shell, &target, shell_tx_buf, len);
+	}
+	k_mutex_unlock(&shell_tx_mutex);
+	return err;
+}
+
+static void scan_print_ranked(const struct shell *shell)
+{
+	struct chan_db_entry ranked[CONFIG_APP_CHAN_DB_SIZE];
+	size_t n = chan_db_rank(ranked, ARRAY_SIZE(ranked));
+
+	shell_print(shell, "Rank  ch    score  busy avg+-sd  last  free  poss  scans  age s  FT heard");
+	for (size_t i = 0; i < n; i++) {
+		const struct chan_db_entry *e = &ranked[i];
+		char ft[32] = "-";
+
+		if (e->ft_long_rd_id != 0) {
+			snprintf(ft, sizeof(ft), "rd=%u %d dBm %us ago", e->ft_long_rd_id,
+				 e->ft_rssi_dbm, e->ft_age_ms / 1000U);
+		}
+		if (e->samples == 0) {
+			shell_print(shell, "  -   %-5u     -             -     -     -     -      0      -  %s",
+				    e->channel, ft);
+			continue;
+		}
+		shell_print(shell, "%4zu  %-5u %5u.%u  %3u.%u+-%2u.%u  %3u%%  %3u%%  %3u%%  %5u  %5u  %s",
+			    i + 1, e->channel, e->score / 10U, e->score % 10U,
+			    e->busy_avg_x10 / 10U, e->busy_avg_x10 % 10U,
+			    e->busy_sd_x10 / 10U, e->busy_sd_x10 % 10U, e->busy_last,
+			    e->free_x10 / 10U, e->possible_x10 / 10U, e->samples,
+			    e->age_ms / 1000U, ft);
+	}
+}
+
+/* SCAN [passes|CLEAR] — RSSI scan the band, fold the results into the
+ * channel history and print the channels ranked by score. */
 static int cmd_scan(const struct shell *shell, size_t argc, char **argv)
 {
+	long passes = 1;
 	int err;
 
-	ARG_UNUSED(argc);
-	ARG_UNUSED(argv);
+	if (argc >= 2) {
+		if (strcmp(argv[1], "CLEAR") == 0 || strcmp(argv[1], "clear") == 0) {
+			chan_db_clear();
+			shell_print(shell, "Channel history cleared");
+			return 0;
+		}
+		passes = strtol(argv[1], NULL, 10);
+		if (passes < 1 || passes > 20) {
+			shell_error(shell, "SCAN passes must be between 1 and 20");
+			return -EINVAL;
+		}
+	}
 
 	if (!app_ready) {
 		shell_error(shell, "Device not ready");
 		return -ENODEV;
 	}
 
-	err = run_rssi_scan();
-	if (err != 0) {
-		shell_error(shell, "RSSI scan failed: %d", err);
-		return err;
+	for (long i = 0; i < passes; i++) {
+		err = run_rssi_scan();
+		if (err != 0) {
+			shell_error(shell, "RSSI scan failed: %d", err);
+			return err;
+		}
 	}
 
+	scan_print_ranked(shell);
 	if (ft_scan_result_valid) {
 		if (use_fixed_channel) {
-			shell_print(shell, "Best channel: %u (busy=%u%%) [fixed channel %u active, informational only]",
+			shell_print(shell, "Best channel: %u (avg busy=%u%%) [fixed channel %u active, informational only]",
 				    ft_scan_best_channel, ft_scan_best_busy, current_carrier);
 		} else {
-			shell_print(shell, "Best channel: %u (busy=%u%%) -> use FT %u to beacon",
+			shell_print(shell, "Best channel: %u (avg busy=%u%%) -> use FT %u to beacon",
 				    ft_scan_best_channel, ft_scan_best_busy, ft_scan_best_channel);
 		}
 	} else {
@@ -1374,6 +2459,9 @@ static int cmd_ft(const struct shell *shell, size_t argc, char **argv)
 		shell_print(shell, "FT: using current_carrier %u (run SCAN to update)", current_carrier);
 	}
 
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	relay_channel = 0;
+	k_mutex_unlock(&app_mutex);
 	err = configure_ft();
 	if (err != 0) {
 		shell_error(shell, "FT failed: %d", err);
@@ -1436,9 +2524,7 @@ static int cmd_pt_scan(const struct shell *shell, size_t argc, char **argv)
 		channel = (uint16_t)ch;
 	}
 
-	k_mutex_lock(&app_mutex, K_FOREVER);
 	err = start_pt_scan_mode(channel);
-	k_mutex_unlock(&app_mutex);
 
 	if (err != 0) {
 		shell_error(shell, "PT_SCAN failed: %d", err);
@@ -1454,29 +2540,15 @@ static int cmd_pt_scan(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
-/* PT <channel> — associate with FT on <channel>.
+/* Associate with the FT on <channel>.
  * Fast path (no prior PT_SCAN): init_mac + network_scan to find the FT, then
  * auto-subscribe and associate.
  * Slow path (after PT_SCAN): uses stored beacon table values to subscribe directly. */
-static int cmd_pt(const struct shell *shell, size_t argc, char **argv)
+static int pt_start(const struct shell *shell, uint16_t channel)
 {
 	int err;
-	uint16_t channel;
 	uint32_t rd_id, nw_id, period_ms;
 
-	if (argc < 2) {
-		shell_error(shell, "Usage: PT <channel>");
-		return -EINVAL;
-	}
-
-	long ch = strtol(argv[1], NULL, 10);
-
-	if (ch <= 0 || ch > UINT16_MAX) {
-		shell_error(shell, "Channel must be between 1 and %u", UINT16_MAX);
-		return -EINVAL;
-	}
-	channel = (uint16_t)ch;
-
 	/* Look up the channel in the scan table */
 	k_mutex_lock(&app_mutex, K_FOREVER);
 	const struct pt_beacon_entry *entry = pt_table_find_by_channel(channel);
@@ -1602,18 +2674,173 @@ static int cmd_pt(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
-static int cmd_status(const struct shell *shell, size_t argc, char **argv)
+/* Parse a carrier argument; returns 0 and sets *channel, or -EINVAL. */
+static int parse_channel(const struct shell *shell, const char *arg, uint16_t *channel)
+{
+	long ch = strtol(arg, NULL, 10);
+
+	if (ch <= 0 || ch > UINT16_MAX) {
+		shell_error(shell, "Channel must be between 1 and %u", UINT16_MAX);
+		return -EINVAL;
+	}
+	*channel = (uint16_t)ch;
+	return 0;
+}
+
+/* PT <channel> — associate with FT on <channel>. */
+static int cmd_pt(const struct shell *shell, size_t argc, char **argv)
+{
+	uint16_t channel;
+
+	if (argc < 2) {
+		shell_error(shell, "Usage: PT <channel>");
+		return -EINVAL;
+	}
+	if (parse_channel(shell, argv[1], &channel) != 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	relay_channel = 0;
+	k_mutex_unlock(&app_mutex);
+	return pt_start(shell, channel);
+}
+
+/* RELAY <upstream channel> <downstream channel> — associate as a PT with the FT
+ * on the upstream channel, then run an FT cluster on the downstream channel
+ * and forward between the two (relay.h). The cluster is brought up again
+ * after every reassociation. */
+static int cmd_relay(const struct shell *shell, size_t argc, char **argv)
+{
+	uint16_t upstream, downstream;
+	int err;
+
+	ARG_UNUSED(argc);
+
+	if (parse_channel(shell, argv[1], &upstream) != 0 ||
+	    parse_channel(shell, argv[2], &downstream) != 0) {
+		return -EINVAL;
+	}
+	if (upstream == downstream) {
+		shell_error(shell, "Upstream and downstream channels must differ");
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	relay_channel = downstream;
+	k_mutex_unlock(&app_mutex);
+	err = pt_start(shell, upstream);
+	if (err == 0) {
+		shell_print(shell, "RELAY: downstream cluster on ch=%u starts once associated",
+			    downstream);
+	}
+	return err;
+}
+
+/* Receive-side sequence statistics of a peer, if it numbers its SDUs (SEQ ON). */
+static void status_print_seq(const struct shell *shell, uint32_t long_rd_id)
 {
+	struct seqtrack_stats st;
+
+	if (seqtrack_get(long_rd_id, &st) == 0) {
+		shell_print(shell, "    seq rx=%u lost=%u dup=%u reordered=%u jitter=%u.%02u ms",
+			    st.received, st.lost, st.duplicates, st.reordered, st.jitter_x16 / 16U,
+			    (st.jitter_x16 % 16U) * 100U / 16U);
+	}
+}
+
+/* One line per associated PT; ft_assoc_foreach() callback. */
+static void status_print_pt(const struct ft_assoc_peer *peer, void *user_data)
+{
+	const struct shell *shell = user_data;
+	uint32_t now = k_uptime_get_32();
+
+	if (peer->last_rx_ms != 0) {
+		shell_print(shell, "  rd=%u up %u s (assoc x%u) tx ok=%u fail=%u (%u B) "
+			    "rx=%u (%u B) last rx %u ms ago",
+			    peer->long_rd_id, (now - peer->associated_ms) / 1000U, peer->associations,
+			    peer->tx_ok, peer->tx_fail, peer->tx_bytes, peer->rx_sdus,
+			    peer->rx_bytes, now - peer->last_rx_ms);
+	} else {
+		shell_print(shell, "  rd=%u up %u s (assoc x%u) tx ok=%u fail=%u (%u B) rx=0",
+			    peer->long_rd_id, (now - peer->associated_ms) / 1000U, peer->associations,
+			    peer->tx_ok, peer->tx_fail, peer->tx_bytes);
+	}
+	status_print_seq(shell, peer->long_rd_id);
+}
+
+/* PORTS — RX demultiplexer: services per port and SDUs delivered to each. */
+static int cmd_ports(const struct shell *shell, size_t argc, char **argv)
+{
+	static const char *const names[APP_DLC_PORT_USER] = {
+		[APP_DLC_PORT_DATA] = "data",
+		[APP_DLC_PORT_PERF] = "perf",
+		[APP_DLC_PORT_ECHO] = "echo",
+		[APP_DLC_PORT_FRAG] = "frag",
+		[APP_DLC_PORT_BATCH] = "batch",
+		[APP_DLC_PORT_COMPRESSED] = "compressed",
+		[APP_DLC_PORT_ROUTE] = "route",
+		[APP_DLC_PORT_SEQ] = "seq",
+		[APP_DLC_PORT_TIME] = "time",
+		[APP_DLC_PORT_IP] = "ip",
+	};
+	uint32_t counts[ARRAY_SIZE(port_rx_count)];
+	bool user[ARRAY_SIZE(user_port_handlers)];
+	uint32_t unknown;
+
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
+	K_SPINLOCK(&port_lock) {
+		memcpy(counts, port_rx_count, sizeof(counts));
+		for (size_t i = 0; i < ARRAY_SIZE(user); i++) {
+			user[i] = user_port_handlers[i] != NULL;
+		}
+		unknown = port_rx_unknown;
+	}
+
+	for (size_t port = 0; port < ARRAY_SIZE(names); port++) {
+		if (port_handlers[port] != NULL) {
+			shell_print(shell, "  port %2zu %-10s rx=%u", port, names[port], counts[port]);
+		}
+	}
+	for (size_t i = 0; i < ARRAY_SIZE(user); i++) {
+		if (user[i] || counts[APP_DLC_PORT_USER + i] != 0) {
+			shell_print(shell, "  port %2zu %-10s rx=%u", APP_DLC_PORT_USER + i,
+				    user[i] ? "user" : "(released)", counts[APP_DLC_PORT_USER + i]);
+		}
+	}
+	shell_print(shell, "PORTS: %zu user port(s) from %u, rx on ports without a service=%u",
+		    ARRAY_SIZE(user), APP_DLC_PORT_USER, unknown);
+	return 0;
+}
+
+/* STATUS [rd] — with an RD ID on an FT, only that PT's entry. */
+static int cmd_status(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		struct ft_assoc_peer peer;
+		uint32_t rd = (uint32_t)strtoul(argv[1], NULL, 10);
+
+		if (ft_assoc_get(rd, &peer) != 0) {
+			shell_error(shell, "rd=%s is not associated with this FT", argv[1]);
+			return -ENOENT;
+		}
+		status_print_pt(&peer, (void *)shell);
+		return 0;
+	}
+
 	k_mutex_lock(&app_mutex, K_FOREVER);
 	shell_print(shell, "Mode: %s", mode_name(current_mode));
 	if (current_mode == APP_MODE_FT) {
-		shell_print(shell, "FT beacon period: %u ms", ft_period_ms);
-		shell_print(shell, "FT RACH fill: %u%%", ft_rach_fill_percentage);
-		shell_print(shell, "FT child associated: %s (rd=%u)",
-			ft_child_associated ? "yes" : "no", ft_child_long_rd_id);
+		shell_print(shell, "FT beacon period: %u ms (idle %u ms, %s)", ft_period_active_ms,
+			    ft_period_ms, beacon_adapt_enabled() ? "adaptive" : "fixed");
+		shell_print(shell, "FT RACH fill: %u%% cw %u..%u (%s)", ft_rach.fill_percentage,
+			    ft_rach.cw_min_sig, ft_rach.cw_max_sig,
+			    rach_tune_enabled() ? "auto" : "manual");
+		shell_print(shell, "FT PTs associated: %zu/%u", ft_assoc_count(),
+			    CONFIG_APP_FT_MAX_PTS);
+		ft_assoc_foreach(status_print_pt, (void *)shell);
 	}
 	if (current_mode == APP_MODE_PT) {
 		shell_print(shell, "PT associated: %s", pt_associated ? "yes" : "no");
@@ -1621,6 +2848,13 @@ static int cmd_status(const struct shell *shell, size_t argc, char **argv)
 		if (pt_associated) {
 			shell_print(shell, "PT parent channel: %u", pt_parent_channel);
 			shell_print(shell, "PT parent long RD ID: %u", pt_parent_long_rd_id);
+			status_print_seq(shell, pt_parent_long_rd_id);
+		}
+		if (relay_channel != 0) {
+			shell_print(shell, "Relay downstream: ch=%u %s, PTs %zu/%u", relay_channel,
+				    relay_cluster_up ? "beaconing" : "waiting for association",
+				    ft_assoc_count(), CONFIG_APP_FT_MAX_PTS);
+			ft_assoc_foreach(status_print_pt, (void *)shell);
 		}
 	}
 	shell_print(shell, "Beacon table: %u entr%s", pt_beacon_table_count,
@@ -1633,6 +2867,9 @@ static int cmd_status(const struct shell *shell, size_t argc, char **argv)
 			    e->cluster_beacon_period_ms, e->rssi_dbm);
 	}
 	shell_print(shell, "Power save: %s", power_save_enabled ? "enabled" : "disabled");
+	shell_print(shell, "DLC RX dropped: %u", (uint32_t)atomic_get(&dlc_rx_drop_count));
+	shell_print(shell, "Events dropped: %u", (uint32_t)atomic_get(&app_evt_drop_count));
+	shell_print(shell, "PT recoveries: %u", pt_recovery_count);
 	k_mutex_unlock(&app_mutex);
 
 	return 0;
@@ -1669,26 +2906,79 @@ static int cmd_powersave(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+/* PROFILE [name]: list profiles, or apply one and restart the current mode. */
+static int cmd_profile(const struct shell *shell, size_t argc, char **argv)
+{
+	const struct power_profile *prof;
+	bool restart_mode;
+	int err = 0;
+
+	if (argc < 2) {
+		for (size_t i = 0; (prof = power_profile_get(i)) != NULL; i++) {
+			shell_print(shell, "  %-9s beacon %5u ms  RACH %3u%%  power save %-3s  batching %u ms",
+				    prof->name, prof->beacon_period_ms, prof->rach_fill_percentage,
+				    prof->power_save ? "on" : "off", prof->batch_ms);
+		}
+		return 0;
+	}
+
+	prof = power_profile_find(argv[1]);
+	if (prof == NULL) {
+		shell_error(shell, "Unknown profile '%s' (PROFILE lists them)", argv[1]);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&app_mutex, K_FOREVER);
+	ft_period_ms = prof->beacon_period_ms;
+	pt_scan_time_ms = 2 * ft_period_ms;
+	ft_rach.fill_percentage = prof->rach_fill_percentage;
+	ft_rach_ceiling = prof->rach_fill_percentage;
+	power_save_enabled = prof->power_save;
+	restart_mode = (current_mode == APP_MODE_PT || current_mode == APP_MODE_FT);
+	k_mutex_unlock(&app_mutex);
+	coalesce_delay_set(prof->batch_ms);
+
+	if (restart_mode) {
+		err = restart_current_mode();
+	}
+	if (err != 0) {
+		shell_error(shell, "PROFILE update failed: %d", err);
+		return err;
+	}
+
+	shell_print(shell, "Profile %s applied (POWER shows the estimated radio-on time)", prof->name);
+	return 0;
+}
+
 static int cmd_activetime(const struct shell *shell, size_t argc, char **argv)
 {
 	int err = 0;
-	bool restart_ft;
-	long value = strtol(argv[1], NULL, 10);
+	uint16_t carrier;
+	long value;
 
 	ARG_UNUSED(argc);
 
+	if (strcmp(argv[1], "AUTO") == 0 || strcmp(argv[1], "auto") == 0) {
+		rach_tune_enable(true);
+		shell_print(shell, "RACH fill tuned automatically (RACH shows the decisions)");
+		return 0;
+	}
+
+	value = strtol(argv[1], NULL, 10);
 	if (value < 1 || value > 100) {
-		shell_error(shell, "ACTIVETIME must be between 1 and 100");
+		shell_error(shell, "ACTIVETIME must be between 1 and 100, or AUTO");
 		return -EINVAL;
 	}
 
+	rach_tune_enable(false);
 	k_mutex_lock(&app_mutex, K_FOREVER);
-	ft_rach_fill_percentage = (uint8_t)value;
-	restart_ft = (current_mode == APP_MODE_FT);
+	ft_rach.fill_percentage = (uint8_t)value;
+	carrier = cluster_carrier_locked();
 	k_mutex_unlock(&app_mutex);
 
-	if (restart_ft) {
-		err = configure_ft();
+	/* Reconfigure the running cluster in place; associations are kept. */
+	if (carrier != 0) {
+		err = cluster_start(carrier);
 	}
 
 	if (err != 0) {
@@ -1696,7 +2986,8 @@ static int cmd_activetime(const struct shell *shell, size_t argc, char **argv)
 		return err;
 	}
 
-	shell_print(shell, "RACH fill percentage set to %u%%", ft_rach_fill_percentage);
+	shell_print(shell, "RACH fill percentage set to %u%% (manual until ACTIVETIME AUTO)",
+		    ft_rach.fill_percentage);
 	return 0;
 }
 
@@ -1707,10 +2998,15 @@ static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
 
 	k_mutex_lock(&app_mutex, K_FOREVER);
 
-	/* Release association if any */
-	if (ft_child_associated && ft_child_long_rd_id != 0) {
-		LOG_INF("STOP: releasing FT->PT association rd=%u", ft_child_long_rd_id);
-		(void)dect_adapter_association_release(ft_child_long_rd_id);
+	/* Release associations if any */
+	if (current_mode == APP_MODE_FT || relay_cluster_up) {
+		uint32_t rds[CONFIG_APP_FT_MAX_PTS];
+		size_t n = ft_assoc_list(rds, ARRAY_SIZE(rds));
+
+		for (size_t i = 0; i < n; i++) {
+			LOG_INF("STOP: releasing FT->PT association rd=%u", rds[i]);
+			(void)dect_adapter_association_release(rds[i]);
+		}
 	}
 	if (pt_associated && pt_parent_long_rd_id != 0) {
 		LOG_INF("STOP: releasing PT->FT association rd=%u", pt_parent_long_rd_id);
@@ -1718,6 +3014,7 @@ static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
 	}
 
 	current_mode = APP_MODE_IDLE;
+	relay_channel = 0;
 	k_mutex_unlock(&app_mutex);
 
 	/* init_mac stops scans, stops beaconing (functional_mode false/true), resets state */
@@ -1773,15 +3070,46 @@ static int cmd_help_dect(const struct shell *shell, size_t argc, char **argv)
 
 	shell_print(shell, "=== DECT MAC Demo Commands ===");
 	shell_print(shell, "");
-	shell_print(shell, "  SCAN                    FT RSSI scan all Band 1 channels, prints ch/busy%%");
+	shell_print(shell, "  SCAN [passes|CLEAR]     RSSI scan Band 1 into the channel history, print channels ranked");
+	shell_print(shell, "  SPECTRUM [ON|OFF]       Background channel monitor while beaconing, interference alerts");
 	shell_print(shell, "  FT [carrier]            Start FT beacon mode on carrier (default: last SCAN result)");
 	shell_print(shell, "  PT_SCAN [channel]       Scan for FT beacons, populate discovery table (no association)");
 	shell_print(shell, "  PT <channel>            Associate with FT on <channel> (must run PT_SCAN first)");
+	shell_print(shell, "  RELAY <up_ch> <down_ch> Associate on up_ch, then beacon for PTs on down_ch and forward");
+	shell_print(shell, "  ROUTES                  Relay route table (hops, link quality) and forwarding counters");
 	shell_print(shell, "  PERIOD <ms>             Set FT cluster beacon period (50..32000 ms)");
-	shell_print(shell, "  SEND <text>             Send ASCII text to associated peer");
-	shell_print(shell, "  STATUS                  Show current mode, carrier, beacon table, association state");
+	shell_print(shell, "  SEND [@rd|@ALL|@ROOT] <text>  Send ASCII text to associated peer, one device, all PTs, or the root FT");
+	shell_print(shell, "  SENDHEX [@rd|@ALL|@ROOT] <hex>  Send binary payload given as hex digits");
+	shell_print(shell, "  SENDB64 [@rd|@ALL|@ROOT] <b64>  Send binary payload given as base64");
+	shell_print(shell, "  PERF SINK|SOURCE|STOP   DLC throughput benchmark (PERF for usage)");
+	shell_print(shell, "  PING <n> [size] [ms]    Echo RTT to associated peer (PING 0 aborts)");
+	shell_print(shell, "  FRAG [SEND <len>]       Fragmentation stats, or send a multi-SDU test message");
+	shell_print(shell, "  COALESCE [delay_ms]     Pack small SEND messages into one SDU (0 = off)");
+	shell_print(shell, "  COMPRESS [ON|OFF]       LZSS compression of SEND payloads, and its stats");
+	shell_print(shell, "  TXQ                     TX scheduler queues per peer and flow");
+	shell_print(shell, "  OUTBOX [ON|OFF|CLEAR]   Store uplink SENDs while the PT has no parent, drained on reassociation");
+	shell_print(shell, "  SEQ [ON|OFF|RESET]      Number sent SDUs; per-peer loss, duplicates, reordering, jitter");
+	shell_print(shell, "  TIME [PROBE [n]|RESET]  Network time synced to the FT; PROBE measures one-way latency");
+	shell_print(shell, "  EP                      Open DLC endpoints (dlc_ep.h): queued, received, dropped");
+#if defined(CONFIG_APP_DLC_NET)
+	shell_print(shell, "  IP [RESET]              IPv6 interface dect0 over DLC: addresses, packets, header overhead");
+#endif
+	shell_print(shell, "  PORTS                   DLC service ports (RX demultiplexer) and SDUs received on each");
+	shell_print(shell, "  BCAST                   Progress and per-PT results of the last SEND @ALL");
+	shell_print(shell, "  PROFILE [name]          List power profiles, or apply one (perf, balanced, battery)");
+	shell_print(shell, "  POWER [RESET]           Estimated radio-on time per hour and TX latency");
+	shell_print(shell, "  TELEMETRY [interval_ms] Periodic binary status frames (0 = off), link counters");
+	if (IS_ENABLED(CONFIG_APP_TRACE)) {
+		shell_print(shell, "  TRACE [DUMP|CLEAR|ON|OFF] Binary event trace of callbacks, dump for trace_decode.py");
+	}
+	if (IS_ENABLED(CONFIG_APP_RPC)) {
+		shell_print(shell, "  RPC                     Binary RPC channel (second UART) counters");
+	}
+	shell_print(shell, "  STATUS [rd]             Show current mode, carrier, beacon table, associated PTs; or one PT");
 	shell_print(shell, "  POWERSAVE <0|1>         Enable (1) or disable (0) power save mode (FT and PT)");
-	shell_print(shell, "  ACTIVETIME <1-100>      Set FT RACH fill percentage (default 100)");
+	shell_print(shell, "  ACTIVETIME <1-100|AUTO> Set FT RACH fill percentage (manual), or tune it automatically");
+	shell_print(shell, "  RACH                    Automatic RACH tuning inputs and last decision");
+	shell_print(shell, "  BEACON [ON|OFF]         Load-adaptive FT beacon period (PERIOD is the idle period)");
 	shell_print(shell, "  STOP                    Release association, stop scans/beaconing, go idle");
 	shell_print(shell, "  LIMIT [min max]         Show or set RSSI thresholds (dBm) for SCAN");
 	shell_print(shell, "                          Free if RSSI < min, busy if RSSI > max");
@@ -1792,30 +3120,40 @@ static int cmd_help_dect(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
-SHELL_CMD_ARG_REGISTER(SCAN,      NULL, "RSSI scan all Band 1 channels, print busy%",             cmd_scan,      1, 0);
+SHELL_CMD_ARG_REGISTER(SCAN,      NULL, "SCAN [passes|CLEAR] — RSSI scan, ranked channel history", cmd_scan,      1, 1);
 SHELL_CMD_ARG_REGISTER(STOP,      NULL, "Stop all activity, return to idle",                       cmd_stop,      1, 0);
-SHELL_CMD_ARG_REGISTER(SEND,      NULL, "SEND <ascii text>",                                       cmd_send,      2, 32);
+SHELL_CMD_ARG_REGISTER(SEND,      NULL, "SEND [@rd|@ALL|@ROOT] <ascii text>",                      cmd_send,      2, 32);
+SHELL_CMD_ARG_REGISTER(SENDHEX,   NULL, "SENDHEX [@rd|@ALL|@ROOT] <hex> — binary payload",         cmd_sendhex,   2, 32);
+SHELL_CMD_ARG_REGISTER(SENDB64,   NULL, "SENDB64 [@rd|@ALL|@ROOT] <base64> — binary payload",      cmd_sendb64,   2, 32);
 SHELL_CMD_ARG_REGISTER(FT,        NULL, "Start FT beacon mode [carrier]",                          cmd_ft,        1, 1);
 SHELL_CMD_ARG_REGISTER(PERIOD,    NULL, "PERIOD <ms>",                                             cmd_period,    2, 0);
 SHELL_CMD_ARG_REGISTER(PT_SCAN,   NULL, "Scan for FT beacons [channel] — no association",         cmd_pt_scan,   1, 1);
 SHELL_CMD_ARG_REGISTER(PT,        NULL, "Associate with FT on <channel> (run PT_SCAN first)",      cmd_pt,        2, 0);
-SHELL_CMD_ARG_REGISTER(STATUS,    NULL, "Show mode, timing, channel",                              cmd_status,    1, 0);
+SHELL_CMD_ARG_REGISTER(RELAY,     NULL, "RELAY <up_ch> <down_ch> — PT upstream, FT downstream, forward", cmd_relay, 3, 0);
+SHELL_CMD_ARG_REGISTER(STATUS,    NULL, "STATUS [rd] — mode, timing, channel; or one PT on an FT",   cmd_status,    1, 1);
+SHELL_CMD_ARG_REGISTER(PORTS,     NULL, "PORTS — DLC service ports and SDUs received on each",     cmd_ports,     1, 0);
 SHELL_CMD_ARG_REGISTER(POWERSAVE,   NULL, "POWERSAVE 0|1",                                          cmd_powersave,   2, 0);
-SHELL_CMD_ARG_REGISTER(ACTIVETIME, NULL, "ACTIVETIME <1-100> — FT RACH fill percentage",           cmd_activetime,  2, 0);
+SHELL_CMD_ARG_REGISTER(ACTIVETIME, NULL, "ACTIVETIME <1-100|AUTO> — FT RACH fill percentage",      cmd_activetime,  2, 0);
+SHELL_CMD_ARG_REGISTER(PROFILE,    NULL, "PROFILE [name] — list or apply a power profile",           cmd_profile,     1, 1);
 SHELL_CMD_ARG_REGISTER(LIMIT,      NULL, "LIMIT [min max] — RSSI thresholds for SCAN",             cmd_limit,       1, 2);
 SHELL_CMD_ARG_REGISTER(HELP,       NULL, "Show command help",                                       cmd_help_dect,   1, 0);
 
 /* Lowercase aliases */
-SHELL_CMD_ARG_REGISTER(scan,       NULL, "rssi scan all band 1 channels, print busy%",             cmd_scan,        1, 0);
+SHELL_CMD_ARG_REGISTER(scan,       NULL, "scan [passes|clear] — rssi scan, ranked channel history", cmd_scan,        1, 1);
 SHELL_CMD_ARG_REGISTER(stop,       NULL, "stop all activity, return to idle",                      cmd_stop,        1, 0);
-SHELL_CMD_ARG_REGISTER(send,       NULL, "send <ascii text>",                                      cmd_send,        2, 32);
+SHELL_CMD_ARG_REGISTER(send,       NULL, "send [@rd|@all|@root] <ascii text>",                     cmd_send,        2, 32);
+SHELL_CMD_ARG_REGISTER(sendhex,    NULL, "sendhex [@rd|@all|@root] <hex> — binary payload",        cmd_sendhex,     2, 32);
+SHELL_CMD_ARG_REGISTER(sendb64,    NULL, "sendb64 [@rd|@all|@root] <base64> — binary payload",     cmd_sendb64,     2, 32);
 SHELL_CMD_ARG_REGISTER(ft,         NULL, "start ft beacon mode [carrier]",                         cmd_ft,          1, 1);
 SHELL_CMD_ARG_REGISTER(period,     NULL, "period <ms>",                                            cmd_period,      2, 0);
 SHELL_CMD_ARG_REGISTER(pt_scan,    NULL, "scan for ft beacons [channel] — no association",        cmd_pt_scan,     1, 1);
 SHELL_CMD_ARG_REGISTER(pt,         NULL, "associate with ft on <channel> (run pt_scan first)",     cmd_pt,          2, 0);
-SHELL_CMD_ARG_REGISTER(status,     NULL, "show mode, timing, channel",                             cmd_status,      1, 0);
+SHELL_CMD_ARG_REGISTER(relay,      NULL, "relay <up_ch> <down_ch> — pt upstream, ft downstream, forward", cmd_relay, 3, 0);
+SHELL_CMD_ARG_REGISTER(status,     NULL, "status [rd] — mode, timing, channel; or one PT on an FT",  cmd_status,      1, 1);
+SHELL_CMD_ARG_REGISTER(ports,      NULL, "ports — dlc service ports and sdus received on each",     cmd_ports,       1, 0);
 SHELL_CMD_ARG_REGISTER(powersave,  NULL, "powersave 0|1",                                          cmd_powersave,   2, 0);
-SHELL_CMD_ARG_REGISTER(activetime, NULL, "activetime <1-100> — ft rach fill percentage",           cmd_activetime,  2, 0);
+SHELL_CMD_ARG_REGISTER(activetime, NULL, "activetime <1-100|auto> — ft rach fill percentage",      cmd_activetime,  2, 0);
+SHELL_CMD_ARG_REGISTER(profile,    NULL, "profile [name] — list or apply a power profile",           cmd_profile,     1, 1);
 SHELL_CMD_ARG_REGISTER(limit,      NULL, "limit [min max] — rssi thresholds for scan",            cmd_limit,       1, 2);
 SHELL_CMD_ARG_REGISTER(help,       NULL, "show command help",                                      cmd_help_dect,   1, 0);
 
@@ -1838,10 +3176,17 @@ int main(void)
 		return err;
 	}
 
+	tx_sched_init(cb_op_dlc_data_tx);
+	power_init();
+	telemetry_init();
+	outbox_init();
+
+#if defined(CONFIG_DK_LIBRARY)
 	err = dk_leds_init();
 	if (err != 0) {
 		LOG_ERR("dk_leds_init failed: %d", err);
 	}
+#endif
 	id_len = hwinfo_get_device_id(id_buf, sizeof(id_buf));
 	if (id_len < 0) {
 		LOG_ERR("hwinfo_get_device_id failed: %d", (int)id_len);
@@ -1851,6 +3196,7 @@ int main(void)
 	for (size_t i = 0; i < sizeof(id_buf); i++) {
 		device_long_rd_id = (device_long_rd_id << 8) | id_buf[i];
 	}
+	dlc_net_init(device_long_rd_id);
 
 	err = dect_adapter_callbacks_set(&app_op_callbacks, &app_ntf_callbacks);
 	if (err != 0) {
@@ -1919,7 +3265,7 @@ int main(void)
 	}
 	printk("RSSI thresholds: free < %d dBm, busy > %d dBm (change with LIMIT <min> <max>)\n",
 	       scan_threshold_min, scan_threshold_max);
-	printk("Commands: SCAN, FT [carrier], PT_SCAN [channel], PT <channel>, SEND, PERIOD <ms>, STATUS, POWERSAVE <0|1>, LIMIT [min max], STOP, HELP\n");
+	printk("Commands: SCAN, FT [carrier], PT_SCAN [channel], PT <channel>, SEND, SENDHEX, SENDB64, PERIOD <ms>, STATUS, POWERSAVE <0|1>, LIMIT [min max], STOP, HELP\n");
 	printk("Typical FT workflow:  SCAN -> FT <carrier>\n");
 	printk("Typical PT workflow:  PT_SCAN -> PT <channel>\n");
 
@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "outbox.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/ring_buffer.h>
+#if defined(CONFIG_APP_OUTBOX_FLASH)
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#endif
+#include "app_dlc.h"
+
+LOG_MODULE_REGISTER(outbox, CONFIG_LOG_DEFAULT_LEVEL);
+
+#if defined(CONFIG_APP_OUTBOX_FLASH)
+#if FIXED_PARTITION_EXISTS(storage_partition)
+#define OUTBOX_USE_FLASH 1
+#define OUTBOX_FCB_MAGIC       0x3158424f /* "OBX1" */
+#define OUTBOX_FCB_VERSION     1
+#define OUTBOX_FLASH_SECTORS_MAX 32
+#endif
+#endif
+
+/* Slack behind a record so that a flash write rounded up to the write block
+ * stays inside the buffer. */
+#define OUTBOX_WRITE_PAD 16
+
+/* Header in front of every stored payload, in RAM and in flash. */
+struct outbox_hdr {
+	uint32_t seq;
+	uint32_t stored_ms;
+	uint16_t len;
+	uint8_t port;
+	uint8_t reserved;
+} __packed;
+
+struct outbox_rec {
+	struct outbox_hdr hdr;
+	uint8_t data[APP_DLC_PAYLOAD_LEN_MAX + OUTBOX_WRITE_PAD];
+} __packed;
+
+BUILD_ASSERT(CONFIG_APP_OUTBOX_RAM_SIZE >= sizeof(struct outbox_hdr) + APP_DLC_PAYLOAD_LEN_MAX,
+	     "CONFIG_APP_OUTBOX_RAM_SIZE must hold at least one full-size payload");
+
+RING_BUF_DECLARE(ram_ring, CONFIG_APP_OUTBOX_RAM_SIZE);
+
+static struct {
+	bool enabled;
+	bool flash_ok;
+	uint32_t next_seq;
+	uint32_t boot_seq;  /* payloads with a lower seq come from a previous boot */
+	size_t ram_count;
+	size_t flash_count;
+} state = {
+	.enabled = IS_ENABLED(CONFIG_APP_OUTBOX),
+};
+
+static struct {
+	uint32_t stored;
+	uint32_t sent;
+	uint32_t expired;
+	uint32_t dropped;   /* oldest payloads given up to make room */
+	uint32_t spilled;   /* moved from RAM to flash */
+	uint32_t restored;  /* found in flash at boot */
+	uint32_t errors;    /* refused by the TX path or unreadable */
+} stats;
+
+/* Leaf lock: never held while calling into the DLC send path. */
+static K_MUTEX_DEFINE(outbox_mutex);
+
+static void drain_work_handler(struct k_work *work);
+static K_WORK_DEFINE(drain_work, drain_work_handler);
+
+#if defined(OUTBOX_USE_FLASH)
+static struct flash_sector fcb_sectors[OUTBOX_FLASH_SECTORS_MAX];
+static struct fcb fcb;
+/* Last flash entry already sent; fe_sector NULL = none since the last clear. */
+static struct fcb_entry rd_loc;
+
+static int flash_read_locked(const struct fcb_entry *loc, struct outbox_rec *rec, bool data)
+{
+	int err = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF((*loc)), &rec->hdr,
+				  sizeof(rec->hdr));
+
+	if (err == 0 && (rec->hdr.len == 0 || rec->hdr.len > APP_DLC_PAYLOAD_LEN_MAX ||
+			 loc->fe_data_len != sizeof(rec->hdr) + rec->hdr.len)) {
+		err = -EBADMSG;
+	}
+	if (err == 0 && data) {
+		err = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF((*loc)) + sizeof(rec->hdr),
+				      rec->data, rec->hdr.len);
+	}
+	return err;
+}
+
+static void flash_clear_locked(void)
+{
+	fcb_clear(&fcb);
+	memset(&rd_loc, 0, sizeof(rd_loc));
+	state.flash_count = 0;
+}
+
+/* Mark loc sent and erase the sectors that hold nothing unsent any more. */
+static void flash_consume_locked(const struct fcb_entry *loc)
+{
+	rd_loc = *loc;
+	if (--state.flash_count == 0) {
+		flash_clear_locked();
+		return;
+	}
+	while (fcb.f_oldest != rd_loc.fe_sector && fcb_rotate(&fcb) == 0) {
+	}
+}
+
+/* Flash is full: erase the oldest sector and forget the unsent payloads in it. */
+static int flash_drop_oldest_locked(void)
+{
+	struct fcb_entry loc = rd_loc;
+	struct flash_sector *oldest = fcb.f_oldest;
+	size_t lost = 0;
+	int err;
+
+	while (fcb_getnext(&fcb, &loc) == 0 && loc.fe_sector == oldest) {
+		lost++;
+	}
+	err = fcb_rotate(&fcb);
+	if (err != 0) {
+		return err;
+	}
+	if (rd_loc.fe_sector == oldest) {
+		memset(&rd_loc, 0, sizeof(rd_loc));
+	}
+	state.flash_count -= MIN(lost, state.flash_count);
+	stats.dropped += lost;
+	return 0;
+}
+
+static int flash_append_locked(const struct outbox_rec *rec)
+{
+	size_t len = sizeof(rec->hdr) + rec->hdr.len;
+	size_t align = MAX(flash_area_align(fcb.fap), 1U);
+	struct fcb_entry loc;
+	int err;
+
+	err = fcb_append(&fcb, len, &loc);
+	if (err == -ENOSPC && flash_drop_oldest_locked() == 0) {
+		err = fcb_append(&fcb, len, &loc);
+	}
+	if (err != 0) {
+		return err;
+	}
+	/* fcb_append() reserved len rounded up to the write block. */
+	__ASSERT_NO_MSG(ROUND_UP(len, align) <= sizeof(*rec));
+	err = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), rec, ROUND_UP(len, align));
+	if (err == 0) {
+		err = fcb_append_finish(&fcb, &loc);
+	}
+	if (err == 0) {
+		state.flash_count++;
+	}
+	return err;
+}
+#endif /* OUTBOX_USE_FLASH */
+
+void outbox_init(void)
+{
+#if defined(OUTBOX_USE_FLASH)
+	static struct outbox_rec rec;
+	uint32_t cnt = ARRAY_SIZE(fcb_sectors);
+	struct fcb_entry loc = {0};
+	int err;
+
+	err = flash_area_get_sectors(FIXED_PARTITION_ID(storage_partition), &cnt, fcb_sectors);
+	if (err == 0) {
+		fcb.f_magic = OUTBOX_FCB_MAGIC;
+		fcb.f_version = OUTBOX_FCB_VERSION;
+		fcb.f_sectors = fcb_sectors;
+		fcb.f_sector_cnt = (uint8_t)cnt;
+		fcb.f_scratch_cnt = 0;
+		err = fcb_init(FIXED_PARTITION_ID(storage_partition), &fcb);
+	}
+	if (err != 0) {
+		LOG_WRN("Outbox: storage partition not usable (%d), RAM only", err);
+		return;
+	}
+
+	k_mutex_lock(&outbox_mutex, K_FOREVER);
+	state.flash_ok = true;
+	while (fcb_getnext(&fcb, &loc) == 0) {
+		if (flash_read_locked(&loc, &rec, false) != 0) {
+			continue;
+		}
+		state.flash_count++;
+		state.next_seq = MAX(state.next_seq, rec.hdr.seq + 1);
+	}
+	state.boot_seq = state.next_seq;
+	stats.restored = state.flash_count;
+	k_mutex_unlock(&outbox_mutex);
+
+	if (stats.restored != 0) {
+		LOG_INF("Outbox: %u payload(s) restored from flash", stats.restored);
+	}
+#endif
+}
+
+bool outbox_enabled(void)
+{
+	bool enabled;
+
+	k_mutex_lock(&outbox_mutex, K_FOREVER);
+	enabled = state.enabled;
+	k_mutex_unlock(&outbox_mutex);
+	return enabled;
+}
+
+size_t outbox_count(void)
+{
+	size_t count;
+
+	k_mutex_lock(&outbox_mutex, K_FOREVER);
+	count = state.ram_count + state.flash_count;
+	k_mutex_unlock(&outbox_mutex);
+	return count;
+}
+
+/* Move the oldest RAM payload to flash, or drop it without flash. */
+static void make_room_locked(void)
+{
+	static struct outbox_rec rec;
+
+	ring_buf_get(&ram_ring, (uint8_t *)&rec.hdr, sizeof(rec.hdr));
+	ring_buf_get(&ram_ring, rec.data, rec.hdr.len);
+	state.ram_count--;
+
+#if defined(OUTBOX_USE_FLASH)
+	if (state.flash_ok) {
+		int err = flash_append_locked(&rec);
+
+		if (err == 0) {
+			stats.spilled++;
+			return;
+		}
+		LOG_WRN("Outbox: flash write failed (%d), payload seq=%u dropped", err,
+			rec.hdr.seq);
+	}
+#endif
+	stats.dropped++;
+}
+
+int outbox_put(uint8_t port, const void *data, size_t len)
+{
+	struct outbox_hdr hdr;
+
+	if (data == NULL || len == 0) {
+		return -EINVAL;
+	}
+	if (len > APP_DLC_PAYLOAD_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&outbox_mutex, K_FOREVER);
+	while (ring_buf_space_get(&ram_ring) < sizeof(hdr) + len) {
+		make_room_locked();
+	}
+	hdr = (struct outbox_hdr){
+		.seq = state.next_seq++,
+		.stored_ms = k_uptime_get_32(),
+		.len = (uint16_t)len,
+		.port = port,
+	};
+	ring_buf_put(&ram_ring, (const uint8_t *)&hdr, sizeof(hdr));
+	ring_buf_put(&ram_ring, data, len);
+	state.ram_count++;
+	stats.stored++;
+	k_mutex_unlock(&outbox_mutex);
+	return 0;
+}
+
+/* Copy the oldest unsent payload: flash first, it holds the older ones. */
+static int peek_locked(struct outbox_rec *rec)
+{
+#if defined(OUTBOX_USE_FLASH)
+	while (state.flash_count != 0) {
+		struct fcb_entry loc = rd_loc;
+
+		if (fcb_getnext(&fcb, &loc) != 0) {
+			LOG_WRN("Outbox: %zu payload(s) lost in flash", state.flash_count);
+			stats.errors += state.flash_count;
+			flash_clear_locked();
+			break;
+		}
+		if (flash_read_locked(&loc, rec, true) == 0) {
+			return 0;
+		}
+		stats.errors++;
+		flash_consume_locked(&loc);
+	}
+#endif
+	if (state.ram_count == 0) {
+		return -ENOENT;
+	}
+	ring_buf_peek(&ram_ring, (uint8_t *)&rec->hdr, sizeof(rec->hdr));
+	ring_buf_peek(&ram_ring, (uint8_t *)rec, sizeof(rec->hdr) + rec->hdr.len);
+	return 0;
+}
+
+/* Remove the oldest payload if it is still the one with this seq: a spill can
+ * have moved it to flash, a CLEAR can have removed it. */
+static void pop_locked(uint32_t seq)
+{
+	struct outbox_hdr hdr;
+
+#if defined(OUTBOX_USE_FLASH)
+	if (state.flash_count != 0) {
+		struct fcb_entry loc = rd_loc;
+
+		if (fcb_getnext(&fcb, &loc) == 0 &&
+		    flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), &hdr, sizeof(hdr)) == 0 &&
+		    hdr.seq == seq) {
+			flash_consume_locked(&loc);
+		}
+		return;
+	}
+#endif
+	if (state.ram_count != 0 &&
+	    ring_buf_peek(&ram_ring, (uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+	    hdr.seq == seq) {
+		ring_buf_get(&ram_ring, NULL, sizeof(hdr) + hdr.len);
+		state.ram_count--;
+	}
+}
+
+/* Must be called with outbox_mutex held. */
+static bool expired_locked(const struct outbox_hdr *hdr, uint32_t now)
+{
+	uint32_t age_ms = hdr->seq < state.boot_seq ? now : now - hdr->stored_ms;
+
+	return CONFIG_APP_OUTBOX_TTL_S != 0 && age_ms / 1000U > CONFIG_APP_OUTBOX_TTL_S;
+}
+
+/* Send stored payloads to the parent until the scheduler is full or the link
+ * is gone; outbox_tx_done() and outbox_link_up() resume. */
+static void drain_work_handler(struct k_work *work)
+{
+	/* Static: this runs on the system workqueue's small stack. */
+	static struct outbox_rec rec;
+	uint32_t parent;
+	bool expired;
+	int err;
+
+	ARG_UNUSED(work);
+
+	while (app_dlc_parent_get(&parent) == 0) {
+		k_mutex_lock(&outbox_mutex, K_FOREVER);
+		err = peek_locked(&rec);
+		expired = err == 0 && expired_locked(&rec.hdr, k_uptime_get_32());
+		if (expired) {
+			pop_locked(rec.hdr.seq);
+			stats.expired++;
+		}
+		k_mutex_unlock(&outbox_mutex);
+		if (err != 0) {
+			return;
+		}
+		if (expired) {
+			continue;
+		}
+
+		err = app_dlc_port_send(parent, rec.hdr.port, rec.data, rec.hdr.len, NULL);
+		if (err == -ENOBUFS || err == -ENOTCONN) {
+			return;
+		}
+		if (err != 0) {
+			LOG_WRN("Outbox: payload seq=%u dropped: %d", rec.hdr.seq, err);
+		}
+
+		k_mutex_lock(&outbox_mutex, K_FOREVER);
+		pop_locked(rec.hdr.seq);
+		if (err == 0) {
+			stats.sent++;
+		} else {
+			stats.errors++;
+		}
+		k_mutex_unlock(&outbox_mutex);
+	}
+}
+
+void outbox_link_up(void)
+{
+	if (outbox_count() != 0) {
+		k_work_submit(&drain_work);
+	}
+}
+
+void outbox_tx_done(void)
+{
+	outbox_link_up();
+}
+
+static void outbox_clear(void)
+{
+	k_mutex_lock(&outbox_mutex, K_FOREVER);
+	ring_buf_reset(&ram_ring);
+	state.ram_count = 0;
+#if defined(OUTBOX_USE_FLASH)
+	if (state.flash_ok) {
+		flash_clear_locked();
+	}
+#endif
+	k_mutex_unlock(&outbox_mutex);
+}
+
+static int cmd_outbox(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "ON") == 0 || strcmp(argv[1], "on") == 0) {
+			k_mutex_lock(&outbox_mutex, K_FOREVER);
+			state.enabled = true;
+			k_mutex_unlock(&outbox_mutex);
+		} else if (strcmp(argv[1], "OFF") == 0 || strcmp(argv[1], "off") == 0) {
+			k_mutex_lock(&outbox_mutex, K_FOREVER);
+			state.enabled = false;
+			k_mutex_unlock(&outbox_mutex);
+		} else if (strcmp(argv[1], "CLEAR") == 0 || strcmp(argv[1], "clear") == 0) {
+			outbox_clear();
+		} else {
+			shell_error(shell, "Usage: OUTBOX [ON|OFF|CLEAR]");
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&outbox_mutex, K_FOREVER);
+	shell_print(shell, "OUTBOX: %s, %zu payload(s) waiting: %zu in RAM (%u of %u B), %zu in flash",
+		    state.enabled ? "on" : "off", state.ram_count + state.flash_count,
+		    state.ram_count, ring_buf_size_get(&ram_ring), CONFIG_APP_OUTBOX_RAM_SIZE,
+		    state.flash_count);
+	if (IS_ENABLED(CONFIG_APP_OUTBOX_FLASH) && !state.flash_ok) {
+		shell_print(shell, "OUTBOX: no usable storage partition, RAM only");
+	}
+	if (CONFIG_APP_OUTBOX_TTL_S != 0) {
+		shell_print(shell, "OUTBOX: payloads expire after %u s", CONFIG_APP_OUTBOX_TTL_S);
+	}
+	shell_print(shell, "OUTBOX: stored=%u sent=%u expired=%u dropped=%u spilled=%u "
+		    "restored=%u errors=%u", stats.stored, stats.sent, stats.expired,
+		    stats.dropped, stats.spilled, stats.restored, stats.errors);
+	k_mutex_unlock(&outbox_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(OUTBOX, NULL, "OUTBOX [ON|OFF|CLEAR] — store-and-forward of uplink SENDs on a PT", cmd_outbox, 1, 1);
+SHELL_CMD_ARG_REGISTER(outbox, NULL, "outbox [on|off|clear] — store-and-forward of uplink sends on a pt", cmd_outbox, 1, 1);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef OUTBOX_H__
+#define OUTBOX_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file outbox.h
+ * @brief Store-and-forward queue for uplink payloads on a PT.
+ *
+ * While a PT has no parent, or while older payloads are still waiting,
+ * payloads for the parent FT are stored here instead of failing with
+ * -ENOTCONN. After the next association they are sent to the parent in the
+ * order they were stored, as fast as the TX scheduler accepts them.
+ *
+ * Payloads are kept in a RAM ring of CONFIG_APP_OUTBOX_RAM_SIZE bytes. With
+ * CONFIG_APP_OUTBOX_FLASH the oldest payloads move to a flash circular buffer
+ * on storage_partition when the ring is full, and payloads still in flash are
+ * sent after a reboot. When flash is full too, the oldest payloads are
+ * dropped. Payloads older than CONFIG_APP_OUTBOX_TTL_S are dropped instead of
+ * sent; for payloads restored from flash the age counts from boot.
+ *
+ * Delivery is at least once: a payload can be sent twice if the PT reboots
+ * while draining flash.
+ */
+
+/**
+ * @brief Restore payloads left in flash by a previous boot.
+ *
+ * Called once at startup. Without a usable storage partition the outbox
+ * runs from RAM only.
+ */
+void outbox_init(void);
+
+/**
+ * @brief Check whether uplink payloads are stored while the link is down.
+ *
+ * @return true unless switched off with OUTBOX OFF
+ */
+bool outbox_enabled(void);
+
+/**
+ * @brief Count the payloads waiting to be sent.
+ *
+ * @return Payloads in RAM and flash
+ */
+size_t outbox_count(void);
+
+/**
+ * @brief Store a payload for the parent FT.
+ *
+ * @param port Service port
+ * @param data Payload bytes
+ * @param len  Payload length, 1..APP_DLC_PAYLOAD_LEN_MAX
+ * @return 0 on success (possibly after dropping the oldest payloads to make
+ *         room), -EINVAL on bad arguments, -EMSGSIZE if @p len is too large,
+ *         -EIO if the payload could not be stored
+ */
+int outbox_put(uint8_t port, const void *data, size_t len);
+
+/**
+ * @brief Start sending stored payloads.
+ *
+ * Called when a PT (or relay) has associated with its parent.
+ */
+void outbox_link_up(void);
+
+/**
+ * @brief Continue sending after a TX completion freed room in the scheduler.
+ */
+void outbox_tx_done(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OUTBOX_H__ */
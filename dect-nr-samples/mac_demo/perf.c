@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "perf.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+#include "app_dlc.h"
+
+LOG_MODULE_REGISTER(perf, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Wire format after the port byte (little endian):
+ *   [0]    type (PERF_MSG_DATA)
+ *   [1]    reserved
+ *   [2..3] session ID, new for every PERF SOURCE run
+ *   [4..7] sequence number, starts at 0
+ *   [8..11] source uptime in ms when the SDU was queued
+ * followed by filler up to the configured size. */
+#define PERF_MSG_DATA     1
+#define PERF_HDR_LEN      12
+#define PERF_TX_WINDOW    CONFIG_APP_PERF_TX_WINDOW
+#define PERF_TX_TIMEOUT_MS 5000 /* in-flight SDU without completion is written off */
+#define PERF_RETRY_MS     10    /* back-off after a synchronous send error */
+#define PERF_ERR_CODES    8     /* distinct TX error codes tracked per run */
+#define PERF_SINK_IDLE_INTERVALS 3 /* sink closes the session after this many empty reports */
+
+struct perf_tx_counters {
+	uint32_t sent;
+	uint32_t acked;
+	uint32_t failed;
+	uint32_t send_err;
+	uint32_t timed_out;
+	uint64_t bytes_acked;
+	uint32_t lat_n;
+	uint32_t lat_min_us;
+	uint32_t lat_max_us;
+	uint64_t lat_sum_us;
+};
+
+struct perf_rx_counters {
+	uint32_t rx;
+	uint32_t unique;
+	uint32_t reordered;
+	uint32_t dup;
+	uint64_t bytes;
+	uint32_t expected; /* max_seq - first_seq + 1 at the end of the interval */
+};
+
+struct perf_err_count {
+	int status;
+	uint32_t count;
+};
+
+struct perf_slot {
+	bool used;
+	uint32_t transaction_id;
+	uint32_t cycles;
+	uint32_t uptime_ms;
+};
+
+static struct {
+	bool running;
+	uint16_t session;
+	uint16_t len;
+	uint32_t rate;        /* SDUs per second, 0 = paced by TX completions */
+	uint32_t duration_ms;
+	uint32_t start_ms;
+	uint32_t interval_start_ms;
+	uint32_t next_seq;
+	uint32_t inflight;
+	struct perf_slot slots[PERF_TX_WINDOW];
+	struct perf_tx_counters interval;
+	struct perf_tx_counters total;
+	struct perf_err_count errors[PERF_ERR_CODES];
+} src;
+
+static struct {
+	bool armed;
+	bool active;
+	uint16_t session;
+	uint32_t long_rd_id;
+	uint32_t first_seq;
+	uint32_t max_seq;
+	uint64_t window; /* bit n set: max_seq - n received */
+	uint32_t start_ms;
+	uint32_t interval_start_ms;
+	uint32_t idle_intervals;
+	struct perf_rx_counters interval;
+	struct perf_rx_counters total;
+} sink;
+
+static K_MUTEX_DEFINE(perf_mutex);
+static uint8_t perf_tx_buf[APP_DLC_PAYLOAD_LEN_MAX];
+static uint16_t perf_session_counter;
+
+static void perf_tx_work_handler(struct k_work *work);
+static void perf_report_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(perf_tx_work, perf_tx_work_handler);
+static K_WORK_DELAYABLE_DEFINE(perf_report_work, perf_report_work_handler);
+
+/* ============================================================================
+ * COUNTERS
+ * ========================================================================== */
+
+static void tx_counters_reset(struct perf_tx_counters *c)
+{
+	memset(c, 0, sizeof(*c));
+	c->lat_min_us = UINT32_MAX;
+}
+
+static void tx_latency_add(struct perf_tx_counters *c, uint32_t lat_us)
+{
+	c->lat_n++;
+	c->lat_sum_us += lat_us;
+	c->lat_min_us = MIN(c->lat_min_us, lat_us);
+	c->lat_max_us = MAX(c->lat_max_us, lat_us);
+}
+
+static void tx_error_record(int status)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(src.errors); i++) {
+		if (src.errors[i].count != 0 && src.errors[i].status == status) {
+			src.errors[i].count++;
+			return;
+		}
+		if (src.errors[i].count == 0) {
+			src.errors[i].status = status;
+			src.errors[i].count = 1;
+			return;
+		}
+	}
+}
+
+/* kbit/s from bytes over ms: bytes * 8 / ms == kbit/s. */
+static uint32_t kbps(uint64_t bytes, uint32_t ms)
+{
+	return ms == 0 ? 0 : (uint32_t)((bytes * 8U) / ms);
+}
+
+static void tx_counters_print(const char *tag, const struct perf_tx_counters *c,
+			      uint32_t from_ms, uint32_t to_ms)
+{
+	printk("PERF TX %s %u.%03u-%u.%03u s: sent=%u ok=%u fail=%u err=%u timeout=%u "
+	       "goodput=%u kbit/s",
+	       tag, from_ms / 1000, from_ms % 1000, to_ms / 1000, to_ms % 1000,
+	       c->sent, c->acked, c->failed, c->send_err, c->timed_out,
+	       kbps(c->bytes_acked, to_ms - from_ms));
+	if (c->lat_n > 0) {
+		printk(" lat=%u/%u/%u us (min/avg/max)\n",
+		       c->lat_min_us, (uint32_t)(c->lat_sum_us / c->lat_n), c->lat_max_us);
+	} else {
+		printk("\n");
+	}
+}
+
+static void rx_counters_print(const char *tag, const struct perf_rx_counters *c,
+			      uint32_t from_ms, uint32_t to_ms)
+{
+	uint32_t lost = (c->expected > c->unique) ? c->expected - c->unique : 0;
+
+	printk("PERF RX %s %u.%03u-%u.%03u s: rd=%u rx=%u lost=%u reord=%u dup=%u "
+	       "goodput=%u kbit/s\n",
+	       tag, from_ms / 1000, from_ms % 1000, to_ms / 1000, to_ms % 1000,
+	       sink.long_rd_id, c->rx, lost, c->reordered, c->dup,
+	       kbps(c->bytes, to_ms - from_ms));
+}
+
+static void tx_errors_print(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(src.errors) && src.errors[i].count != 0; i++) {
+		printk("PERF TX   status %d: %u\n", src.errors[i].status, src.errors[i].count);
+	}
+}
+
+/* ============================================================================
+ * SOURCE
+ * ========================================================================== */
+
+static void source_finish(void)
+{
+	uint32_t now = k_uptime_get_32() - src.start_ms;
+
+	src.running = false;
+	k_work_cancel_delayable(&perf_tx_work);
+	tx_counters_print("total", &src.total, 0, now);
+	tx_errors_print();
+}
+
+/* Write off in-flight SDUs whose completion never arrived (e.g. link dropped). */
+static void source_expire_slots(uint32_t now_ms)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(src.slots); i++) {
+		if (src.slots[i].used && now_ms - src.slots[i].uptime_ms >= PERF_TX_TIMEOUT_MS) {
+			src.slots[i].used = false;
+			src.inflight--;
+			src.interval.timed_out++;
+			src.total.timed_out++;
+		}
+	}
+}
+
+static struct perf_slot *source_free_slot(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(src.slots); i++) {
+		if (!src.slots[i].used) {
+			return &src.slots[i];
+		}
+	}
+	return NULL;
+}
+
+static void perf_tx_work_handler(struct k_work *work)
+{
+	uint32_t now;
+	uint32_t elapsed;
+	int err = 0;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&perf_mutex, K_FOREVER);
+	if (!src.running) {
+		k_mutex_unlock(&perf_mutex);
+		return;
+	}
+
+	now = k_uptime_get_32();
+	elapsed = now - src.start_ms;
+	if (elapsed >= src.duration_ms) {
+		source_finish();
+		k_mutex_unlock(&perf_mutex);
+		return;
+	}
+
+	source_expire_slots(now);
+
+	while (src.inflight < PERF_TX_WINDOW) {
+		struct perf_slot *slot;
+		uint32_t transaction_id;
+
+		if (src.rate != 0 &&
+		    src.next_seq >= (uint32_t)(((uint64_t)elapsed * src.rate) / 1000U) + 1U) {
+			break;
+		}
+
+		perf_tx_buf[0] = PERF_MSG_DATA;
+		perf_tx_buf[1] = 0;
+		sys_put_le16(src.session, &perf_tx_buf[2]);
+		sys_put_le32(src.next_seq, &perf_tx_buf[4]);
+		sys_put_le32(now, &perf_tx_buf[8]);
+
+		slot = source_free_slot();
+		slot->cycles = k_cycle_get_32();
+		err = app_dlc_port_send(0, APP_DLC_PORT_PERF, perf_tx_buf, src.len, &transaction_id);
+		if (err != 0) {
+			src.interval.send_err++;
+			src.total.send_err++;
+			tx_error_record(err);
+			break;
+		}
+
+		slot->used = true;
+		slot->transaction_id = transaction_id;
+		slot->uptime_ms = now;
+		src.inflight++;
+		src.next_seq++;
+		src.interval.sent++;
+		src.total.sent++;
+	}
+
+	if (err == -ENOTCONN) {
+		printk("PERF: peer not associated, stopping source\n");
+		source_finish();
+	} else if (err != 0) {
+		k_work_reschedule(&perf_tx_work, K_MSEC(PERF_RETRY_MS));
+	} else if (src.inflight >= PERF_TX_WINDOW) {
+		/* Completions reschedule us; this only catches lost completions. */
+		k_work_reschedule(&perf_tx_work, K_MSEC(PERF_TX_TIMEOUT_MS));
+	} else if (src.rate != 0) {
+		uint32_t due_ms = (uint32_t)(((uint64_t)src.next_seq * 1000U) / src.rate);
+
+		k_work_reschedule(&perf_tx_work,
+				  K_MSEC(due_ms > elapsed ? due_ms - elapsed : 1));
+	}
+	k_mutex_unlock(&perf_mutex);
+}
+
+bool perf_tx_done(uint32_t transaction_id, int status)
+{
+	bool found = false;
+
+	k_mutex_lock(&perf_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(src.slots); i++) {
+		struct perf_slot *slot = &src.slots[i];
+		uint32_t lat_us;
+
+		if (!slot->used || slot->transaction_id != transaction_id) {
+			continue;
+		}
+
+		lat_us = k_cyc_to_us_floor32(k_cycle_get_32() - slot->cycles);
+		slot->used = false;
+		src.inflight--;
+		if (status == 0) {
+			src.interval.acked++;
+			src.total.acked++;
+			src.interval.bytes_acked += src.len;
+			src.total.bytes_acked += src.len;
+			tx_latency_add(&src.interval, lat_us);
+			tx_latency_add(&src.total, lat_us);
+		} else {
+			src.interval.failed++;
+			src.total.failed++;
+			tx_error_record(status);
+		}
+		found = true;
+		break;
+	}
+
+	if (found && src.running) {
+		k_work_reschedule(&perf_tx_work, K_NO_WAIT);
+	}
+	k_mutex_unlock(&perf_mutex);
+	return found;
+}
+
+/* ============================================================================
+ * SINK
+ * ========================================================================== */
+
+static void sink_start_session(uint32_t long_rd_id, uint16_t session, uint32_t seq)
+{
+	uint32_t now = k_uptime_get_32();
+
+	if (sink.active) {
+		rx_counters_print("total", &sink.total, 0, sink.interval_start_ms - sink.start_ms);
+	}
+
+	memset(&sink.interval, 0, sizeof(sink.interval));
+	memset(&sink.total, 0, sizeof(sink.total));
+	sink.active = true;
+	sink.session = session;
+	sink.long_rd_id = long_rd_id;
+	sink.first_seq = seq;
+	sink.max_seq = seq;
+	sink.window = 0;
+	sink.start_ms = now;
+	sink.interval_start_ms = now;
+	sink.idle_intervals = 0;
+	printk("PERF RX: session %u from rd=%u\n", session, long_rd_id);
+	k_work_reschedule(&perf_report_work, K_MSEC(CONFIG_APP_PERF_REPORT_INTERVAL_MS));
+}
+
+/* Classify one sequence number against a 64-entry sliding window. */
+static void sink_track_seq(uint32_t seq)
+{
+	bool is_new = true;
+	bool is_reordered = false;
+
+	if (seq > sink.max_seq) {
+		uint32_t shift = seq - sink.max_seq;
+
+		sink.window = (shift >= 64) ? 0 : (sink.window << shift);
+		sink.window |= 1;
+		sink.max_seq = seq;
+	} else {
+		uint32_t back = sink.max_seq - seq;
+
+		if (back < 64) {
+			if (sink.window & BIT64(back)) {
+				is_new = false;
+			} else {
+				sink.window |= BIT64(back);
+				is_reordered = true;
+			}
+		} else {
+			/* Too late to tell apart from a duplicate; count as reordered. */
+			is_reordered = true;
+		}
+		if (seq < sink.first_seq) {
+			sink.first_seq = seq;
+		}
+	}
+
+	if (!is_new) {
+		sink.interval.dup++;
+		sink.total.dup++;
+		return;
+	}
+	sink.interval.unique++;
+	sink.total.unique++;
+	if (is_reordered) {
+		sink.interval.reordered++;
+		sink.total.reordered++;
+	}
+}
+
+void perf_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	uint16_t session;
+	uint32_t seq;
+
+	if (len < PERF_HDR_LEN || data[0] != PERF_MSG_DATA) {
+		LOG_WRN("PERF: malformed SDU from rd=%u len=%zu", long_rd_id, len);
+		return;
+	}
+
+	session = sys_get_le16(&data[2]);
+	seq = sys_get_le32(&data[4]);
+
+	k_mutex_lock(&perf_mutex, K_FOREVER);
+	if (!sink.armed) {
+		k_mutex_unlock(&perf_mutex);
+		return;
+	}
+	if (!sink.active || session != sink.session || long_rd_id != sink.long_rd_id) {
+		sink_start_session(long_rd_id, session, seq);
+	}
+
+	sink.interval.rx++;
+	sink.total.rx++;
+	sink.interval.bytes += len;
+	sink.total.bytes += len;
+	sink_track_seq(seq);
+	k_mutex_unlock(&perf_mutex);
+}
+
+/* ============================================================================
+ * PERIODIC REPORT
+ * ========================================================================== */
+
+static void perf_report_work_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	bool again = false;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&perf_mutex, K_FOREVER);
+	if (src.running) {
+		tx_counters_print("", &src.interval, src.interval_start_ms - src.start_ms,
+				  now - src.start_ms);
+		tx_counters_reset(&src.interval);
+		src.interval_start_ms = now;
+		again = true;
+	}
+
+	if (sink.active) {
+		sink.total.expected = sink.max_seq - sink.first_seq + 1U;
+		sink.interval.expected = sink.total.expected -
+					 (sink.total.unique - sink.interval.unique);
+		if (sink.interval.rx == 0) {
+			sink.idle_intervals++;
+		} else {
+			sink.idle_intervals = 0;
+		}
+
+		if (sink.idle_intervals >= PERF_SINK_IDLE_INTERVALS) {
+			rx_counters_print("total", &sink.total, 0, sink.interval_start_ms - sink.start_ms);
+			sink.active = false;
+		} else {
+			rx_counters_print("", &sink.interval, sink.interval_start_ms - sink.start_ms,
+					  now - sink.start_ms);
+			memset(&sink.interval, 0, sizeof(sink.interval));
+			sink.interval_start_ms = now;
+			again = true;
+		}
+	}
+
+	if (again) {
+		k_work_reschedule(&perf_report_work, K_MSEC(CONFIG_APP_PERF_REPORT_INTERVAL_MS));
+	}
+	k_mutex_unlock(&perf_mutex);
+}
+
+/* ============================================================================
+ * SHELL COMMANDS
+ * ========================================================================== */
+
+static int perf_source_start(const struct shell *shell, size_t argc, char **argv)
+{
+	long len = (argc >= 3) ? strtol(argv[2], NULL, 10) : APP_DLC_PAYLOAD_LEN_MAX;
+	long rate = (argc >= 4) ? strtol(argv[3], NULL, 10) : 0;
+	long duration_s = (argc >= 5) ? strtol(argv[4], NULL, 10) : 10;
+
+	if (len < PERF_HDR_LEN || len > APP_DLC_PAYLOAD_LEN_MAX) {
+		shell_error(shell, "Size must be between %u and %u bytes", PERF_HDR_LEN,
+			    APP_DLC_PAYLOAD_LEN_MAX);
+		return -EINVAL;
+	}
+	if (rate < 0 || rate > 10000) {
+		shell_error(shell, "Rate must be 0 (completion paced) .. 10000 SDU/s");
+		return -EINVAL;
+	}
+	if (duration_s < 1 || duration_s > 3600) {
+		shell_error(shell, "Duration must be between 1 and 3600 s");
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&perf_mutex, K_FOREVER);
+	if (src.running) {
+		k_mutex_unlock(&perf_mutex);
+		shell_error(shell, "PERF source already running (PERF STOP first)");
+		return -EBUSY;
+	}
+
+	memset(&src, 0, sizeof(src));
+	tx_counters_reset(&src.interval);
+	tx_counters_reset(&src.total);
+	for (size_t i = PERF_HDR_LEN; i < sizeof(perf_tx_buf); i++) {
+		perf_tx_buf[i] = (uint8_t)i;
+	}
+	src.running = true;
+	src.session = ++perf_session_counter ^ (uint16_t)k_cycle_get_32();
+	src.len = (uint16_t)len;
+	src.rate = (uint32_t)rate;
+	src.duration_ms = (uint32_t)duration_s * 1000U;
+	src.start_ms = k_uptime_get_32();
+	src.interval_start_ms = src.start_ms;
+	k_work_reschedule(&perf_tx_work, K_NO_WAIT);
+	k_work_reschedule(&perf_report_work, K_MSEC(CONFIG_APP_PERF_REPORT_INTERVAL_MS));
+	k_mutex_unlock(&perf_mutex);
+
+	if (rate == 0) {
+		shell_print(shell, "PERF source: %ld B SDUs, completion paced (window %u), %ld s",
+			    len, PERF_TX_WINDOW, duration_s);
+	} else {
+		shell_print(shell, "PERF source: %ld B SDUs at %ld SDU/s, %ld s",
+			    len, rate, duration_s);
+	}
+	return 0;
+}
+
+static int cmd_perf(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc < 2) {
+		k_mutex_lock(&perf_mutex, K_FOREVER);
+		shell_print(shell, "PERF source: %s", src.running ? "running" : "stopped");
+		shell_print(shell, "PERF sink: %s%s", sink.armed ? "armed" : "off",
+			    sink.active ? " (receiving)" : "");
+		k_mutex_unlock(&perf_mutex);
+		shell_print(shell, "Usage: PERF SINK | PERF SOURCE [size] [rate SDU/s, 0=max] [seconds] | PERF STOP");
+		return 0;
+	}
+
+	if (strcmp(argv[1], "SOURCE") == 0 || strcmp(argv[1], "source") == 0) {
+		return perf_source_start(shell, argc, argv);
+	}
+
+	if (strcmp(argv[1], "SINK") == 0 || strcmp(argv[1], "sink") == 0) {
+		k_mutex_lock(&perf_mutex, K_FOREVER);
+		sink.armed = true;
+		k_mutex_unlock(&perf_mutex);
+		shell_print(shell, "PERF sink armed, reporting every %u ms",
+			    CONFIG_APP_PERF_REPORT_INTERVAL_MS);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "STOP") == 0 || strcmp(argv[1], "stop") == 0) {
+		k_mutex_lock(&perf_mutex, K_FOREVER);
+		if (src.running) {
+			source_finish();
+		}
+		if (sink.active) {
+			rx_counters_print("total", &sink.total, 0, k_uptime_get_32() - sink.start_ms);
+		}
+		sink.armed = false;
+		sink.active = false;
+		k_work_cancel_delayable(&perf_report_work);
+		k_mutex_unlock(&perf_mutex);
+		shell_print(shell, "PERF stopped");
+		return 0;
+	}
+
+	shell_error(shell, "Unknown PERF mode '%s'", argv[1]);
+	return -EINVAL;
+}
+
+SHELL_CMD_ARG_REGISTER(PERF, NULL, "PERF SINK | SOURCE [size] [rate] [s] | STOP — DLC throughput", cmd_perf, 1, 4);
+SHELL_CMD_ARG_REGISTER(perf, NULL, "perf sink | source [size] [rate] [s] | stop — dlc throughput", cmd_perf, 1, 4);
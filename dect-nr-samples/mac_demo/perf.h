@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PERF_H__
+#define PERF_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file perf.h
+ * @brief iperf-style DLC throughput benchmark (PERF shell command).
+ *
+ * The source streams sequence-numbered SDUs on APP_DLC_PORT_PERF through
+ * app_dlc_port_send(); the sink counts them. Both sides print goodput, loss,
+ * reordering, TX completion latency and TX error codes every
+ * CONFIG_APP_PERF_REPORT_INTERVAL_MS. Only app_dlc.h is used, so the benchmark
+ * runs unchanged on any dect_adapter implementation.
+ */
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_PERF.
+ *
+ * Called from the main event loop.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload (port byte stripped)
+ * @param len        Payload length
+ */
+void perf_rx(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+/**
+ * @brief Offer a DLC TX completion to the benchmark.
+ *
+ * Called from the main event loop for every dlc_data_tx completion.
+ *
+ * @param transaction_id Transaction ID of the completed SDU
+ * @param status         Modem completion status (0 = success)
+ * @return true if the transaction belonged to the PERF source
+ */
+bool perf_tx_done(uint32_t transaction_id, int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_H__ */
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "ping.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+#include "app_dlc.h"
+
+LOG_MODULE_REGISTER(ping, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Wire format after the port byte (little endian):
+ *   [0]     type (PING_MSG_REQUEST or PING_MSG_REPLY)
+ *   [1]     reserved
+ *   [2..3]  session ID, new for every PING run
+ *   [4..7]  sequence number, starts at 0
+ *   [8..15] sender uptime in us when the request was queued
+ * followed by filler up to the requested size. The responder echoes the
+ * request unchanged except for the type byte. */
+#define PING_MSG_REQUEST 1
+#define PING_MSG_REPLY   2
+#define PING_HDR_LEN     16
+#define PING_MAX_COUNT   CONFIG_APP_PING_MAX_COUNT
+#define PING_REPLY_TIMEOUT_MS 3000 /* wait after the last request before reporting */
+#define PING_HIST_BUCKETS 12       /* log2 buckets from <1 ms up to >= 1024 ms */
+
+static struct {
+	bool running;
+	uint16_t session;
+	uint16_t len;
+	uint32_t count;
+	uint32_t interval_ms;
+	uint32_t sent;
+	uint32_t send_err;
+	uint32_t received;
+	uint32_t dup;
+	uint32_t last_send_ms;
+	uint8_t seen[DIV_ROUND_UP(PING_MAX_COUNT, 8)];
+	uint32_t rtt_us[PING_MAX_COUNT];
+} ping;
+
+static K_MUTEX_DEFINE(ping_mutex);
+static uint8_t ping_tx_buf[APP_DLC_PAYLOAD_LEN_MAX];
+static uint8_t echo_tx_buf[APP_DLC_PAYLOAD_LEN_MAX];
+static uint16_t ping_session_counter;
+static uint32_t echo_reply_count;
+
+static void ping_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(ping_work, ping_work_handler);
+
+static uint64_t uptime_us(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile over sorted samples. */
+static uint32_t percentile(const uint32_t *sorted, uint32_t n, uint32_t pct)
+{
+	uint32_t rank = DIV_ROUND_UP(pct * n, 100U);
+
+	return sorted[(rank == 0) ? 0 : rank - 1];
+}
+
+/* Must be called with ping_mutex held. */
+static void ping_report(void)
+{
+	uint32_t n = ping.received;
+	uint32_t lost = ping.sent - ping.received;
+	uint32_t hist[PING_HIST_BUCKETS] = {0};
+
+	ping.running = false;
+	printk("PING: %u sent, %u received, %u%% loss, %u duplicate, %u send error(s)\n",
+	       ping.sent, n, ping.sent ? (100U * lost) / ping.sent : 0, ping.dup, ping.send_err);
+	if (n == 0) {
+		return;
+	}
+
+	qsort(ping.rtt_us, n, sizeof(ping.rtt_us[0]), cmp_u32);
+	printk("PING RTT us: min=%u median=%u p95=%u p99=%u max=%u\n",
+	       ping.rtt_us[0], percentile(ping.rtt_us, n, 50), percentile(ping.rtt_us, n, 95),
+	       percentile(ping.rtt_us, n, 99), ping.rtt_us[n - 1]);
+
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t ms = ping.rtt_us[i] / 1000U;
+		uint32_t b = 0;
+
+		while (ms != 0 && b < PING_HIST_BUCKETS - 1) {
+			ms >>= 1;
+			b++;
+		}
+		hist[b]++;
+	}
+	for (uint32_t b = 0; b < PING_HIST_BUCKETS; b++) {
+		if (hist[b] == 0) {
+			continue;
+		}
+		if (b == 0) {
+			printk("  < 1 ms      %u\n", hist[b]);
+		} else if (b == PING_HIST_BUCKETS - 1) {
+			printk("  >= %u ms  %u\n", 1U << (b - 1), hist[b]);
+		} else {
+			printk("  %u-%u ms  %u\n", 1U << (b - 1), (1U << b) - 1, hist[b]);
+		}
+	}
+}
+
+static void ping_work_handler(struct k_work *work)
+{
+	int err;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&ping_mutex, K_FOREVER);
+	if (!ping.running) {
+		k_mutex_unlock(&ping_mutex);
+		return;
+	}
+
+	if (ping.sent >= ping.count) {
+		/* Reply timeout after the last request. */
+		ping_report();
+		k_mutex_unlock(&ping_mutex);
+		return;
+	}
+
+	ping_tx_buf[0] = PING_MSG_REQUEST;
+	ping_tx_buf[1] = 0;
+	sys_put_le16(ping.session, &ping_tx_buf[2]);
+	sys_put_le32(ping.sent, &ping_tx_buf[4]);
+	sys_put_le64(uptime_us(), &ping_tx_buf[8]);
+
+	err = app_dlc_port_send(0, APP_DLC_PORT_ECHO, ping_tx_buf, ping.len, NULL);
+	if (err != 0) {
+		ping.send_err++;
+		printk("PING seq=%u send failed: %d\n", ping.sent, err);
+	}
+	ping.sent++;
+	ping.last_send_ms = k_uptime_get_32();
+
+	k_work_reschedule(&ping_work, K_MSEC(ping.sent < ping.count ?
+					     ping.interval_ms : PING_REPLY_TIMEOUT_MS));
+	k_mutex_unlock(&ping_mutex);
+}
+
+static void ping_reply_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	uint16_t session = sys_get_le16(&data[2]);
+	uint32_t seq = sys_get_le32(&data[4]);
+	uint64_t rtt_us = uptime_us() - sys_get_le64(&data[8]);
+
+	k_mutex_lock(&ping_mutex, K_FOREVER);
+	if (!ping.running || session != ping.session || seq >= ping.sent) {
+		k_mutex_unlock(&ping_mutex);
+		LOG_DBG("PING: stale reply seq=%u from rd=%u", seq, long_rd_id);
+		return;
+	}
+
+	if (ping.seen[seq / 8] & BIT(seq % 8)) {
+		ping.dup++;
+		k_mutex_unlock(&ping_mutex);
+		return;
+	}
+
+	ping.seen[seq / 8] |= BIT(seq % 8);
+	ping.rtt_us[ping.received++] = (uint32_t)MIN(rtt_us, (uint64_t)UINT32_MAX);
+	printk("PING reply from rd=%u: seq=%u len=%zu rtt=%u.%03u ms\n", long_rd_id, seq, len,
+	       (uint32_t)(rtt_us / 1000U), (uint32_t)(rtt_us % 1000U));
+
+	if (ping.received == ping.count) {
+		k_work_cancel_delayable(&ping_work);
+		ping_report();
+	}
+	k_mutex_unlock(&ping_mutex);
+}
+
+void ping_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	int err;
+
+	if (len < PING_HDR_LEN) {
+		LOG_WRN("ECHO: short SDU from rd=%u len=%zu", long_rd_id, len);
+		return;
+	}
+
+	switch (data[0]) {
+	case PING_MSG_REQUEST:
+		/* Event loop only: echo_tx_buf needs no lock. */
+		memcpy(echo_tx_buf, data, len);
+		echo_tx_buf[0] = PING_MSG_REPLY;
+		err = app_dlc_port_send(long_rd_id, APP_DLC_PORT_ECHO, echo_tx_buf, len, NULL);
+		if (err != 0) {
+			LOG_WRN("ECHO: reply to rd=%u failed: %d", long_rd_id, err);
+		} else {
+			echo_reply_count++;
+		}
+		break;
+	case PING_MSG_REPLY:
+		ping_reply_rx(long_rd_id, data, len);
+		break;
+	default:
+		LOG_WRN("ECHO: unknown type %u from rd=%u", data[0], long_rd_id);
+		break;
+	}
+}
+
+/* PING <count> <size> <interval_ms> */
+static int cmd_ping(const struct shell *shell, size_t argc, char **argv)
+{
+	long count = strtol(argv[1], NULL, 10);
+	long len = (argc >= 3) ? strtol(argv[2], NULL, 10) : 32;
+	long interval_ms = (argc >= 4) ? strtol(argv[3], NULL, 10) : 1000;
+
+	if (argc >= 2 && strcmp(argv[1], "0") == 0) {
+		/* PING 0: abort a running PING and report what was collected. */
+		k_mutex_lock(&ping_mutex, K_FOREVER);
+		if (ping.running) {
+			k_work_cancel_delayable(&ping_work);
+			ping_report();
+		}
+		k_mutex_unlock(&ping_mutex);
+		shell_print(shell, "Echo replies sent by this device: %u", echo_reply_count);
+		return 0;
+	}
+
+	if (count < 1 || count > PING_MAX_COUNT) {
+		shell_error(shell, "Count must be between 1 and %u", PING_MAX_COUNT);
+		return -EINVAL;
+	}
+	if (len < PING_HDR_LEN || len > APP_DLC_PAYLOAD_LEN_MAX) {
+		shell_error(shell, "Size must be between %u and %u bytes", PING_HDR_LEN,
+			    APP_DLC_PAYLOAD_LEN_MAX);
+		return -EINVAL;
+	}
+	if (interval_ms < 10 || interval_ms > 60000) {
+		shell_error(shell, "Interval must be between 10 and 60000 ms");
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ping_mutex, K_FOREVER);
+	if (ping.running) {
+		k_mutex_unlock(&ping_mutex);
+		shell_error(shell, "PING already running (PING 0 to abort)");
+		return -EBUSY;
+	}
+
+	memset(&ping, 0, sizeof(ping));
+	for (size_t i = PING_HDR_LEN; i < sizeof(ping_tx_buf); i++) {
+		ping_tx_buf[i] = (uint8_t)i;
+	}
+	ping.running = true;
+	ping.session = ++ping_session_counter ^ (uint16_t)k_cycle_get_32();
+	ping.count = (uint32_t)count;
+	ping.len = (uint16_t)len;
+	ping.interval_ms = (uint32_t)interval_ms;
+	k_work_reschedule(&ping_work, K_NO_WAIT);
+	k_mutex_unlock(&ping_mutex);
+
+	shell_print(shell, "PING: %ld x %ld B every %ld ms", count, len, interval_ms);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(PING, NULL, "PING <count|0> [size] [interval_ms] — DLC echo RTT", cmd_ping, 2, 2);
+SHELL_CMD_ARG_REGISTER(ping, NULL, "ping <count|0> [size] [interval_ms] — dlc echo rtt", cmd_ping, 2, 2);
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PING_H__
+#define PING_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ping.h
+ * @brief DLC echo responder and PING round-trip latency measurement.
+ *
+ * Echo requests and replies travel on APP_DLC_PORT_ECHO. Every device answers
+ * requests; PING <count> <size> <interval> sends requests to the associated
+ * peer and prints the RTT distribution (min, median, p95, p99, max) and the
+ * loss rate once all replies are in or have timed out.
+ */
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_ECHO.
+ *
+ * Requests are answered to the sender; replies complete the running PING.
+ * Called from the main event loop.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload (port byte stripped)
+ * @param len        Payload length
+ */
+void ping_rx(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PING_H__ */
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "power.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include "coalesce.h"
+
+LOG_MODULE_REGISTER(power, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define POWER_SAMPLE_MS 1000
+
+/* Airtime model. DECT NR+ slots are 416.7 us; the numbers are estimates for
+ * a 1.728 MHz channel, good enough to compare profiles, not to replace a
+ * power analyser. */
+#define POWER_BEACON_TX_US     420  /* one slot per cluster beacon */
+#define POWER_BEACON_RX_US     1250 /* beacon slot plus synchronisation margin */
+#define POWER_SDU_OVERHEAD_US  420  /* preamble, control header, HARQ feedback */
+
+/* Effective PHY rate in kbit/s for MCS 0..4. */
+static const uint16_t mcs_rate_kbps[] = { 400, 800, 1200, 1600, 2400 };
+
+static const struct power_profile profiles[] = {
+	{ .name = "perf",     .alias = "PERF",     .beacon_period_ms = 100,  .rach_fill_percentage = 100,
+	  .power_save = false, .batch_ms = 0 },
+	{ .name = "balanced", .alias = "BALANCED", .beacon_period_ms = 1000, .rach_fill_percentage = 50,
+	  .power_save = true,  .batch_ms = 50 },
+	{ .name = "battery",  .alias = "BATTERY",  .beacon_period_ms = 2000, .rach_fill_percentage = 20,
+	  .power_save = true,  .batch_ms = 500 },
+};
+
+static struct {
+	uint32_t last_ms;
+	uint64_t elapsed_ms;
+	uint64_t beacon_us;
+	uint64_t listen_us;
+	uint64_t tx_us;
+	uint64_t rx_us;
+	uint32_t tx_sdus;
+	uint32_t rx_sdus;
+	uint64_t tx_bytes;
+	uint64_t rx_bytes;
+	uint32_t lat_count;
+	uint64_t lat_sum_ms;
+	uint32_t lat_max_ms;
+	struct power_state last;
+} acct;
+
+static K_MUTEX_DEFINE(power_mutex);
+
+static void power_sample_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(power_sample_work, power_sample_handler);
+
+static uint32_t sdu_airtime_us(size_t len)
+{
+	uint32_t rate = mcs_rate_kbps[MIN(CONFIG_APP_MCS, (int)ARRAY_SIZE(mcs_rate_kbps) - 1)];
+
+	return POWER_SDU_OVERHEAD_US + (uint32_t)((len * 8U * 1000U) / rate);
+}
+
+/* Charge dt_ms spent in state st. Must be called with power_mutex held. */
+static void charge_locked(const struct power_state *st, uint32_t dt_ms)
+{
+	uint32_t period = (st->beacon_period_ms != 0) ? st->beacon_period_ms : 1000;
+	uint64_t beacon_us;
+
+	acct.elapsed_ms += dt_ms;
+
+	switch (st->activity) {
+	case POWER_ACTIVITY_FT:
+		acct.beacon_us += (uint64_t)dt_ms * POWER_BEACON_TX_US / period;
+		acct.listen_us += (uint64_t)dt_ms * 10U * st->rach_fill_percentage;
+		break;
+	case POWER_ACTIVITY_PT:
+		beacon_us = (uint64_t)dt_ms * POWER_BEACON_RX_US / period;
+		acct.beacon_us += beacon_us;
+		if (!st->power_save) {
+			/* Without power save the receiver idles between beacons. */
+			acct.listen_us += (uint64_t)dt_ms * 1000U - MIN(beacon_us,
+									 (uint64_t)dt_ms * 1000U);
+		}
+		break;
+	case POWER_ACTIVITY_SCAN:
+		acct.listen_us += (uint64_t)dt_ms * 1000U;
+		break;
+	default:
+		break;
+	}
+}
+
+static void power_sample_handler(struct k_work *work)
+{
+	struct power_state st;
+	uint32_t now = k_uptime_get_32();
+
+	ARG_UNUSED(work);
+
+	app_power_state_get(&st);
+
+	k_mutex_lock(&power_mutex, K_FOREVER);
+	charge_locked(&acct.last, now - acct.last_ms);
+	acct.last = st;
+	acct.last_ms = now;
+	k_mutex_unlock(&power_mutex);
+
+	k_work_reschedule(&power_sample_work, K_MSEC(POWER_SAMPLE_MS));
+}
+
+void power_init(void)
+{
+	k_mutex_lock(&power_mutex, K_FOREVER);
+	acct.last_ms = k_uptime_get_32();
+	k_mutex_unlock(&power_mutex);
+	k_work_reschedule(&power_sample_work, K_MSEC(POWER_SAMPLE_MS));
+}
+
+const struct power_profile *power_profile_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(profiles); i++) {
+		if (strcmp(profiles[i].name, name) == 0 || strcmp(profiles[i].alias, name) == 0) {
+			return &profiles[i];
+		}
+	}
+	return NULL;
+}
+
+const struct power_profile *power_profile_get(size_t idx)
+{
+	return (idx < ARRAY_SIZE(profiles)) ? &profiles[idx] : NULL;
+}
+
+void power_note_tx(size_t sdu_len, uint32_t latency_ms)
+{
+	k_mutex_lock(&power_mutex, K_FOREVER);
+	acct.tx_us += sdu_airtime_us(sdu_len);
+	acct.tx_sdus++;
+	acct.tx_bytes += sdu_len;
+	acct.lat_count++;
+	acct.lat_sum_ms += latency_ms;
+	acct.lat_max_ms = MAX(acct.lat_max_ms, latency_ms);
+	k_mutex_unlock(&power_mutex);
+}
+
+void power_note_rx(size_t sdu_len)
+{
+	k_mutex_lock(&power_mutex, K_FOREVER);
+	acct.rx_us += sdu_airtime_us(sdu_len);
+	acct.rx_sdus++;
+	acct.rx_bytes += sdu_len;
+	k_mutex_unlock(&power_mutex);
+}
+
+/* Name of the profile matching the sampled state, or "custom". Period and
+ * RACH fill are FT settings and only compared on an FT. */
+static const char *current_profile_name(const struct power_state *st, uint32_t batch_ms)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(profiles); i++) {
+		const struct power_profile *p = &profiles[i];
+
+		if (p->power_save != st->power_save || p->batch_ms != batch_ms) {
+			continue;
+		}
+		if (st->activity == POWER_ACTIVITY_FT &&
+		    (p->beacon_period_ms != st->beacon_period_ms ||
+		     p->rach_fill_percentage != st->rach_fill_percentage)) {
+			continue;
+		}
+		return p->name;
+	}
+	return "custom";
+}
+
+/* Radio-on time as seconds per hour, one decimal. */
+static void print_share(const struct shell *shell, const char *what, uint64_t us,
+			uint64_t elapsed_ms)
+{
+	uint32_t tenths = elapsed_ms ? (uint32_t)(us * 36U / elapsed_ms) : 0;
+
+	shell_print(shell, "  %-8s %u.%u s/h", what, tenths / 10U, tenths % 10U);
+}
+
+/* POWER [RESET] */
+static int cmd_power(const struct shell *shell, size_t argc, char **argv)
+{
+	uint64_t total_us;
+	uint32_t hundredths;
+	uint32_t batch_ms = coalesce_delay_get();
+
+	k_mutex_lock(&power_mutex, K_FOREVER);
+	if (argc >= 2) {
+		if (strcmp(argv[1], "RESET") != 0 && strcmp(argv[1], "reset") != 0) {
+			k_mutex_unlock(&power_mutex);
+			shell_error(shell, "Usage: POWER [RESET]");
+			return -EINVAL;
+		}
+		memset(&acct, 0, offsetof(typeof(acct), last));
+		acct.last_ms = k_uptime_get_32();
+		k_mutex_unlock(&power_mutex);
+		shell_print(shell, "Power accounting reset");
+		return 0;
+	}
+
+	/* Include the time since the last sample. */
+	charge_locked(&acct.last, k_uptime_get_32() - acct.last_ms);
+	acct.last_ms = k_uptime_get_32();
+
+	total_us = acct.beacon_us + acct.listen_us + acct.tx_us + acct.rx_us;
+	hundredths = acct.elapsed_ms ? (uint32_t)(total_us * 10U / acct.elapsed_ms) : 0;
+
+	shell_print(shell, "Profile: %s (beacon %u ms, RACH %u%%, power save %s, batching %u ms)",
+		    current_profile_name(&acct.last, batch_ms), acct.last.beacon_period_ms,
+		    acct.last.rach_fill_percentage, acct.last.power_save ? "on" : "off", batch_ms);
+	shell_print(shell, "Radio on (estimate) over %u s: %u.%02u%%",
+		    (uint32_t)(acct.elapsed_ms / 1000U), hundredths / 100U, hundredths % 100U);
+	print_share(shell, "total", total_us, acct.elapsed_ms);
+	print_share(shell, "beacons", acct.beacon_us, acct.elapsed_ms);
+	print_share(shell, "listen", acct.listen_us, acct.elapsed_ms);
+	print_share(shell, "TX data", acct.tx_us, acct.elapsed_ms);
+	print_share(shell, "RX data", acct.rx_us, acct.elapsed_ms);
+	shell_print(shell, "DLC: %u SDUs / %llu B sent, %u SDUs / %llu B received", acct.tx_sdus,
+		    (unsigned long long)acct.tx_bytes, acct.rx_sdus,
+		    (unsigned long long)acct.rx_bytes);
+	shell_print(shell, "TX latency (queued to TX completion): avg %u ms, max %u ms over %u SDUs; "
+		    "batching adds up to %u ms",
+		    acct.lat_count ? (uint32_t)(acct.lat_sum_ms / acct.lat_count) : 0,
+		    acct.lat_max_ms, acct.lat_count, batch_ms);
+	k_mutex_unlock(&power_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(POWER, NULL, "POWER [RESET] — estimated radio-on time and TX latency", cmd_power, 1, 1);
+SHELL_CMD_ARG_REGISTER(power, NULL, "power [reset] — estimated radio-on time and tx latency", cmd_power, 1, 1);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef POWER_H__
+#define POWER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file power.h
+ * @brief Named power profiles and estimated radio active-time accounting.
+ *
+ * A profile bundles the settings that trade battery life against latency:
+ * FT beacon period, RACH fill, modem power save and the uplink batching
+ * (SDU coalescing) window. PROFILE <name> applies one.
+ *
+ * Radio-on time is estimated, not measured: the application state is sampled
+ * every second and charged with the airtime of its scheduled operations
+ * (beacons, RACH listening, scanning, idle listening without power save),
+ * and every completed DLC TX and received SDU is charged with its airtime at
+ * CONFIG_APP_MCS. POWER prints the estimate per hour next to the measured
+ * TX latency.
+ */
+
+/** Radio activity class of the application, for the accounting model. */
+enum power_activity {
+	/** Radio off. */
+	POWER_ACTIVITY_IDLE,
+	/** FT: beaconing and listening on RACH resources. */
+	POWER_ACTIVITY_FT,
+	/** PT associated: receiving the parent's beacons. */
+	POWER_ACTIVITY_PT,
+	/** PT scanning or associating: receiver continuously on. */
+	POWER_ACTIVITY_SCAN,
+};
+
+/** Application state sampled by the accounting. */
+struct power_state {
+	enum power_activity activity;
+	uint32_t beacon_period_ms;
+	uint8_t rach_fill_percentage;
+	bool power_save;
+};
+
+/** A named power profile. */
+struct power_profile {
+	const char *name;
+	const char *alias;             /* upper-case name */
+	uint32_t beacon_period_ms;     /* FT cluster beacon period */
+	uint8_t rach_fill_percentage;  /* FT RACH fill */
+	bool power_save;
+	uint32_t batch_ms;             /* SDU coalescing delay, 0 = off */
+};
+
+/**
+ * @brief Sample the current application state.
+ *
+ * Provided by main.c. Called from the system work queue once per second.
+ *
+ * @param st Output state
+ */
+void app_power_state_get(struct power_state *st);
+
+/**
+ * @brief Start the once-per-second state sampling.
+ */
+void power_init(void);
+
+/**
+ * @brief Look up a profile by name, lower or upper case.
+ *
+ * @param name Profile name
+ * @return Profile, or NULL if there is none with that name
+ */
+const struct power_profile *power_profile_find(const char *name);
+
+/**
+ * @brief Get a profile by index, for listing.
+ *
+ * @param idx Index from 0
+ * @return Profile, or NULL past the last one
+ */
+const struct power_profile *power_profile_get(size_t idx);
+
+/**
+ * @brief Charge one completed DLC TX.
+ *
+ * @param sdu_len    SDU length in bytes
+ * @param latency_ms Time from queueing to the modem's TX completion
+ */
+void power_note_tx(size_t sdu_len, uint32_t latency_ms);
+
+/**
+ * @brief Charge one received DLC SDU.
+ *
+ * @param sdu_len SDU length in bytes
+ */
+void power_note_rx(size_t sdu_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWER_H__ */
@@ -0,0 +1,308 @@
+import argparse
+import base64
+import struct
+import sys
+import time
+
+import serial
+
+"""
+Host client for the mac_demo binary RPC channel (CONFIG_APP_RPC, see rpc.h).
+
+Frames are COBS-encoded and end in 0x00. A decoded frame is a message followed
+by CRC-16/CCITT-FALSE, little endian:
+  request:  [0x01][seq][op][args]
+  response: [0x02][seq][op][status int16][data]
+  event:    [0x03][event seq][event][data]
+
+Examples:
+  python3 mac_rpc.py /dev/ttyACM1 status
+  python3 mac_rpc.py /dev/ttyACM1 ft 1657
+  python3 mac_rpc.py /dev/ttyACM1 send 0 hello
+  python3 mac_rpc.py /dev/ttyACM1 sendhex 0 00ff10
+  python3 mac_rpc.py /dev/ttyACM1 exec "TXQ"
+  python3 mac_rpc.py /dev/ttyACM1 listen
+  python3 mac_rpc.py --baudrate 115200 /dev/ttyACM0 tlm   (console TLM lines, no RPC)
+
+Requires python 3.6 or f-strings and pyserial
+===========================================================================
+
+"""
+
+MSG_REQUEST = 0x01
+MSG_RESPONSE = 0x02
+MSG_EVENT = 0x03
+
+OP_PING = 0x01
+OP_STATUS = 0x02
+OP_SEND = 0x03
+OP_EXEC = 0x10
+OP_FT = 0x11
+OP_PT = 0x12
+OP_PT_SCAN = 0x13
+OP_STOP = 0x14
+OP_PERIOD = 0x15
+OP_POWERSAVE = 0x16
+OP_PROFILE = 0x17
+
+EVT_BEACON = 0x81
+EVT_ASSOCIATION = 0x82
+EVT_DLC_RX = 0x83
+EVT_TELEMETRY = 0x84
+
+TELEMETRY_HDR = "<BIHBBHII8IB"
+TELEMETRY_PEER = {1: "<IhIIII", 2: "<IhIIIIIIIIH"}
+RSSI_UNKNOWN = -32768
+
+MODES = {0: "IDLE", 1: "FT", 2: "PT"}
+ASSOC_STATES = {0: "released", 1: "associated", 2: "failed"}
+
+
+def crc16_ccitt_false(data: bytes) -> int:
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for b in data:
+        if b == 0:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(b)
+        code += 1
+        if code == 0xFF:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes:
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("bad COBS frame")
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def format_telemetry(data: bytes) -> str:
+    (version, uptime, seq, mode, assoc, carrier, dev, period, tx_ok, tx_fail, tx_bytes,
+     rx_sdus, rx_bytes, evt_drops, rx_drops, recoveries, peers) = \
+        struct.unpack_from(TELEMETRY_HDR, data)
+    lines = [f"telemetry v{version} #{seq} t={uptime} ms mode={MODES.get(mode, mode)} "
+             f"assoc={bool(assoc)} ch={carrier} rd={dev} period={period} ms "
+             f"tx ok={tx_ok} fail={tx_fail} ({tx_bytes} B) rx={rx_sdus} ({rx_bytes} B) "
+             f"evt_drops={evt_drops} rx_drops={rx_drops} recoveries={recoveries}"]
+    off = struct.calcsize(TELEMETRY_HDR)
+    peer_fmt = TELEMETRY_PEER.get(version, TELEMETRY_PEER[max(TELEMETRY_PEER)])
+    for _ in range(peers):
+        fields = struct.unpack_from(peer_fmt, data, off)
+        off += struct.calcsize(peer_fmt)
+        rd, rssi, p_ok, p_fail, p_rx, age = fields[:6]
+        rssi_text = "-" if rssi == RSSI_UNKNOWN else f"{rssi} dBm"
+        line = (f"  peer rd={rd} rssi={rssi_text} tx ok={p_ok} fail={p_fail} "
+                f"rx={p_rx} last rx {age} ms ago")
+        if len(fields) > 6 and fields[6]:
+            seq_rx, lost, dup, reord, jitter = fields[6:]
+            line += (f" seq rx={seq_rx} lost={lost} dup={dup} reordered={reord} "
+                     f"jitter={jitter / 16:.2f} ms")
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def format_event(evt: int, data: bytes) -> str:
+    if evt == EVT_BEACON and len(data) >= 17:
+        kind, ch, rd, nw, period, rssi = struct.unpack_from("<BHIIIh", data)
+        return (f"{'cluster' if kind else 'network'} beacon ch={ch} rd={rd} nw={nw} "
+                f"period={period} ms rssi={rssi} dBm")
+    if evt == EVT_ASSOCIATION and len(data) >= 7:
+        state, rd, status = struct.unpack_from("<BIh", data)
+        return f"association {ASSOC_STATES.get(state, state)} rd={rd} status={status}"
+    if evt == EVT_DLC_RX and len(data) >= 4:
+        rd = struct.unpack_from("<I", data)[0]
+        return f"rx rd={rd} len={len(data) - 4}: {data[4:].hex()}"
+    if evt == EVT_TELEMETRY and len(data) >= struct.calcsize(TELEMETRY_HDR):
+        return format_telemetry(data)
+    return f"event 0x{evt:02x}: {data.hex()}"
+
+
+class MacRpc:
+    def __init__(self, port: str, baudrate: int, timeout: float):
+        self.ser = serial.Serial(port, baudrate, timeout=0.1)
+        self.timeout = timeout
+        self.seq = 0
+        self.rx = bytearray()
+
+    def _read_message(self, deadline: float):
+        while time.monotonic() < deadline:
+            end = self.rx.find(b"\x00")
+            if end < 0:
+                self.rx += self.ser.read(self.ser.in_waiting or 1)
+                continue
+            frame = bytes(self.rx[:end])
+            del self.rx[:end + 1]
+            if not frame:
+                continue
+            try:
+                msg = cobs_decode(frame)
+            except ValueError:
+                continue
+            if len(msg) < 5 or crc16_ccitt_false(msg[:-2]) != struct.unpack("<H", msg[-2:])[0]:
+                print("dropped frame with bad CRC", file=sys.stderr)
+                continue
+            return msg[:-2]
+        return None
+
+    def call(self, op: int, args: bytes = b""):
+        self.seq = (self.seq + 1) & 0xFF
+        msg = bytes([MSG_REQUEST, self.seq, op]) + args
+        msg += struct.pack("<H", crc16_ccitt_false(msg))
+        self.ser.write(b"\x00" + cobs_encode(msg) + b"\x00")
+
+        deadline = time.monotonic() + self.timeout
+        while True:
+            msg = self._read_message(deadline)
+            if msg is None:
+                raise TimeoutError(f"no response to op 0x{op:02x}")
+            if msg[0] == MSG_EVENT:
+                print(format_event(msg[2], msg[3:]))
+                continue
+            if msg[0] == MSG_RESPONSE and msg[1] == self.seq and len(msg) >= 5:
+                status = struct.unpack_from("<h", msg, 3)[0]
+                return status, msg[5:]
+
+    def console_telemetry(self):
+        """Decode "TLM <base64>" lines printed on the console without CONFIG_APP_RPC."""
+        while True:
+            end = self.rx.find(b"\n")
+            if end < 0:
+                self.rx += self.ser.read(self.ser.in_waiting or 1)
+                continue
+            line = self.rx[:end].decode(errors="replace").strip()
+            del self.rx[:end + 1]
+            idx = line.find("TLM ")
+            if idx < 0:
+                continue
+            try:
+                frame = base64.b64decode(line[idx + 4:])
+            except ValueError:
+                continue
+            if len(frame) < 3 or crc16_ccitt_false(frame[:-2]) != \
+                    struct.unpack("<H", frame[-2:])[0]:
+                print("dropped TLM line with bad CRC", file=sys.stderr)
+                continue
+            print(format_telemetry(frame[:-2]), flush=True)
+
+    def listen(self):
+        while True:
+            msg = self._read_message(time.monotonic() + 1.0)
+            if msg is not None and msg[0] == MSG_EVENT:
+                print(format_event(msg[2], msg[3:]), flush=True)
+
+
+def print_status(data: bytes):
+    mode, assoc, carrier, dev, peer, period, rach, ps, dropped, evt_drops, recoveries = \
+        struct.unpack_from("<BBHIIIBBIII", data)
+    print(f"mode={MODES.get(mode, mode)} associated={bool(assoc)} carrier={carrier}")
+    print(f"device rd={dev} peer rd={peer} beacon period={period} ms")
+    print(f"rach fill={rach}% power save={bool(ps)} dlc rx dropped={dropped}")
+    print(f"events dropped={evt_drops} pt recoveries={recoveries}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="mac_demo binary RPC client")
+    parser.add_argument("port", help="RPC UART, e.g. /dev/ttyACM1")
+    parser.add_argument("--baudrate", type=int, default=1000000)
+    parser.add_argument("--timeout", type=float, default=30.0,
+                        help="response timeout in seconds (FT and PT run scans)")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    sub.add_parser("ping")
+    sub.add_parser("status")
+    p = sub.add_parser("send", help="send text to rd (0 = associated peer)")
+    p.add_argument("rd", type=int)
+    p.add_argument("text")
+    p = sub.add_parser("sendhex", help="send hex bytes to rd (0 = associated peer)")
+    p.add_argument("rd", type=int)
+    p.add_argument("hex")
+    p = sub.add_parser("exec", help="run a shell command line")
+    p.add_argument("line")
+    p = sub.add_parser("ft")
+    p.add_argument("channel", type=int, nargs="?", default=0)
+    p = sub.add_parser("pt")
+    p.add_argument("channel", type=int)
+    p = sub.add_parser("pt_scan")
+    p.add_argument("channel", type=int, nargs="?", default=0)
+    sub.add_parser("stop")
+    p = sub.add_parser("period")
+    p.add_argument("ms", type=int)
+    p = sub.add_parser("powersave")
+    p.add_argument("on", type=int, choices=[0, 1])
+    p = sub.add_parser("profile")
+    p.add_argument("name")
+    sub.add_parser("listen", help="print events until interrupted")
+    sub.add_parser("tlm", help="decode TLM lines on the console UART until interrupted")
+    args = parser.parse_args()
+
+    rpc = MacRpc(args.port, args.baudrate, args.timeout)
+
+    if args.cmd in ("listen", "tlm"):
+        try:
+            if args.cmd == "listen":
+                rpc.listen()
+            else:
+                rpc.console_telemetry()
+        except KeyboardInterrupt:
+            pass
+        return 0
+
+    requests = {
+        "ping": lambda: (OP_PING, b""),
+        "status": lambda: (OP_STATUS, b""),
+        "send": lambda: (OP_SEND, struct.pack("<I", args.rd) + args.text.encode()),
+        "sendhex": lambda: (OP_SEND, struct.pack("<I", args.rd) + bytes.fromhex(args.hex)),
+        "exec": lambda: (OP_EXEC, args.line.encode()),
+        "ft": lambda: (OP_FT, struct.pack("<H", args.channel)),
+        "pt": lambda: (OP_PT, struct.pack("<H", args.channel)),
+        "pt_scan": lambda: (OP_PT_SCAN, struct.pack("<H", args.channel)),
+        "stop": lambda: (OP_STOP, b""),
+        "period": lambda: (OP_PERIOD, struct.pack("<I", args.ms)),
+        "powersave": lambda: (OP_POWERSAVE, bytes([args.on])),
+        "profile": lambda: (OP_PROFILE, args.name.encode()),
+    }
+    op, op_args = requests[args.cmd]()
+    status, data = rpc.call(op, op_args)
+
+    if status != 0:
+        print(f"error {status}")
+    elif args.cmd == "ping":
+        uptime, version = struct.unpack_from("<IB", data)
+        print(f"uptime={uptime} ms protocol={version}")
+    elif args.cmd == "status":
+        print_status(data)
+    if data and args.cmd == "exec":
+        print(data.decode(errors="replace"), end="")
+    return 0 if status == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
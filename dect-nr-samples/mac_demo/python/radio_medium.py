@@ -0,0 +1,318 @@
+"""Simulated DECT NR+ radio medium for mac_demo native_sim builds (CONFIG_APP_SIM_RADIO).
+
+Every zephyr.exe instance sends its frames here over UDP (dect_adapter_sim.c); the
+medium decides who hears what and forwards the frames:
+  - path loss per link (default --path-loss, override with --link A:B:dB),
+    RSSI = --tx-power - loss, frames below --sensitivity are not heard
+  - packet error rate (--per, per link with --link-per A:B:p), raised by channel
+    load: a frame is also lost with probability busy% * --collision
+  - channel load = background (--load CH:percent) + airtime measured over the
+    last second; reported to RSSI scans as busy percentage
+  - a relay (FT associated upstream) listens on two channels, its own and its
+    parent's
+  - unicast frames need both ends on the same channel and get --harq retries,
+    DATA completions (TX_RESULT) come back after the airtime of all attempts
+
+It records association time per PT, from its first all-channel scan (or from
+the restart of its FT) to the accepted association response, and delivered
+DATA bytes per link.
+
+Examples:
+  python3 radio_medium.py
+  python3 radio_medium.py --per 0.05 --load 1659:60 --link 1:2:95 --json metrics.json
+"""
+
+import argparse
+import heapq
+import json
+import random
+import select
+import socket
+import struct
+import sys
+import time
+from collections import defaultdict, deque
+
+MSG_TUNE = 0x01
+MSG_BEACON = 0x02
+MSG_ASSOC_REQ = 0x03
+MSG_ASSOC_RESP = 0x04
+MSG_RELEASE = 0x05
+MSG_DATA = 0x06
+MSG_TX_RESULT = 0x07
+MSG_RSSI_REQ = 0x08
+MSG_RSSI_RESULT = 0x09
+
+CHANNEL_ALL = 0
+CHANNEL_OFF = 0xFFFF
+TX_STATUS_FAIL = 1   # non-zero completion, as a modem HARQ failure
+SLOT_S = 0.000417    # one DECT NR+ slot
+LOAD_WINDOW_S = 1.0
+
+
+class Node:
+    def __init__(self, rd: int, addr):
+        self.rd = rd
+        self.addr = addr
+        self.channel = CHANNEL_OFF
+        self.channel2 = CHANNEL_OFF   # relay: second receive channel (its parent's)
+        self.parent = None
+        self.scan_start = None
+
+    def listens(self, channel: int) -> bool:
+        return channel in (self.channel, self.channel2) or self.channel == CHANNEL_ALL
+
+
+class Medium:
+    def __init__(self, args):
+        self.args = args
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.bind((args.host, args.port))
+        self.nodes = {}           # addr -> Node
+        self.by_rd = {}           # rd -> Node
+        self.queue = []           # (due, seq, addr, datagram)
+        self.qseq = 0
+        self.airtime = defaultdict(deque)  # channel -> deque of (end time, seconds)
+        self.rng = random.Random(args.seed)
+        self.t0 = time.monotonic()
+        self.assoc_times = defaultdict(list)      # PT rd -> [seconds]
+        self.rx_bytes = defaultdict(int)          # "src->dst" -> bytes
+        self.tx_frames = defaultdict(lambda: [0, 0])  # "src->dst" -> [ok, failed]
+        self.beacons = 0
+
+    # -- link model -----------------------------------------------------------
+
+    def _link(self, table, a: int, b: int, default):
+        return table.get((a, b), table.get((b, a), default))
+
+    def rssi(self, src: int, dst: int) -> int:
+        return int(self.args.tx_power - self._link(self.args.link_loss, src, dst,
+                                                   self.args.path_loss))
+
+    def busy(self, channel: int, now: float) -> float:
+        window = self.airtime[channel]
+        while window and window[0][0] < now - LOAD_WINDOW_S:
+            window.popleft()
+        measured = sum(s for _, s in window) / LOAD_WINDOW_S
+        return min(1.0, self.args.load.get(channel, 0) / 100.0 + measured)
+
+    def heard(self, src: int, dst: int, channel: int, now: float) -> bool:
+        if self.rssi(src, dst) < self.args.sensitivity:
+            return False
+        per = self._link(self.args.link_per, src, dst, self.args.per)
+        per = 1 - (1 - per) * (1 - self.busy(channel, now) * self.args.collision)
+        return self.rng.random() >= per
+
+    def frame_airtime(self, payload_len: int) -> float:
+        return SLOT_S + payload_len * 8 / self.args.bitrate
+
+    # -- delivery -------------------------------------------------------------
+
+    def post(self, due: float, node: Node, msg_type: int, src: int, rssi: int, body: bytes):
+        self.qseq += 1
+        dgram = struct.pack("<BIh", msg_type, src, rssi) + body
+        heapq.heappush(self.queue, (due, self.qseq, node.addr, dgram))
+
+    def flush(self, now: float):
+        while self.queue and self.queue[0][0] <= now:
+            _, _, addr, dgram = heapq.heappop(self.queue)
+            self.sock.sendto(dgram, addr)
+
+    def unicast(self, now: float, src: Node, dst_rd: int, msg_type: int, body: bytes,
+                payload_len: int):
+        """Deliver with HARQ; returns (delivered, completion time)."""
+        dst = self.by_rd.get(dst_rd)
+        air = self.frame_airtime(payload_len)
+        # A relay is on two channels; send on the one the destination is on.
+        channel = src.channel
+        if dst is not None and src.channel2 != CHANNEL_OFF and \
+                src.channel not in (dst.channel, dst.channel2):
+            channel = src.channel2
+        t = now
+        for _ in range(1 + self.args.harq):
+            t += air
+            self.airtime[channel].append((t, air))
+            if dst is None or channel in (CHANNEL_ALL, CHANNEL_OFF) or \
+                    channel not in (dst.channel, dst.channel2):
+                continue
+            if self.heard(src.rd, dst.rd, channel, now):
+                self.post(t, dst, msg_type, src.rd, self.rssi(src.rd, dst.rd), body)
+                return True, t
+        return False, t
+
+    def handle(self, data: bytes, addr, now: float):
+        if len(data) < 5:
+            return
+        msg_type, rd = struct.unpack_from("<BI", data)
+        body = data[5:]
+        node = self.nodes.get(addr)
+        if node is None or node.rd != rd:
+            old = self.by_rd.get(rd)
+            if old is not None and old.addr != addr:
+                del self.nodes[old.addr]   # restarted instance, new socket
+                for child in self.nodes.values():
+                    if child.parent == rd:
+                        child.parent = None
+                        child.scan_start = now
+            node = Node(rd, addr)
+            self.nodes[addr] = node
+            self.by_rd[rd] = node
+
+        if msg_type == MSG_TUNE and len(body) >= 2:
+            node.channel = struct.unpack_from("<H", body)[0]
+            node.channel2 = struct.unpack_from("<H", body, 2)[0] if len(body) >= 4 else CHANNEL_OFF
+            if node.channel == CHANNEL_ALL and node.parent is None and node.scan_start is None:
+                node.scan_start = now
+        elif msg_type == MSG_BEACON and len(body) >= 11:
+            channel = struct.unpack_from("<H", body, 1)[0]
+            self.beacons += 1
+            self.airtime[channel].append((now, SLOT_S))
+            for other in list(self.nodes.values()):
+                if other is node or not other.listens(channel):
+                    continue
+                if self.heard(rd, other.rd, channel, now):
+                    self.post(now + SLOT_S, other, msg_type, rd, self.rssi(rd, other.rd), body)
+        elif msg_type in (MSG_ASSOC_REQ, MSG_ASSOC_RESP, MSG_RELEASE) and len(body) >= 4:
+            dst_rd = struct.unpack_from("<I", body)[0]
+            delivered, _ = self.unicast(now, node, dst_rd, msg_type, body, len(body))
+            if msg_type == MSG_RELEASE:
+                for a, b in ((node, dst_rd), (self.by_rd.get(dst_rd), rd)):
+                    if a is not None and a.parent == b:
+                        a.parent = None
+            if delivered and msg_type == MSG_ASSOC_RESP and \
+                    struct.unpack_from("<h", body, 4)[0] == 0:
+                pt = self.by_rd.get(dst_rd)
+                if pt is not None:
+                    pt.parent = rd
+                if pt is not None and pt.scan_start is not None:
+                    seconds = now - pt.scan_start
+                    self.assoc_times[dst_rd].append(round(seconds, 3))
+                    pt.scan_start = None
+                    print(f"[{now - self.t0:8.3f}] PT {dst_rd} associated with {rd} "
+                          f"after {seconds:.3f} s", flush=True)
+        elif msg_type == MSG_DATA and len(body) >= 9:
+            dst_rd, txid = struct.unpack_from("<II", body)
+            payload_len = len(body) - 9
+            delivered, done = self.unicast(now, node, dst_rd, msg_type, body, payload_len)
+            key = f"{rd}->{dst_rd}"
+            self.tx_frames[key][0 if delivered else 1] += 1
+            if delivered:
+                self.rx_bytes[key] += payload_len
+            status = 0 if delivered else TX_STATUS_FAIL
+            self.post(done, node, MSG_TX_RESULT, 0, 0, struct.pack("<Ih", txid, status))
+        elif msg_type == MSG_RSSI_REQ and len(body) >= 2:
+            channel = struct.unpack_from("<H", body)[0]
+            busy = int(round(self.busy(channel, now) * 100))
+            self.post(now + 0.002, node, MSG_RSSI_RESULT, 0, 0,
+                      struct.pack("<HB", channel, busy))
+
+    # -- metrics --------------------------------------------------------------
+
+    def metrics(self) -> dict:
+        elapsed = time.monotonic() - self.t0
+        return {
+            "elapsed_s": round(elapsed, 3),
+            "nodes": sorted(self.by_rd),
+            "beacons": self.beacons,
+            "association_s": {str(k): v for k, v in self.assoc_times.items()},
+            "rx_bytes": dict(self.rx_bytes),
+            "tx_frames": {k: {"ok": v[0], "failed": v[1]} for k, v in self.tx_frames.items()},
+            "throughput_bps": {k: round(v * 8 / elapsed) for k, v in self.rx_bytes.items()}
+            if elapsed > 0 else {},
+        }
+
+    def report(self):
+        m = self.metrics()
+        print(f"[{m['elapsed_s']:8.3f}] nodes={len(m['nodes'])} beacons={m['beacons']} "
+              f"delivered={sum(self.rx_bytes.values())} B", flush=True)
+        for key, bps in m["throughput_bps"].items():
+            ok, failed = self.tx_frames[key]
+            print(f"           {key}: {bps / 1000:.1f} kbit/s avg, ok={ok} failed={failed}",
+                  flush=True)
+
+    def run(self, duration: float = 0.0, stop=None):
+        next_report = time.monotonic() + self.args.report
+        end = time.monotonic() + duration if duration > 0 else None
+        while stop is None or not stop.is_set():
+            now = time.monotonic()
+            if end is not None and now >= end:
+                break
+            timeout = 0.05
+            if self.queue:
+                timeout = max(0.0, min(timeout, self.queue[0][0] - now))
+            readable, _, _ = select.select([self.sock], [], [], timeout)
+            now = time.monotonic()
+            if readable:
+                try:
+                    data, addr = self.sock.recvfrom(4096)
+                except ConnectionError:
+                    data = None
+                if data:
+                    self.handle(data, addr, now)
+            self.flush(now)
+            if self.args.report > 0 and now >= next_report:
+                self.report()
+                next_report = now + self.args.report
+
+
+def parse_pairs(values, conv):
+    table = {}
+    for v in values or []:
+        a, b, x = v.split(":")
+        table[(int(a), int(b))] = conv(x)
+    return table
+
+
+def parse_load(values):
+    return {int(ch): float(pct) for ch, pct in (v.split(":") for v in values or [])}
+
+
+def build_parser() -> argparse.ArgumentParser:
+    parser = argparse.ArgumentParser(description="mac_demo simulated radio medium")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=17100)
+    parser.add_argument("--tx-power", type=float, default=19.0, help="dBm")
+    parser.add_argument("--path-loss", type=float, default=80.0, help="default link loss, dB")
+    parser.add_argument("--sensitivity", type=float, default=-100.0, help="dBm")
+    parser.add_argument("--link", action="append", metavar="RD_A:RD_B:DB",
+                        help="path loss of one link (repeatable)")
+    parser.add_argument("--per", type=float, default=0.0, help="packet error rate, 0..1")
+    parser.add_argument("--link-per", action="append", metavar="RD_A:RD_B:PER",
+                        help="packet error rate of one link (repeatable)")
+    parser.add_argument("--load", action="append", metavar="CHANNEL:PERCENT",
+                        help="background load on a channel (repeatable)")
+    parser.add_argument("--collision", type=float, default=0.5,
+                        help="share of busy airtime that destroys a frame")
+    parser.add_argument("--harq", type=int, default=3, help="retransmissions per unicast frame")
+    parser.add_argument("--bitrate", type=float, default=1.0e6, help="bit/s while on air")
+    parser.add_argument("--seed", type=int, default=None)
+    parser.add_argument("--duration", type=float, default=0.0, help="seconds, 0 = forever")
+    parser.add_argument("--report", type=float, default=5.0, help="report interval, 0 = off")
+    parser.add_argument("--json", help="write metrics here on exit")
+    return parser
+
+
+def finish_args(args):
+    args.link_loss = parse_pairs(args.link, float)
+    args.link_per = parse_pairs(args.link_per, float)
+    args.load = parse_load(args.load)
+    return args
+
+
+def main():
+    args = finish_args(build_parser().parse_args())
+    medium = Medium(args)
+    print(f"radio medium on {args.host}:{args.port}", flush=True)
+    try:
+        medium.run(args.duration)
+    except KeyboardInterrupt:
+        pass
+    medium.report()
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(medium.metrics(), f, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
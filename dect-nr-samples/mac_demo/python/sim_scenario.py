@@ -0,0 +1,201 @@
+"""FT + N PT scenario on native_sim for CI (CONFIG_APP_SIM_RADIO, prj_sim.conf).
+
+Starts the radio medium in-process and one zephyr.exe per device, drives them
+through their shell on stdin/stdout, and reports as JSON:
+  - association time of every PT (and reassociation time after --ft-restart)
+  - DATA throughput per PT -> FT link while all PTs run PERF SOURCE
+Device logs go to <logdir>/rd<N>.log. Exits 1 when a PT never associates or a
+limit (--max-assoc-s, --min-kbps) is missed.
+
+Examples:
+  python3 sim_scenario.py build/zephyr/zephyr.exe --pts 3
+  python3 sim_scenario.py zephyr.exe --pts 4 --per 0.05 --ft-restart --json out.json
+"""
+
+import argparse
+import json
+import os
+import queue
+import re
+import subprocess
+import sys
+import threading
+import time
+
+import radio_medium
+
+FT_RD = 1
+BOOT_TIMEOUT_S = 10.0
+
+
+class Device:
+    def __init__(self, exe: str, rd: int, port: int, logdir: str):
+        self.rd = rd
+        self.lines = queue.Queue()
+        self.log = open(os.path.join(logdir, f"rd{rd}.log"), "a")
+        self.proc = subprocess.Popen(
+            [exe, "-rt", f"--device_id={rd}", f"--dect_medium=127.0.0.1:{port}"],
+            stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        threading.Thread(target=self._reader, daemon=True).start()
+
+    def _reader(self):
+        for raw in self.proc.stdout:
+            line = raw.decode(errors="replace").rstrip()
+            self.log.write(line + "\n")
+            self.lines.put(line)
+
+    def cmd(self, line: str):
+        self.log.write(f">>> {line}\n")
+        self.proc.stdin.write((line + "\n").encode())
+        self.proc.stdin.flush()
+
+    def wait_match(self, pattern: str, timeout: float):
+        """First output line matching the regex pattern, or None on timeout."""
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            try:
+                m = re.search(pattern, self.lines.get(timeout=0.1))
+            except queue.Empty:
+                continue
+            if m:
+                return m
+        return None
+
+    def wait_for(self, text: str, timeout: float) -> bool:
+        return self.wait_match(re.escape(text), timeout) is not None
+
+    def stop(self):
+        self.proc.kill()
+        self.proc.wait()
+        self.log.close()
+
+
+def start_ft(exe: str, port: int, logdir: str, channel: int) -> Device:
+    ft = Device(exe, FT_RD, port, logdir)
+    ft.wait_for("dect_adapter_init: 0", BOOT_TIMEOUT_S)
+    if not channel:
+        # SCAN only reports the best channel; FT <ch> beacons on it.
+        ft.cmd("SCAN")
+        m = ft.wait_match(r"Best channel: (\d+)", 60.0)
+        if not m:
+            raise RuntimeError("FT RSSI scan found no channel")
+        channel = int(m.group(1))
+    ft.cmd(f"FT {channel}")
+    if not ft.wait_for("FT BEACONING - Cluster configured", 30.0):
+        raise RuntimeError("FT did not start beaconing")
+    return ft
+
+
+def start_pt(exe: str, rd: int, port: int, logdir: str) -> Device:
+    pt = Device(exe, rd, port, logdir)
+    pt.wait_for("dect_adapter_init: 0", BOOT_TIMEOUT_S)
+    # PT needs the FT's channel: find it with an all-channel PT_SCAN first.
+    pt.cmd("PT_SCAN")
+    m = pt.wait_match(rf"Beacon ch=(\d+) rd={FT_RD} ", 60.0)
+    if not m:
+        pt.stop()
+        raise RuntimeError(f"PT rd {rd} heard no beacon from the FT")
+    pt.cmd(f"PT {m.group(1)}")
+    return pt
+
+
+def wait_associations(medium, rds, count: int, timeout: float) -> bool:
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        if all(len(medium.assoc_times.get(rd, [])) >= count for rd in rds):
+            return True
+        time.sleep(0.1)
+    return False
+
+
+def main():
+    parser = argparse.ArgumentParser(description="mac_demo native_sim FT + N PT scenario",
+                                     parents=[radio_medium.build_parser()],
+                                     conflict_handler="resolve")
+    parser.add_argument("exe", help="native_sim zephyr.exe built with prj_sim.conf")
+    parser.add_argument("--pts", type=int, default=2)
+    parser.add_argument("--channel", type=int, default=0,
+                        help="FT channel (0 = RSSI scan picks one)")
+    parser.add_argument("--assoc-timeout", type=float, default=60.0)
+    parser.add_argument("--sdu", type=int, default=500, help="PERF SOURCE SDU size")
+    parser.add_argument("--rate", type=int, default=0, help="PERF SOURCE SDU/s, 0 = max")
+    parser.add_argument("--traffic-s", type=int, default=10)
+    parser.add_argument("--ft-restart", action="store_true",
+                        help="restart the FT after traffic and measure reassociation")
+    parser.add_argument("--max-assoc-s", type=float, default=0.0, help="0 = no limit")
+    parser.add_argument("--min-kbps", type=float, default=0.0,
+                        help="minimum total throughput, 0 = no limit")
+    parser.add_argument("--logdir", default="sim_logs")
+    args = radio_medium.finish_args(parser.parse_args())
+    args.report = 0
+    os.makedirs(args.logdir, exist_ok=True)
+
+    medium = radio_medium.Medium(args)
+    stop = threading.Event()
+    threading.Thread(target=medium.run, kwargs={"stop": stop}, daemon=True).start()
+
+    pt_rds = [FT_RD + 1 + i for i in range(args.pts)]
+    devices = []
+    failures = []
+    try:
+        ft = start_ft(args.exe, args.port, args.logdir, args.channel)
+        devices.append(ft)
+        for rd in pt_rds:
+            devices.append(start_pt(args.exe, rd, args.port, args.logdir))
+        if not wait_associations(medium, pt_rds, 1, args.assoc_timeout):
+            failures.append("not every PT associated")
+
+        ft.cmd("PERF SINK")
+        rx_before = dict(medium.rx_bytes)
+        t_start = time.monotonic()
+        for pt in devices[1:]:
+            pt.cmd(f"PERF SOURCE {args.sdu} {args.rate} {args.traffic_s}")
+        time.sleep(args.traffic_s + 1)
+        traffic_s = time.monotonic() - t_start
+        kbps = {}
+        for rd in pt_rds:
+            key = f"{rd}->{FT_RD}"
+            delivered = medium.rx_bytes.get(key, 0) - rx_before.get(key, 0)
+            kbps[key] = round(delivered * 8 / traffic_s / 1000, 1)
+
+        if args.ft_restart:
+            ft.stop()
+            devices.remove(ft)
+            ft = start_ft(args.exe, args.port, args.logdir, args.channel)
+            devices.append(ft)
+            if not wait_associations(medium, pt_rds, 2, args.assoc_timeout):
+                failures.append("not every PT reassociated after FT restart")
+    except RuntimeError as e:
+        failures.append(str(e))
+        kbps = {}
+    finally:
+        for dev in devices:
+            dev.stop()
+        stop.set()
+
+    assoc = {rd: medium.assoc_times.get(rd, []) for rd in pt_rds}
+    if args.max_assoc_s > 0:
+        slow = [rd for rd, t in assoc.items() if any(s > args.max_assoc_s for s in t)]
+        if slow:
+            failures.append(f"association slower than {args.max_assoc_s} s: rd {slow}")
+    total_kbps = round(sum(kbps.values()), 1)
+    if args.min_kbps > 0 and total_kbps < args.min_kbps:
+        failures.append(f"throughput {total_kbps} kbit/s below {args.min_kbps}")
+
+    result = {
+        "pts": args.pts,
+        "association_s": {str(rd): t for rd, t in assoc.items()},
+        "throughput_kbps": kbps,
+        "throughput_total_kbps": total_kbps,
+        "medium": medium.metrics(),
+        "failures": failures,
+    }
+    print(json.dumps(result, indent=2))
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(result, f, indent=2)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
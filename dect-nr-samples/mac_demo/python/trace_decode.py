@@ -0,0 +1,133 @@
+import argparse
+import base64
+import os
+import re
+import struct
+import sys
+
+"""
+Decoder for the mac_demo binary trace (CONFIG_APP_TRACE, see trace.h).
+
+TRACE DUMP prints "TRC <base64>" lines. A decoded line is, little endian:
+  [u8 version][u32 ticks per second][u32 sequence of the first record]
+  [records: u32 ticks, u16 id, i16 a0, u32 a1, u32 a2]...
+  [u16 CRC-16/CCITT-FALSE of everything before it]
+
+Event names and format strings come from trace_events.h: IDs are assigned in
+order from 1, so the decoder must read the same file the firmware was built
+with.
+
+Examples:
+  python3 trace_decode.py dump.txt            (console log saved to a file)
+  python3 trace_decode.py - < dump.txt
+  python3 trace_decode.py --serial /dev/ttyACM0   (send TRACE DUMP on the shell)
+
+Requires python 3.6 or f-strings; pyserial only with --serial
+===========================================================================
+
+"""
+
+TRACE_VERSION = 1
+HDR = struct.Struct("<BII")
+RECORD = struct.Struct("<IHhII")
+
+EVENT_RE = re.compile(r'^\s*TRACE_EVENT\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', re.M)
+
+
+def crc16_ccitt_false(data: bytes) -> int:
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def load_events(path: str) -> dict:
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    # Drop comments so commented-out events do not shift the IDs.
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    return {i: (m.group(1), m.group(2)) for i, m in enumerate(EVENT_RE.finditer(text), 1)}
+
+
+def decode_line(frame: bytes, events: dict):
+    """Yield (sequence, seconds, text) for every record of a checked line."""
+    version, hz, seq = HDR.unpack_from(frame)
+    if version != TRACE_VERSION:
+        raise ValueError(f"trace version {version}, decoder knows {TRACE_VERSION}")
+    body = frame[HDR.size:]
+    if len(body) % RECORD.size:
+        raise ValueError("truncated record")
+    for off in range(0, len(body), RECORD.size):
+        ticks, ev, a0, a1, a2 = RECORD.unpack_from(body, off)
+        name, fmt = events.get(ev, (f"EVENT_{ev}", "a0={a0} a1={a1} a2={a2}"))
+        try:
+            text = fmt.format(a0=a0, a1=a1, a2=a2)
+        except (IndexError, KeyError, ValueError):
+            text = f"a0={a0} a1={a1} a2={a2}"
+        yield seq, ticks / hz if hz else ticks, f"{name}: {text}"
+        seq += 1
+
+
+def lines_from(args):
+    if args.serial:
+        import serial
+        ser = serial.Serial(args.serial, args.baudrate, timeout=None)
+        ser.write(b"TRACE DUMP\r\n")
+        while True:
+            yield ser.readline().decode(errors="replace")
+    elif args.input == "-":
+        yield from sys.stdin
+    else:
+        with open(args.input, encoding="utf-8", errors="replace") as f:
+            yield from f
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="mac_demo binary trace decoder")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="console log with TRC lines (default: stdin)")
+    parser.add_argument("--serial", help="shell UART: send TRACE DUMP and decode the reply")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--events", default=os.path.join(here, "..", "trace_events.h"),
+                        help="event dictionary the firmware was built with")
+    args = parser.parse_args()
+
+    events = load_events(args.events)
+    last_seq = None
+    try:
+        for line in lines_from(args):
+            if "TRACE:" in line and args.serial:
+                # Summary line printed after the last TRC line.
+                print(line.strip(), file=sys.stderr)
+                break
+            idx = line.find("TRC ")
+            if idx < 0:
+                continue
+            try:
+                frame = base64.b64decode(line[idx + 4:].strip())
+            except ValueError:
+                continue
+            if len(frame) < HDR.size + 2 or crc16_ccitt_false(frame[:-2]) != \
+                    struct.unpack("<H", frame[-2:])[0]:
+                print("dropped TRC line with bad CRC", file=sys.stderr)
+                continue
+            try:
+                for seq, t, text in decode_line(frame[:-2], events):
+                    if last_seq is not None and seq != last_seq + 1:
+                        print(f"-- {seq - last_seq - 1} record(s) missing --")
+                    last_seq = seq
+                    print(f"[{t:12.6f}] #{seq} {text}", flush=True)
+            except (ValueError, struct.error) as e:
+                print(f"dropped TRC line: {e}", file=sys.stderr)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
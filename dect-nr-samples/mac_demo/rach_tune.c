@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "rach_tune.h"
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+LOG_MODULE_REGISTER(rach_tune, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define FILL_PER_PT     5
+#define FILL_PER_SDU_S  2
+#define FILL_PER_FAIL   20
+#define CW_SIG_MAX      7
+#define CW_SPAN         4 /* cw_max_sig above cw_min_sig */
+
+static struct {
+	bool enabled;
+	uint32_t rx_sdus;
+	uint32_t assoc_failed;
+	uint32_t last_step_ms;
+} state = {
+	.enabled = IS_ENABLED(CONFIG_APP_RACH_TUNE),
+};
+
+/* Inputs and outcome of the latest step, for RACH. */
+static struct {
+	uint32_t steps;
+	uint32_t changes;
+	size_t pts;
+	uint32_t sdus_per_s;
+	uint32_t assoc_failed;
+	uint8_t target_fill;
+	struct dect_adapter_rach_params proposed;
+} last;
+
+static K_MUTEX_DEFINE(rach_tune_mutex);
+
+void rach_tune_note_rx(void)
+{
+	k_mutex_lock(&rach_tune_mutex, K_FOREVER);
+	state.rx_sdus++;
+	k_mutex_unlock(&rach_tune_mutex);
+}
+
+void rach_tune_note_assoc(int status)
+{
+	if (status == 0) {
+		return;
+	}
+	k_mutex_lock(&rach_tune_mutex, K_FOREVER);
+	state.assoc_failed++;
+	k_mutex_unlock(&rach_tune_mutex);
+}
+
+void rach_tune_enable(bool enable)
+{
+	k_mutex_lock(&rach_tune_mutex, K_FOREVER);
+	state.enabled = enable;
+	k_mutex_unlock(&rach_tune_mutex);
+}
+
+bool rach_tune_enabled(void)
+{
+	bool enabled;
+
+	k_mutex_lock(&rach_tune_mutex, K_FOREVER);
+	enabled = state.enabled;
+	k_mutex_unlock(&rach_tune_mutex);
+	return enabled;
+}
+
+/* Contention window for pts possible contenders: wider windows spread RACH
+ * attempts over more slots at the cost of access latency. */
+static uint8_t cw_min_for(size_t pts, uint32_t assoc_failed)
+{
+	uint8_t cw = (pts <= 2) ? 1 : (pts <= 8) ? 2 : (pts <= 32) ? 3 : 4;
+
+	if (assoc_failed > 0) {
+		cw++;
+	}
+	return MIN(cw, CW_SIG_MAX - 1);
+}
+
+bool rach_tune_step(size_t pts, uint8_t ceiling, const struct dect_adapter_rach_params *cur,
+		    struct dect_adapter_rach_params *next)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t elapsed_ms, sdus_per_s, target;
+	uint8_t fill, cw_min;
+	bool change;
+
+	k_mutex_lock(&rach_tune_mutex, K_FOREVER);
+	elapsed_ms = (state.last_step_ms != 0) ? now - state.last_step_ms
+					       : CONFIG_APP_RACH_TUNE_INTERVAL_MS;
+	sdus_per_s = (state.rx_sdus * 1000U) / MAX(elapsed_ms, 1U);
+
+	target = CONFIG_APP_RACH_FILL_MIN + FILL_PER_PT * pts + FILL_PER_SDU_S * sdus_per_s +
+		 FILL_PER_FAIL * state.assoc_failed;
+	target = CLAMP(target, MIN(CONFIG_APP_RACH_FILL_MIN, ceiling), ceiling);
+	if (target >= cur->fill_percentage) {
+		fill = (uint8_t)target;
+	} else {
+		fill = (uint8_t)(target + (cur->fill_percentage - target) / 2U);
+	}
+	cw_min = cw_min_for(pts, state.assoc_failed);
+
+	*next = *cur;
+	/* Always honour a lowered ceiling; otherwise only move for real changes. */
+	change = (cw_min != cur->cw_min_sig) || (cur->fill_percentage > ceiling) ||
+		 (abs((int)fill - (int)cur->fill_percentage) >= CONFIG_APP_RACH_TUNE_HYSTERESIS);
+	if (change) {
+		next->fill_percentage = fill;
+		next->cw_min_sig = cw_min;
+		next->cw_max_sig = MIN(cw_min + CW_SPAN, CW_SIG_MAX);
+		last.changes++;
+	}
+
+	last.steps++;
+	last.pts = pts;
+	last.sdus_per_s = sdus_per_s;
+	last.assoc_failed = state.assoc_failed;
+	last.target_fill = (uint8_t)target;
+	last.proposed = *next;
+	state.rx_sdus = 0;
+	state.assoc_failed = 0;
+	state.last_step_ms = now;
+	k_mutex_unlock(&rach_tune_mutex);
+
+	if (change) {
+		LOG_DBG("RACH tune: pts=%zu %u SDU/s fail=%u -> fill %u%% cw %u..%u", pts,
+			sdus_per_s, last.assoc_failed, next->fill_percentage, next->cw_min_sig,
+			next->cw_max_sig);
+	}
+	return change;
+}
+
+static int cmd_rach(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_mutex_lock(&rach_tune_mutex, K_FOREVER);
+	shell_print(shell, "RACH tuning: %s, every %u ms, fill %u..ceiling, hysteresis %u points",
+		    state.enabled ? "auto" : "manual (ACTIVETIME AUTO enables)",
+		    CONFIG_APP_RACH_TUNE_INTERVAL_MS, CONFIG_APP_RACH_FILL_MIN,
+		    CONFIG_APP_RACH_TUNE_HYSTERESIS);
+	if (last.steps == 0) {
+		shell_print(shell, "RACH: no step yet (runs while in FT mode)");
+	} else {
+		shell_print(shell, "RACH last step: pts=%zu uplink=%u SDU/s assoc_failed=%u "
+			    "target fill=%u%%", last.pts, last.sdus_per_s, last.assoc_failed,
+			    last.target_fill);
+		shell_print(shell, "RACH proposed: fill=%u%% cw=%u..%u response_window=%u "
+			    "max_tx_len=%u", last.proposed.fill_percentage,
+			    last.proposed.cw_min_sig, last.proposed.cw_max_sig,
+			    last.proposed.response_window_length,
+			    last.proposed.max_transmission_length);
+	}
+	shell_print(shell, "RACH: steps=%u changes=%u, since last step rx=%u assoc_failed=%u",
+		    last.steps, last.changes, state.rx_sdus, state.assoc_failed);
+	k_mutex_unlock(&rach_tune_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(RACH, NULL, "RACH — automatic RACH tuning inputs and parameters", cmd_rach, 1, 0);
+SHELL_CMD_ARG_REGISTER(rach, NULL, "rach — automatic rach tuning inputs and parameters", cmd_rach, 1, 0);
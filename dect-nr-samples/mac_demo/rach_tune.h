@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RACH_TUNE_H__
+#define RACH_TUNE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "dect_adapter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file rach_tune.h
+ * @brief Automatic FT RACH tuning from observed demand.
+ *
+ * Every CONFIG_APP_RACH_TUNE_INTERVAL_MS the FT calls rach_tune_step() with
+ * the number of associated PTs; the uplink SDUs and failed association
+ * indications since the previous step are counted here. The target RACH fill
+ * is CONFIG_APP_RACH_FILL_MIN plus 5 points per PT, 2 per uplink SDU/s and
+ * 20 per failed association, capped at the ceiling (the power profile's
+ * fill). The contention window widens with the number of PTs that may
+ * contend, and by one more step after association failures, which are the
+ * collisions an FT can see.
+ *
+ * Increases apply at once; decreases move half way per step, so a burst does
+ * not leave the RACH oversized but one quiet interval does not shrink it
+ * either. Fill changes below CONFIG_APP_RACH_TUNE_HYSTERESIS points are
+ * ignored, so the cluster is not reconfigured for noise.
+ */
+
+/** @brief Count one SDU received from an associated PT. */
+void rach_tune_note_rx(void);
+
+/**
+ * @brief Count an association indication.
+ *
+ * @param status Indication status (non-zero = failed)
+ */
+void rach_tune_note_assoc(int status);
+
+/**
+ * @brief Turn automatic tuning on or off.
+ *
+ * @param enable true to let rach_tune_step() propose changes
+ */
+void rach_tune_enable(bool enable);
+
+/** @brief Check whether automatic tuning is on. */
+bool rach_tune_enabled(void);
+
+/**
+ * @brief Decide the RACH parameters for the next interval.
+ *
+ * Consumes the counters since the previous call, also while tuning is off.
+ *
+ * @param pts     Associated PTs
+ * @param ceiling Highest fill percentage to use
+ * @param cur     Parameters in use
+ * @param next    Output: proposed parameters (copy of @p cur if unchanged)
+ * @return true if @p next differs enough from @p cur to reconfigure
+ */
+bool rach_tune_step(size_t pts, uint8_t ceiling, const struct dect_adapter_rach_params *cur,
+		    struct dect_adapter_rach_params *next);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RACH_TUNE_H__ */
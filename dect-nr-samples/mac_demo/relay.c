@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "relay.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+#include "app_dlc.h"
+#include "ft_assoc.h"
+#include "rpc.h"
+
+LOG_MODULE_REGISTER(relay, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define RELAY_MSG_DATA      0
+#define RELAY_MSG_ADVERT    1
+#define RELAY_DATA_HDR_LEN  11 /* type, dst, src, hops, inner port */
+#define RELAY_ADVERT_ENTRY  6  /* long RD ID, hops, quality */
+#define RELAY_ROUTE_TTL_MS  (3U * CONFIG_APP_RELAY_ADVERT_INTERVAL_MS)
+#define RELAY_ADVERT_MAX    MIN((APP_DLC_PAYLOAD_LEN_MAX - 2) / RELAY_ADVERT_ENTRY, \
+				CONFIG_APP_RELAY_ROUTES_MAX + CONFIG_APP_FT_MAX_PTS)
+
+BUILD_ASSERT(RELAY_PAYLOAD_LEN_MAX > 0, "DLC SDU too small for the route header");
+
+struct relay_route {
+	uint32_t dst;       /* 0 = free */
+	uint32_t next_hop;  /* an associated PT */
+	uint32_t last_ms;   /* uptime of the latest refresh */
+	uint8_t hops;
+	uint8_t quality;    /* 0-100, worst link on the path */
+};
+
+static struct relay_route routes[CONFIG_APP_RELAY_ROUTES_MAX];
+static bool active;
+
+static struct {
+	uint32_t tx;
+	uint32_t delivered;
+	uint32_t forwarded;
+	uint32_t no_route;
+	uint32_t hop_limit;
+	uint32_t tx_err;
+	uint32_t adverts_tx;
+	uint32_t adverts_rx;
+	uint32_t malformed;
+	uint32_t evicted;
+} stats;
+
+/* Leaf lock below app_mutex; ft_assoc_mutex may be taken inside. Never held
+ * across a send. */
+static K_MUTEX_DEFINE(relay_mutex);
+
+static void relay_advert_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(relay_advert_work, relay_advert_work_handler);
+
+/* Link quality towards an associated PT: TX success rate, 100 before any TX. */
+static uint8_t link_quality(uint32_t long_rd_id)
+{
+	struct ft_assoc_peer peer;
+	uint32_t total;
+
+	if (ft_assoc_get(long_rd_id, &peer) != 0) {
+		return 0;
+	}
+	total = peer.tx_ok + peer.tx_fail;
+	return (total == 0) ? 100 : (uint8_t)((100U * peer.tx_ok) / total);
+}
+
+static bool route_expired(const struct relay_route *r, uint32_t now)
+{
+	return (now - r->last_ms) > RELAY_ROUTE_TTL_MS;
+}
+
+/* Must be called with relay_mutex held. */
+static struct relay_route *route_find_locked(uint32_t dst)
+{
+	for (int i = 0; i < ARRAY_SIZE(routes); i++) {
+		if (routes[i].dst == dst) {
+			return &routes[i];
+		}
+	}
+	return NULL;
+}
+
+/* Must be called with relay_mutex held. Keeps the better of the known route
+ * and the offered one: fewer hops, then better quality; a route through the
+ * same next hop, or an expired one, is always refreshed. */
+static void route_learn_locked(uint32_t dst, uint32_t next_hop, uint8_t hops, uint8_t quality)
+{
+	uint32_t now = k_uptime_get_32();
+	struct relay_route *r = route_find_locked(dst);
+
+	if (r != NULL) {
+		if (r->next_hop != next_hop && !route_expired(r, now) &&
+		    (hops > r->hops || (hops == r->hops && quality <= r->quality))) {
+			return;
+		}
+	} else {
+		struct relay_route *oldest = &routes[0];
+
+		for (int i = 0; i < ARRAY_SIZE(routes); i++) {
+			if (routes[i].dst == 0) {
+				r = &routes[i];
+				break;
+			}
+			if ((now - routes[i].last_ms) > (now - oldest->last_ms)) {
+				oldest = &routes[i];
+			}
+		}
+		if (r == NULL) {
+			r = oldest;
+			stats.evicted++;
+		}
+	}
+	r->dst = dst;
+	r->next_hop = next_hop;
+	r->hops = hops;
+	r->quality = quality;
+	r->last_ms = now;
+}
+
+/* Next hop towards dst: an associated PT, a live route, else the parent FT.
+ * dst 0 (the root) always goes to the parent. */
+static int next_hop_get(uint32_t dst, uint32_t *next_hop)
+{
+	const struct relay_route *r;
+	int err = -EHOSTUNREACH;
+
+	if (dst != 0 && ft_assoc_contains(dst)) {
+		*next_hop = dst;
+		return 0;
+	}
+	if (dst != 0) {
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		r = route_find_locked(dst);
+		if (r != NULL && !route_expired(r, k_uptime_get_32()) &&
+		    ft_assoc_contains(r->next_hop)) {
+			*next_hop = r->next_hop;
+			err = 0;
+		}
+		k_mutex_unlock(&relay_mutex);
+		if (err == 0) {
+			return 0;
+		}
+	}
+	return (app_dlc_parent_get(next_hop) == 0) ? 0 : -EHOSTUNREACH;
+}
+
+static int send_routed(uint32_t next_hop, uint32_t dst, uint32_t src, uint8_t hops, uint8_t port,
+		       const void *data, size_t len)
+{
+	uint8_t hdr[RELAY_DATA_HDR_LEN];
+
+	hdr[0] = RELAY_MSG_DATA;
+	sys_put_le32(dst, &hdr[1]);
+	sys_put_le32(src, &hdr[5]);
+	hdr[9] = hops;
+	hdr[10] = port;
+	return app_dlc_port_send_hdr(next_hop, APP_DLC_PORT_ROUTE, hdr, sizeof(hdr), data, len,
+				     NULL);
+}
+
+int relay_send(uint32_t dst, uint8_t port, const void *data, size_t len)
+{
+	struct app_status st;
+	uint32_t next_hop;
+	int err;
+
+	if (data == NULL || len == 0 || port == APP_DLC_PORT_ROUTE) {
+		return -EINVAL;
+	}
+	if (len > RELAY_PAYLOAD_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+	app_status_get(&st);
+	if (dst == st.device_long_rd_id) {
+		return -EINVAL;
+	}
+
+	err = next_hop_get(dst, &next_hop);
+	if (err == 0) {
+		err = send_routed(next_hop, dst, st.device_long_rd_id, 0, port, data, len);
+	}
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	if (err == 0) {
+		stats.tx++;
+	} else if (err == -EHOSTUNREACH) {
+		stats.no_route++;
+	} else {
+		stats.tx_err++;
+	}
+	k_mutex_unlock(&relay_mutex);
+	return err;
+}
+
+static void rx_data(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		    app_dlc_dispatch_t dispatch)
+{
+	struct app_status st;
+	uint32_t dst, src, next_hop;
+	uint8_t hops, port;
+	bool to_self;
+	int err;
+
+	if (len <= RELAY_DATA_HDR_LEN) {
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		stats.malformed++;
+		k_mutex_unlock(&relay_mutex);
+		return;
+	}
+	dst = sys_get_le32(&data[1]);
+	src = sys_get_le32(&data[5]);
+	hops = data[9];
+	port = data[10];
+
+	app_status_get(&st);
+	/* Without a parent this device is the root. */
+	to_self = (dst == st.device_long_rd_id) ||
+		  (dst == 0 && app_dlc_parent_get(&next_hop) != 0);
+
+	/* Reverse route to the originator through the PT it came from. */
+	if (src != 0 && src != long_rd_id && ft_assoc_contains(long_rd_id)) {
+		uint8_t quality = link_quality(long_rd_id);
+
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		route_learn_locked(src, long_rd_id, hops + 1, quality);
+		k_mutex_unlock(&relay_mutex);
+	}
+
+	if (to_self) {
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		stats.delivered++;
+		k_mutex_unlock(&relay_mutex);
+		if (port == APP_DLC_PORT_ROUTE) {
+			LOG_WRN("Routed SDU from rd=%u: nested route port dropped", src);
+			return;
+		}
+		dispatch(src, port, &data[RELAY_DATA_HDR_LEN], len - RELAY_DATA_HDR_LEN);
+		return;
+	}
+
+	if (hops + 1 >= CONFIG_APP_RELAY_MAX_HOPS) {
+		LOG_WRN("Routed SDU %u->%u dropped: hop limit", src, dst);
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		stats.hop_limit++;
+		k_mutex_unlock(&relay_mutex);
+		return;
+	}
+
+	err = next_hop_get(dst, &next_hop);
+	if (err == 0 && next_hop == long_rd_id) {
+		/* Would bounce back: the tree has no route below us. */
+		err = -EHOSTUNREACH;
+	}
+	if (err == 0) {
+		err = send_routed(next_hop, dst, src, hops + 1, port, &data[RELAY_DATA_HDR_LEN],
+				  len - RELAY_DATA_HDR_LEN);
+	}
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	if (err == 0) {
+		stats.forwarded++;
+	} else if (err == -EHOSTUNREACH) {
+		stats.no_route++;
+	} else {
+		stats.tx_err++;
+	}
+	k_mutex_unlock(&relay_mutex);
+	if (err != 0) {
+		LOG_DBG("Routed SDU %u->%u from rd=%u not forwarded: %d", src, dst, long_rd_id,
+			err);
+	}
+}
+
+static void rx_advert(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	uint8_t link;
+	size_t count;
+
+	/* Adverts only flow up the tree, from our own PTs. */
+	if (len < 2 || !ft_assoc_contains(long_rd_id)) {
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		stats.malformed++;
+		k_mutex_unlock(&relay_mutex);
+		return;
+	}
+	count = MIN((size_t)data[1], (len - 2) / RELAY_ADVERT_ENTRY);
+	link = link_quality(long_rd_id);
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	stats.adverts_rx++;
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t *e = &data[2 + i * RELAY_ADVERT_ENTRY];
+		uint32_t dst = sys_get_le32(e);
+
+		if (dst == 0 || dst == long_rd_id || e[4] >= CONFIG_APP_RELAY_MAX_HOPS) {
+			continue;
+		}
+		route_learn_locked(dst, long_rd_id, e[4] + 1, MIN(e[5], link));
+	}
+	k_mutex_unlock(&relay_mutex);
+}
+
+void relay_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+	      app_dlc_dispatch_t dispatch)
+{
+	switch (data[0]) {
+	case RELAY_MSG_DATA:
+		rx_data(long_rd_id, data, len, dispatch);
+		break;
+	case RELAY_MSG_ADVERT:
+		rx_advert(long_rd_id, data, len);
+		break;
+	default:
+		k_mutex_lock(&relay_mutex, K_FOREVER);
+		stats.malformed++;
+		k_mutex_unlock(&relay_mutex);
+		break;
+	}
+}
+
+/* Everything below this relay: its PTs (1 hop) and its live routes. */
+static void relay_advert_work_handler(struct k_work *work)
+{
+	static uint8_t msg[2 + RELAY_ADVERT_MAX * RELAY_ADVERT_ENTRY];
+	uint32_t rds[CONFIG_APP_FT_MAX_PTS];
+	uint32_t parent, now;
+	size_t n, count = 0;
+	int err;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	if (!active) {
+		k_mutex_unlock(&relay_mutex);
+		return;
+	}
+	k_mutex_unlock(&relay_mutex);
+	k_work_reschedule(&relay_advert_work, K_MSEC(CONFIG_APP_RELAY_ADVERT_INTERVAL_MS));
+	if (app_dlc_parent_get(&parent) != 0) {
+		return;
+	}
+
+	n = ft_assoc_list(rds, ARRAY_SIZE(rds));
+	for (size_t i = 0; i < n && count < RELAY_ADVERT_MAX; i++, count++) {
+		uint8_t *e = &msg[2 + count * RELAY_ADVERT_ENTRY];
+
+		sys_put_le32(rds[i], e);
+		e[4] = 1;
+		e[5] = link_quality(rds[i]);
+	}
+
+	now = k_uptime_get_32();
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	for (int i = 0; i < ARRAY_SIZE(routes) && count < RELAY_ADVERT_MAX; i++) {
+		if (routes[i].dst == 0 || route_expired(&routes[i], now)) {
+			continue;
+		}
+		uint8_t *e = &msg[2 + count * RELAY_ADVERT_ENTRY];
+
+		sys_put_le32(routes[i].dst, e);
+		e[4] = routes[i].hops;
+		e[5] = routes[i].quality;
+		count++;
+	}
+	k_mutex_unlock(&relay_mutex);
+
+	msg[0] = RELAY_MSG_ADVERT;
+	msg[1] = (uint8_t)count;
+	err = app_dlc_flow_send(parent, APP_DLC_FLOW_SIGNALLING, APP_DLC_PORT_ROUTE, msg,
+				2 + count * RELAY_ADVERT_ENTRY, NULL);
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	if (err == 0) {
+		stats.adverts_tx++;
+	} else {
+		stats.tx_err++;
+	}
+	k_mutex_unlock(&relay_mutex);
+}
+
+void relay_start(void)
+{
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	active = true;
+	k_mutex_unlock(&relay_mutex);
+	k_work_reschedule(&relay_advert_work, K_NO_WAIT);
+}
+
+void relay_reset(void)
+{
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	active = false;
+	memset(routes, 0, sizeof(routes));
+	k_mutex_unlock(&relay_mutex);
+	k_work_cancel_delayable(&relay_advert_work);
+}
+
+bool relay_active(void)
+{
+	bool ret;
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	ret = active;
+	k_mutex_unlock(&relay_mutex);
+	return ret;
+}
+
+void relay_peer_down(uint32_t long_rd_id)
+{
+	bool advertise;
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	for (int i = 0; i < ARRAY_SIZE(routes); i++) {
+		if (routes[i].next_hop == long_rd_id) {
+			memset(&routes[i], 0, sizeof(routes[i]));
+		}
+	}
+	advertise = active;
+	k_mutex_unlock(&relay_mutex);
+	if (advertise) {
+		/* Tell the parent now rather than at the next interval. */
+		k_work_reschedule(&relay_advert_work, K_NO_WAIT);
+	}
+}
+
+static int cmd_routes(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t parent;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (app_dlc_parent_get(&parent) == 0) {
+		shell_print(shell, "Relay: %s, parent rd=%u (default route)",
+			    relay_active() ? "on" : "off", parent);
+	} else {
+		shell_print(shell, "Relay: %s, no parent (root)", relay_active() ? "on" : "off");
+	}
+
+	k_mutex_lock(&relay_mutex, K_FOREVER);
+	for (int i = 0; i < ARRAY_SIZE(routes); i++) {
+		const struct relay_route *r = &routes[i];
+
+		if (r->dst == 0) {
+			continue;
+		}
+		shell_print(shell, "  rd=%u via %u hops=%u quality=%u%% age %u ms%s", r->dst,
+			    r->next_hop, r->hops, r->quality, now - r->last_ms,
+			    route_expired(r, now) ? " (expired)" : "");
+	}
+	shell_print(shell, "ROUTES: sent=%u delivered=%u forwarded=%u no_route=%u hop_limit=%u "
+		    "tx_err=%u", stats.tx, stats.delivered, stats.forwarded, stats.no_route,
+		    stats.hop_limit, stats.tx_err);
+	shell_print(shell, "ROUTES: adverts tx=%u rx=%u malformed=%u evicted=%u", stats.adverts_tx,
+		    stats.adverts_rx, stats.malformed, stats.evicted);
+	k_mutex_unlock(&relay_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(ROUTES, NULL, "ROUTES — relay route table and forwarding counters", cmd_routes, 1, 0);
+SHELL_CMD_ARG_REGISTER(routes, NULL, "routes — relay route table and forwarding counters", cmd_routes, 1, 0);
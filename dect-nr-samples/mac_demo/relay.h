@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RELAY_H__
+#define RELAY_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "app_dlc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file relay.h
+ * @brief Multi-hop forwarding of DLC payloads over a tree of FTs and relays.
+ *
+ * A relay is a PT associated upstream that also runs an FT cluster on a
+ * second carrier for its own PTs. Routed payloads travel on
+ * APP_DLC_PORT_ROUTE with a header naming the final destination and the
+ * originator:
+ *
+ *   DATA:   [0][dst u32][src u32][hops u8][inner port][payload]
+ *   ADVERT: [1][count u8] count x [long RD ID u32][hops u8][quality u8]
+ *
+ * Destination 0 is the root, the FT at the top of the tree. Every node
+ * forwards towards a destination in this order: a directly associated PT,
+ * the route table, then the parent FT. Routes are learned from ADVERTs,
+ * which each relay sends to its parent every
+ * CONFIG_APP_RELAY_ADVERT_INTERVAL_MS listing everything below it, and from
+ * the source of forwarded DATA. A route is replaced by one with fewer hops,
+ * or as many hops and better link quality (TX success rate of the next hop,
+ * 0-100, taken as the minimum along the path), and expires after three
+ * advert intervals without refresh.
+ */
+
+/**
+ * @brief Start sending route adverts to the parent.
+ *
+ * Called once the downstream cluster of a relay is up. Safe to call again
+ * after each reassociation.
+ */
+void relay_start(void);
+
+/**
+ * @brief Stop sending adverts and forget all routes.
+ *
+ * Called whenever the MAC is reinitialised, on relays and the root alike.
+ */
+void relay_reset(void);
+
+/**
+ * @brief Check whether this device is relaying.
+ *
+ * @return true between relay_start() and relay_reset()
+ */
+bool relay_active(void);
+
+/**
+ * @brief Send a payload to a device anywhere in the tree.
+ *
+ * Must not be called with app_mutex held.
+ *
+ * @param dst  Destination long RD ID, 0 = the root FT
+ * @param port Inner service port delivered at @p dst (enum app_dlc_port)
+ * @param data Payload bytes
+ * @param len  Payload length, 1..RELAY_PAYLOAD_LEN_MAX
+ * @return 0 if queued towards the next hop, -EINVAL on bad arguments,
+ *         -EMSGSIZE if @p len is too large, -EHOSTUNREACH without a route or
+ *         parent, or a send error
+ */
+int relay_send(uint32_t dst, uint8_t port, const void *data, size_t len);
+
+/** Largest payload relay_send() accepts. */
+#define RELAY_PAYLOAD_LEN_MAX (APP_DLC_PAYLOAD_LEN_MAX - 11)
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_ROUTE.
+ *
+ * Called from the main event loop. DATA for this device is handed to
+ * @p dispatch with the originator as sender; anything else is forwarded.
+ *
+ * @param long_rd_id Sender (previous hop) long RD ID
+ * @param data       Payload (port byte stripped)
+ * @param len        Payload length
+ * @param dispatch   Handler for payloads addressed to this device
+ */
+void relay_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+	      app_dlc_dispatch_t dispatch);
+
+/**
+ * @brief Drop the routes through a neighbour that went away.
+ *
+ * @param long_rd_id Released PT long RD ID
+ */
+void relay_peer_down(uint32_t long_rd_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RELAY_H__ */
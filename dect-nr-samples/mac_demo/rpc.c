@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "rpc.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/ring_buffer.h>
+#include "app_dlc.h"
+#include "coalesce.h"
+
+LOG_MODULE_REGISTER(rpc, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define RPC_UART_NODE DT_CHOSEN(app_rpc_uart)
+
+BUILD_ASSERT(DT_NODE_HAS_STATUS(RPC_UART_NODE, okay),
+	     "CONFIG_APP_RPC needs an enabled app,rpc-uart (see rpc.overlay)");
+
+#define RPC_CRC_LEN      2
+#define RPC_REQ_HDR_LEN  3 /* type, seq, op */
+#define RPC_RESP_HDR_LEN 5 /* type, seq, op, status */
+#define RPC_EVT_HDR_LEN  3 /* type, seq, event */
+
+/* Largest message, CRC excluded, and its COBS encoding plus delimiter. */
+#define RPC_MSG_LEN_MAX  CONFIG_APP_RPC_MSG_LEN_MAX
+#define RPC_COBS_LEN_MAX (RPC_MSG_LEN_MAX + RPC_CRC_LEN + \
+			  DIV_ROUND_UP(RPC_MSG_LEN_MAX + RPC_CRC_LEN, 254) + 1)
+
+/* One message being built and its encoding. */
+struct rpc_txbuf {
+	uint8_t msg[RPC_MSG_LEN_MAX + RPC_CRC_LEN];
+	uint8_t enc[RPC_COBS_LEN_MAX];
+};
+
+static const struct device *const rpc_uart = DEVICE_DT_GET(RPC_UART_NODE);
+
+RING_BUF_DECLARE(rpc_rx_ring, CONFIG_APP_RPC_RX_BUF_SIZE);
+RING_BUF_DECLARE(rpc_tx_ring, CONFIG_APP_RPC_TX_BUF_SIZE);
+static struct k_spinlock ring_lock;
+static K_SEM_DEFINE(rpc_rx_sem, 0, 1);
+
+/* Responses are only built by the RPC thread; events by whoever reports them. */
+static struct rpc_txbuf resp_buf;
+static struct rpc_txbuf evt_buf;
+static K_MUTEX_DEFINE(evt_mutex);
+static uint8_t evt_seq;
+
+/* Incoming frame, decoded in place. */
+static uint8_t rx_frame[RPC_COBS_LEN_MAX];
+static size_t rx_len;
+static bool rx_overflow;
+
+static atomic_t rpc_running;
+
+static struct {
+	uint32_t rx_frames;
+	uint32_t rx_bad;         /* COBS, CRC or length errors */
+	uint32_t rx_overruns;    /* bytes lost because the RX ring was full */
+	uint32_t tx_frames;
+	uint32_t evt_sent;
+	uint32_t evt_dropped;    /* TX ring full or event too large */
+} stats;
+
+/* COBS-encode len bytes into out; returns the encoded length (no delimiter). */
+static size_t cobs_encode(const uint8_t *in, size_t len, uint8_t *out)
+{
+	size_t code_pos = 0;
+	size_t out_len = 1;
+	uint8_t code = 1;
+
+	for (size_t i = 0; i < len; i++) {
+		if (in[i] == 0) {
+			out[code_pos] = code;
+			code_pos = out_len++;
+			code = 1;
+			continue;
+		}
+		out[out_len++] = in[i];
+		if (++code == 0xff) {
+			out[code_pos] = code;
+			code_pos = out_len++;
+			code = 1;
+		}
+	}
+	out[code_pos] = code;
+	return out_len;
+}
+
+/* COBS-decode in place (the output never overtakes the input); returns the
+ * decoded length, or -EBADMSG on a malformed frame. */
+static int cobs_decode(uint8_t *buf, size_t len)
+{
+	size_t in = 0;
+	size_t out = 0;
+
+	while (in < len) {
+		uint8_t code = buf[in++];
+
+		if (code == 0 || in + code - 1 > len) {
+			return -EBADMSG;
+		}
+		for (uint8_t i = 1; i < code; i++) {
+			buf[out++] = buf[in++];
+		}
+		if (code != 0xff && in < len) {
+			buf[out++] = 0;
+		}
+	}
+	return (int)out;
+}
+
+static void rpc_uart_isr(const struct device *dev, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	while (uart_irq_update(dev) && uart_irq_is_pending(dev)) {
+		if (uart_irq_rx_ready(dev)) {
+			uint8_t buf[32];
+			int n = uart_fifo_read(dev, buf, sizeof(buf));
+
+			if (n > 0) {
+				K_SPINLOCK(&ring_lock) {
+					if (ring_buf_put(&rpc_rx_ring, buf, n) < (uint32_t)n) {
+						stats.rx_overruns++;
+					}
+				}
+				k_sem_give(&rpc_rx_sem);
+			}
+		}
+		if (uart_irq_tx_ready(dev)) {
+			K_SPINLOCK(&ring_lock) {
+				uint8_t *data;
+				uint32_t n = ring_buf_get_claim(&rpc_tx_ring, &data, 64);
+
+				if (n == 0) {
+					uart_irq_tx_disable(dev);
+				} else {
+					int sent = uart_fifo_fill(dev, data, n);
+
+					ring_buf_get_finish(&rpc_tx_ring, MAX(sent, 0));
+				}
+			}
+		}
+	}
+}
+
+/* Append the CRC to the msg_len bytes in b->msg, encode and queue the frame
+ * whole. Returns -ENOBUFS if the TX ring has no room for all of it. */
+static int frame_send(struct rpc_txbuf *b, size_t msg_len)
+{
+	size_t enc_len;
+	bool queued = false;
+
+	sys_put_le16(crc16_itu_t(0xffff, b->msg, msg_len), &b->msg[msg_len]);
+	enc_len = cobs_encode(b->msg, msg_len + RPC_CRC_LEN, b->enc);
+	b->enc[enc_len++] = 0;
+
+	K_SPINLOCK(&ring_lock) {
+		if (ring_buf_space_get(&rpc_tx_ring) >= enc_len) {
+			ring_buf_put(&rpc_tx_ring, b->enc, enc_len);
+			stats.tx_frames++;
+			queued = true;
+		}
+	}
+	if (!queued) {
+		return -ENOBUFS;
+	}
+	uart_irq_tx_enable(rpc_uart);
+	return 0;
+}
+
+/* Send an event; dropped rather than waited for when the UART cannot keep up,
+ * since the callers include the main event loop. */
+static void event_send(uint8_t event, const void *hdr, size_t hdr_len, const void *data,
+		       size_t len)
+{
+	if (!atomic_get(&rpc_running)) {
+		return;
+	}
+
+	k_mutex_lock(&evt_mutex, K_FOREVER);
+	if (RPC_EVT_HDR_LEN + hdr_len + len > RPC_MSG_LEN_MAX) {
+		stats.evt_dropped++;
+		k_mutex_unlock(&evt_mutex);
+		return;
+	}
+	evt_buf.msg[0] = RPC_MSG_EVENT;
+	evt_buf.msg[1] = evt_seq++;
+	evt_buf.msg[2] = event;
+	memcpy(&evt_buf.msg[RPC_EVT_HDR_LEN], hdr, hdr_len);
+	if (len > 0) {
+		memcpy(&evt_buf.msg[RPC_EVT_HDR_LEN + hdr_len], data, len);
+	}
+	if (frame_send(&evt_buf, RPC_EVT_HDR_LEN + hdr_len + len) == 0) {
+		stats.evt_sent++;
+	} else {
+		stats.evt_dropped++;
+	}
+	k_mutex_unlock(&evt_mutex);
+}
+
+void rpc_event_beacon(bool cluster, uint16_t channel, uint32_t long_rd_id, uint32_t network_id,
+		      uint32_t period_ms, int16_t rssi_dbm)
+{
+	uint8_t d[17];
+
+	d[0] = cluster ? 1 : 0;
+	sys_put_le16(channel, &d[1]);
+	sys_put_le32(long_rd_id, &d[3]);
+	sys_put_le32(network_id, &d[7]);
+	sys_put_le32(period_ms, &d[11]);
+	sys_put_le16((uint16_t)rssi_dbm, &d[15]);
+	event_send(RPC_EVT_BEACON, d, sizeof(d), NULL, 0);
+}
+
+void rpc_event_association(uint8_t state, uint32_t long_rd_id, int status)
+{
+	uint8_t d[7];
+
+	d[0] = state;
+	sys_put_le32(long_rd_id, &d[1]);
+	sys_put_le16((uint16_t)(int16_t)status, &d[5]);
+	event_send(RPC_EVT_ASSOCIATION, d, sizeof(d), NULL, 0);
+}
+
+void rpc_event_dlc_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	uint8_t d[4];
+
+	sys_put_le32(long_rd_id, d);
+	event_send(RPC_EVT_DLC_RX, d, sizeof(d), data, len);
+}
+
+void rpc_event_telemetry(const uint8_t *data, size_t len)
+{
+	event_send(RPC_EVT_TELEMETRY, data, len, NULL, 0);
+}
+
+/* Run a command line on the dummy shell backend and copy what it printed to
+ * out (at most out_size bytes). Returns the command's result. The command runs
+ * on the RPC thread, alongside the UART shell: main.c serialises the modem
+ * operations and the SEND buffers for both. */
+static int exec_line(const char *line, uint8_t *out, size_t out_size, size_t *out_len)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	const char *text;
+	size_t text_len;
+	int ret;
+
+	shell_backend_dummy_clear_output(sh);
+	ret = shell_execute_cmd(sh, line);
+	if (out != NULL) {
+		text = shell_backend_dummy_get_output(sh, &text_len);
+		*out_len = MIN(text_len, out_size);
+		memcpy(out, text, *out_len);
+	}
+	LOG_DBG("exec \"%s\" ret=%d", line, ret);
+	return ret;
+}
+
+static int op_status(uint8_t *out, size_t *out_len)
+{
+	struct app_status st;
+
+	app_status_get(&st);
+	out[0] = st.mode;
+	out[1] = st.associated ? 1 : 0;
+	sys_put_le16(st.carrier, &out[2]);
+	sys_put_le32(st.device_long_rd_id, &out[4]);
+	sys_put_le32(st.peer_long_rd_id, &out[8]);
+	sys_put_le32(st.beacon_period_ms, &out[12]);
+	out[16] = st.rach_fill_percentage;
+	out[17] = st.power_save ? 1 : 0;
+	sys_put_le32(st.dlc_rx_dropped, &out[18]);
+	sys_put_le32(st.evt_dropped, &out[22]);
+	sys_put_le32(st.recoveries, &out[26]);
+	*out_len = 30;
+	return 0;
+}
+
+/* Serve one request. Response data goes to out (out_size bytes available). */
+static int handle_request(uint8_t op, const uint8_t *args, size_t args_len, uint8_t *out,
+			  size_t out_size, size_t *out_len)
+{
+	char line[48];
+
+	*out_len = 0;
+
+	switch (op) {
+	case RPC_OP_PING:
+		sys_put_le32(k_uptime_get_32(), out);
+		out[4] = RPC_PROTOCOL_VERSION;
+		*out_len = 5;
+		return 0;
+	case RPC_OP_STATUS:
+		return op_status(out, out_len);
+	case RPC_OP_SEND:
+		if (args_len <= 4) {
+			return -EINVAL;
+		}
+		return coalesce_send(sys_get_le32(args), APP_DLC_PORT_DATA, &args[4],
+				     args_len - 4);
+	case RPC_OP_EXEC: {
+		/* The request buffer has room for the CRC after the text, which
+		 * has been checked already: terminate the line in its place. */
+		if (args_len == 0 || memchr(args, '\0', args_len) != NULL) {
+			return -EINVAL;
+		}
+		((uint8_t *)args)[args_len] = '\0';
+		return exec_line((const char *)args, out, out_size, out_len);
+	}
+	case RPC_OP_FT:
+	case RPC_OP_PT:
+	case RPC_OP_PT_SCAN: {
+		static const char *const names[] = { "FT", "PT", "PT_SCAN" };
+		const char *name = names[op - RPC_OP_FT];
+		uint16_t ch;
+
+		if (args_len != 2) {
+			return -EINVAL;
+		}
+		ch = sys_get_le16(args);
+		if (ch == 0 && op == RPC_OP_PT) {
+			return -EINVAL;
+		}
+		if (ch == 0) {
+			snprintf(line, sizeof(line), "%s", name);
+		} else {
+			snprintf(line, sizeof(line), "%s %u", name, ch);
+		}
+		break;
+	}
+	case RPC_OP_STOP:
+		snprintf(line, sizeof(line), "STOP");
+		break;
+	case RPC_OP_PERIOD:
+		if (args_len != 4) {
+			return -EINVAL;
+		}
+		snprintf(line, sizeof(line), "PERIOD %u", sys_get_le32(args));
+		break;
+	case RPC_OP_POWERSAVE:
+		if (args_len != 1 || args[0] > 1) {
+			return -EINVAL;
+		}
+		snprintf(line, sizeof(line), "POWERSAVE %u", args[0]);
+		break;
+	case RPC_OP_PROFILE:
+		if (args_len == 0 || args_len > 16) {
+			return -EINVAL;
+		}
+		for (size_t i = 0; i < args_len; i++) {
+			if (args[i] <= ' ' || args[i] > '~') {
+				return -EINVAL;
+			}
+		}
+		snprintf(line, sizeof(line), "PROFILE %.*s", (int)args_len, (const char *)args);
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	return exec_line(line, NULL, 0, NULL);
+}
+
+static void frame_received(uint8_t *frame, size_t len)
+{
+	int dec = cobs_decode(frame, len);
+	uint8_t *out = &resp_buf.msg[RPC_RESP_HDR_LEN];
+	size_t out_len;
+	int status;
+
+	if (dec < RPC_REQ_HDR_LEN + RPC_CRC_LEN ||
+	    crc16_itu_t(0xffff, frame, dec - RPC_CRC_LEN) !=
+	    sys_get_le16(&frame[dec - RPC_CRC_LEN])) {
+		stats.rx_bad++;
+		return;
+	}
+	stats.rx_frames++;
+	if (frame[0] != RPC_MSG_REQUEST) {
+		return;
+	}
+
+	status = handle_request(frame[2], &frame[RPC_REQ_HDR_LEN],
+				dec - RPC_REQ_HDR_LEN - RPC_CRC_LEN, out,
+				RPC_MSG_LEN_MAX - RPC_RESP_HDR_LEN, &out_len);
+
+	resp_buf.msg[0] = RPC_MSG_RESPONSE;
+	resp_buf.msg[1] = frame[1];
+	resp_buf.msg[2] = frame[2];
+	sys_put_le16((uint16_t)(int16_t)status, &resp_buf.msg[3]);
+
+	/* A response is never dropped: wait for the UART to drain. */
+	while (frame_send(&resp_buf, RPC_RESP_HDR_LEN + out_len) == -ENOBUFS) {
+		k_sleep(K_MSEC(2));
+	}
+}
+
+static void rx_byte(uint8_t b)
+{
+	if (b != 0) {
+		if (rx_len < sizeof(rx_frame)) {
+			rx_frame[rx_len++] = b;
+		} else {
+			rx_overflow = true;
+		}
+		return;
+	}
+
+	if (rx_overflow) {
+		stats.rx_bad++;
+	} else if (rx_len > 0) {
+		frame_received(rx_frame, rx_len);
+	}
+	rx_len = 0;
+	rx_overflow = false;
+}
+
+static void rpc_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (!device_is_ready(rpc_uart)) {
+		LOG_ERR("RPC UART %s not ready", rpc_uart->name);
+		return;
+	}
+	uart_irq_callback_user_data_set(rpc_uart, rpc_uart_isr, NULL);
+	uart_irq_rx_enable(rpc_uart);
+	atomic_set(&rpc_running, 1);
+	LOG_INF("Binary RPC on %s", rpc_uart->name);
+
+	for (;;) {
+		uint8_t buf[64];
+		uint32_t n;
+
+		k_sem_take(&rpc_rx_sem, K_FOREVER);
+		do {
+			K_SPINLOCK(&ring_lock) {
+				n = ring_buf_get(&rpc_rx_ring, buf, sizeof(buf));
+			}
+			for (uint32_t i = 0; i < n; i++) {
+				rx_byte(buf[i]);
+			}
+		} while (n > 0);
+	}
+}
+
+K_THREAD_DEFINE(rpc_tid, CONFIG_APP_RPC_STACK_SIZE, rpc_thread, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(8), 0, 0);
+
+static int cmd_rpc(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "RPC: %s on %s, protocol %u", atomic_get(&rpc_running) ? "running" :
+		    "not running", rpc_uart->name, RPC_PROTOCOL_VERSION);
+	shell_print(shell, "RPC: rx_frames=%u rx_bad=%u rx_overruns=%u tx_frames=%u "
+		    "events=%u events_dropped=%u", stats.rx_frames, stats.rx_bad,
+		    stats.rx_overruns, stats.tx_frames, stats.evt_sent, stats.evt_dropped);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(RPC, NULL, "RPC — binary RPC channel counters", cmd_rpc, 1, 0);
+SHELL_CMD_ARG_REGISTER(rpc, NULL, "rpc — binary rpc channel counters", cmd_rpc, 1, 0);
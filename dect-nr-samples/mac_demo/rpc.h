@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RPC_H__
+#define RPC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file rpc.h
+ * @brief Binary RPC and event channel on a dedicated UART.
+ *
+ * Enabled with CONFIG_APP_RPC on the UART chosen as app,rpc-uart (see
+ * rpc.overlay and overlay-rpc.conf); the text shell stays on the console UART.
+ *
+ * Every frame is COBS-encoded and ends in a 0x00 delimiter. The decoded frame
+ * is a message followed by its CRC-16/CCITT-FALSE (little endian):
+ *   request:  [RPC_MSG_REQUEST][seq][op][args...]
+ *   response: [RPC_MSG_RESPONSE][seq][op][status i16][data...]
+ *   event:    [RPC_MSG_EVENT][event seq][event][data...]
+ * Multi-byte fields are little endian. The response echoes the request's
+ * seq and op; status is 0 or a negative errno. python/mac_rpc.py is the
+ * host-side client and the reference for the op and event layouts.
+ */
+
+#define RPC_MSG_REQUEST  0x01
+#define RPC_MSG_RESPONSE 0x02
+#define RPC_MSG_EVENT    0x03
+
+#define RPC_PROTOCOL_VERSION 1
+
+/** Operations. Arguments and response data in brackets. The mode and
+ *  configuration ops run the matching shell command. */
+enum rpc_op {
+	/** [] -> [u32 uptime ms, u8 protocol version] */
+	RPC_OP_PING = 0x01,
+	/** [] -> [struct app_status, packed] */
+	RPC_OP_STATUS = 0x02,
+	/** [u32 long RD ID or 0, payload] -> [] */
+	RPC_OP_SEND = 0x03,
+	/** [shell command line] -> [shell output text]. Runs the command on the
+	 *  dummy shell backend; status is its return value. Text printed with
+	 *  printk() goes to the console, not into the response. */
+	RPC_OP_EXEC = 0x10,
+	/** [u16 channel, 0 = last SCAN result] -> [] */
+	RPC_OP_FT = 0x11,
+	/** [u16 channel] -> [] */
+	RPC_OP_PT = 0x12,
+	/** [u16 channel, 0 = all] -> [] */
+	RPC_OP_PT_SCAN = 0x13,
+	/** [] -> [] */
+	RPC_OP_STOP = 0x14,
+	/** [u32 beacon period ms] -> [] */
+	RPC_OP_PERIOD = 0x15,
+	/** [u8 0|1] -> [] */
+	RPC_OP_POWERSAVE = 0x16,
+	/** [profile name] -> [] */
+	RPC_OP_PROFILE = 0x17,
+};
+
+/** Asynchronous events. */
+enum rpc_event {
+	/** [u8 type (0 network, 1 cluster), u16 channel, u32 long RD ID,
+	 *   u32 network ID, u32 period ms, i16 RSSI dBm] */
+	RPC_EVT_BEACON = 0x81,
+	/** [u8 state (0 released, 1 associated, 2 failed), u32 long RD ID,
+	 *   i16 status] */
+	RPC_EVT_ASSOCIATION = 0x82,
+	/** [u32 long RD ID, payload] for APP_DLC_PORT_DATA payloads */
+	RPC_EVT_DLC_RX = 0x83,
+	/** [telemetry frame] (see telemetry.h) */
+	RPC_EVT_TELEMETRY = 0x84,
+};
+
+/** Association event states. */
+enum rpc_assoc_state {
+	RPC_ASSOC_RELEASED = 0,
+	RPC_ASSOC_UP = 1,
+	RPC_ASSOC_FAILED = 2,
+};
+
+/** Snapshot of the application state for RPC_OP_STATUS. */
+struct app_status {
+	uint8_t mode;               /* 0 idle, 1 FT, 2 PT */
+	bool associated;
+	uint16_t carrier;
+	uint32_t device_long_rd_id;
+	uint32_t peer_long_rd_id;
+	uint32_t beacon_period_ms;
+	uint8_t rach_fill_percentage;
+	bool power_save;
+	uint32_t dlc_rx_dropped;
+	uint32_t evt_dropped;       /* app events lost to a full event queue */
+	uint32_t recoveries;        /* PT auto-recovery cycles started */
+};
+
+/**
+ * @brief Fill in the application state.
+ *
+ * Provided by main.c.
+ *
+ * @param st Output state
+ */
+void app_status_get(struct app_status *st);
+
+#if defined(CONFIG_APP_RPC)
+
+/**
+ * @brief Report a received beacon.
+ *
+ * @param cluster    true for a cluster beacon, false for a network beacon
+ * @param channel    Carrier
+ * @param long_rd_id FT long RD ID
+ * @param network_id Network ID
+ * @param period_ms  Cluster beacon period
+ * @param rssi_dbm   RSSI
+ */
+void rpc_event_beacon(bool cluster, uint16_t channel, uint32_t long_rd_id, uint32_t network_id,
+		      uint32_t period_ms, int16_t rssi_dbm);
+
+/**
+ * @brief Report an association change.
+ *
+ * @param state      enum rpc_assoc_state
+ * @param long_rd_id Peer long RD ID
+ * @param status     Modem status of the association operation
+ */
+void rpc_event_association(uint8_t state, uint32_t long_rd_id, int status);
+
+/**
+ * @brief Report a payload received on APP_DLC_PORT_DATA.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload
+ * @param len        Payload length
+ */
+void rpc_event_dlc_rx(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+/**
+ * @brief Send a telemetry frame.
+ *
+ * @param data Frame
+ * @param len  Frame length
+ */
+void rpc_event_telemetry(const uint8_t *data, size_t len);
+
+#else
+
+static inline void rpc_event_beacon(bool cluster, uint16_t channel, uint32_t long_rd_id,
+				    uint32_t network_id, uint32_t period_ms, int16_t rssi_dbm) {}
+static inline void rpc_event_association(uint8_t state, uint32_t long_rd_id, int status) {}
+static inline void rpc_event_dlc_rx(uint32_t long_rd_id, const uint8_t *data, size_t len) {}
+static inline void rpc_event_telemetry(const uint8_t *data, size_t len) {}
+
+#endif /* CONFIG_APP_RPC */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RPC_H__ */
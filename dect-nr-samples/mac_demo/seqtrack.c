@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "seqtrack.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(seqtrack, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Every PT of an FT, plus the parent of a relay. */
+#define SEQTRACK_PEER_MAX (CONFIG_APP_FT_MAX_PTS + 1)
+#define SEQTRACK_WINDOW   32
+
+struct seq_peer {
+	uint32_t long_rd_id; /* 0 = free slot */
+	uint32_t last_ms;
+	uint16_t tx_seq;     /* next sequence number towards the peer */
+	bool rx_started;
+	bool have_transit;
+	uint16_t rx_max;     /* highest sequence number received */
+	uint32_t rx_window;  /* bit n: rx_max - n received */
+	uint16_t last_transit;
+	struct seqtrack_stats st;
+};
+
+static struct seq_peer peers[SEQTRACK_PEER_MAX];
+static atomic_t numbering = ATOMIC_INIT(IS_ENABLED(CONFIG_APP_SEQTRACK));
+/* Leaf lock: taken from the TX scheduler and telemetry with their locks held. */
+static struct k_spinlock seq_lock;
+
+bool seqtrack_enabled(void)
+{
+	return atomic_get(&numbering) != 0;
+}
+
+void seqtrack_enable(bool enable)
+{
+	atomic_set(&numbering, enable ? 1 : 0);
+}
+
+/* Must be called with seq_lock held. A new peer takes a free slot or the one
+ * idle the longest. */
+static struct seq_peer *peer_get(uint32_t long_rd_id, bool create)
+{
+	struct seq_peer *victim = &peers[0];
+	uint32_t now = k_uptime_get_32();
+
+	for (int i = 0; i < SEQTRACK_PEER_MAX; i++) {
+		if (peers[i].long_rd_id == long_rd_id) {
+			return &peers[i];
+		}
+	}
+	if (!create) {
+		return NULL;
+	}
+	for (int i = 0; i < SEQTRACK_PEER_MAX; i++) {
+		if (peers[i].long_rd_id == 0) {
+			victim = &peers[i];
+			break;
+		}
+		if (now - peers[i].last_ms > now - victim->last_ms) {
+			victim = &peers[i];
+		}
+	}
+
+	memset(victim, 0, sizeof(*victim));
+	victim->long_rd_id = long_rd_id;
+	victim->last_ms = now;
+	return victim;
+}
+
+void seqtrack_stamp(uint8_t *prefix, uint32_t long_rd_id)
+{
+	uint16_t seq = 0;
+
+	K_SPINLOCK(&seq_lock) {
+		struct seq_peer *p = peer_get(long_rd_id, true);
+
+		seq = p->tx_seq++;
+		p->last_ms = k_uptime_get_32();
+	}
+	prefix[0] = APP_DLC_PORT_SEQ;
+	sys_put_le16(seq, &prefix[1]);
+	sys_put_le16((uint16_t)k_uptime_get_32(), &prefix[3]);
+}
+
+/* Account one received sequence number; false for a duplicate. Must be called
+ * with seq_lock held. */
+static bool rx_update_locked(struct seq_peer *p, uint16_t seq)
+{
+	int d = (int16_t)(seq - p->rx_max);
+
+	if (p->rx_started && (d > SEQTRACK_RESYNC || d < -SEQTRACK_RESYNC)) {
+		p->st.resyncs++;
+		p->rx_started = false;
+		p->have_transit = false;
+	}
+	if (!p->rx_started) {
+		p->rx_started = true;
+		p->rx_max = seq;
+		p->rx_window = 1;
+		p->st.received++;
+		return true;
+	}
+
+	if (d > 0) {
+		p->st.lost += d - 1;
+		p->rx_window = (d >= SEQTRACK_WINDOW) ? 1 : (p->rx_window << d) | 1;
+		p->rx_max = seq;
+	} else if (d == 0 || (-d < SEQTRACK_WINDOW && (p->rx_window & BIT(-d)))) {
+		p->st.duplicates++;
+		return false;
+	} else {
+		/* Older than rx_max and not seen in the window: counted lost when
+		 * rx_max moved past it. Beyond the window a duplicate cannot be told
+		 * apart and is counted the same way. */
+		if (-d < SEQTRACK_WINDOW) {
+			p->rx_window |= BIT(-d);
+		}
+		p->st.reordered++;
+		if (p->st.lost > 0) {
+			p->st.lost--;
+		}
+	}
+	p->st.received++;
+	return true;
+}
+
+void seqtrack_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		 app_dlc_dispatch_t dispatch)
+{
+	uint16_t seq, sent_ms, transit;
+	bool deliver = false;
+
+	if (len < SEQTRACK_HDR_LEN + APP_DLC_PORT_HDR_LEN + 1) {
+		LOG_WRN("SEQ from rd=%u: SDU too short (%zu)", long_rd_id, len);
+		return;
+	}
+	if (data[SEQTRACK_HDR_LEN] == APP_DLC_PORT_SEQ) {
+		LOG_WRN("SEQ from rd=%u: nested sequence header dropped", long_rd_id);
+		return;
+	}
+	seq = sys_get_le16(&data[0]);
+	sent_ms = sys_get_le16(&data[2]);
+	transit = (uint16_t)k_uptime_get_32() - sent_ms;
+
+	K_SPINLOCK(&seq_lock) {
+		struct seq_peer *p = peer_get(long_rd_id, true);
+
+		p->last_ms = k_uptime_get_32();
+		deliver = rx_update_locked(p, seq);
+		if (deliver) {
+			/* RFC 3550 A.8: J += (|D| - J) / 16, kept scaled by 16. */
+			if (p->have_transit) {
+				int16_t dt = (int16_t)(transit - p->last_transit);
+
+				p->st.jitter_x16 += abs(dt) - ((p->st.jitter_x16 + 8) >> 4);
+			}
+			p->last_transit = transit;
+			p->have_transit = true;
+		}
+	}
+
+	if (deliver) {
+		dispatch(long_rd_id, data[SEQTRACK_HDR_LEN], &data[SEQTRACK_HDR_LEN + 1],
+			 len - SEQTRACK_HDR_LEN - 1);
+	}
+}
+
+int seqtrack_get(uint32_t long_rd_id, struct seqtrack_stats *out)
+{
+	int err = -ENOENT;
+
+	K_SPINLOCK(&seq_lock) {
+		const struct seq_peer *p = peer_get(long_rd_id, false);
+
+		if (p != NULL && p->st.received != 0) {
+			*out = p->st;
+			err = 0;
+		}
+	}
+	return err;
+}
+
+static int cmd_seq(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "ON") == 0 || strcmp(argv[1], "on") == 0) {
+			seqtrack_enable(true);
+		} else if (strcmp(argv[1], "OFF") == 0 || strcmp(argv[1], "off") == 0) {
+			seqtrack_enable(false);
+		} else if (strcmp(argv[1], "RESET") == 0 || strcmp(argv[1], "reset") == 0) {
+			K_SPINLOCK(&seq_lock) {
+				for (int i = 0; i < SEQTRACK_PEER_MAX; i++) {
+					memset(&peers[i].st, 0, sizeof(peers[i].st));
+					peers[i].rx_started = false;
+					peers[i].have_transit = false;
+				}
+			}
+		} else {
+			shell_error(shell, "Usage: SEQ [ON|OFF|RESET]");
+			return -EINVAL;
+		}
+	}
+
+	shell_print(shell, "SEQ: numbering of sent SDUs %s (+%u B each)",
+		    seqtrack_enabled() ? "on" : "off", SEQTRACK_OVERHEAD);
+	for (int i = 0; i < SEQTRACK_PEER_MAX; i++) {
+		/* One entry at a time: the table is too large for the shell stack. */
+		struct seq_peer copy;
+		const struct seq_peer *p = &copy;
+		uint32_t expected;
+
+		K_SPINLOCK(&seq_lock) {
+			copy = peers[i];
+		}
+		if (p->long_rd_id == 0) {
+			continue;
+		}
+		expected = p->st.received + p->st.lost;
+		shell_print(shell, "  rd=%u tx next=%u rx=%u lost=%u (%u.%u%%) dup=%u reord=%u "
+			    "jitter=%u.%02u ms resync=%u", p->long_rd_id, p->tx_seq, p->st.received,
+			    p->st.lost, expected ? p->st.lost * 100U / expected : 0U,
+			    expected ? (p->st.lost * 1000U / expected) % 10U : 0U,
+			    p->st.duplicates, p->st.reordered, p->st.jitter_x16 / 16U,
+			    (p->st.jitter_x16 % 16U) * 100U / 16U, p->st.resyncs);
+	}
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(SEQ, NULL, "SEQ [ON|OFF|RESET] — per-peer DLC sequence numbers, loss/reorder/jitter", cmd_seq, 1, 1);
+SHELL_CMD_ARG_REGISTER(seq, NULL, "seq [on|off|reset] — per-peer dlc sequence numbers, loss/reorder/jitter", cmd_seq, 1, 1);
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SEQTRACK_H__
+#define SEQTRACK_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "app_dlc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file seqtrack.h
+ * @brief Per-peer sequence numbers on DLC SDUs: loss, duplicates, reordering
+ *        and jitter as seen by the receiver.
+ *
+ * While numbering is on (SEQ ON, CONFIG_APP_SEQTRACK), the TX scheduler wraps
+ * every SDU that still fits on APP_DLC_PORT_SEQ when it first hands it to the
+ * modem:
+ *
+ *   [seq u16][sender uptime ms u16][inner port][payload]   (little endian)
+ *
+ * Sequence numbers count per destination, in the order SDUs go to the modem.
+ * The receiver always unwraps and tracks them, whether or not it numbers its
+ * own SDUs, and hands the inner payload to the normal port dispatch.
+ *
+ * A sequence number up to 32 behind the highest one received is checked
+ * against a bitmap: seen before is a duplicate, otherwise it counts as
+ * reordered and no longer as lost. A jump of more than SEQTRACK_RESYNC in
+ * either direction is taken as the sender restarting its numbering. Jitter is
+ * the RFC 3550 interarrival jitter from the sender timestamps.
+ */
+
+/** Wrapping header after the outer port byte: sequence number and timestamp. */
+#define SEQTRACK_HDR_LEN 4
+
+/** Bytes an SDU grows by when numbered (outer port and header). */
+#define SEQTRACK_OVERHEAD (APP_DLC_PORT_HDR_LEN + SEQTRACK_HDR_LEN)
+
+/** Sequence distance beyond which the sender is taken to have restarted. */
+#define SEQTRACK_RESYNC 1024
+
+/** Receive statistics for one peer. */
+struct seqtrack_stats {
+	/** Numbered SDUs received, duplicates excluded. */
+	uint32_t received;
+	/** Sequence numbers skipped and not received since. */
+	uint32_t lost;
+	/** SDUs received twice. */
+	uint32_t duplicates;
+	/** SDUs received after a higher sequence number. */
+	uint32_t reordered;
+	/** Restarts of the sender's numbering. */
+	uint32_t resyncs;
+	/** Interarrival jitter in 1/16 ms. */
+	uint32_t jitter_x16;
+};
+
+/**
+ * @brief Check whether outgoing SDUs are numbered.
+ *
+ * Callable with any lock held.
+ *
+ * @return true while SEQ is on
+ */
+bool seqtrack_enabled(void);
+
+/**
+ * @brief Turn numbering of outgoing SDUs on or off.
+ *
+ * @param enable true to number SDUs
+ */
+void seqtrack_enable(bool enable);
+
+/**
+ * @brief Write the port byte and header that number one SDU to a peer.
+ *
+ * Called by the TX scheduler once per SDU, when it first goes to the modem.
+ *
+ * @param prefix     Output: SEQTRACK_OVERHEAD bytes in front of the SDU
+ * @param long_rd_id Destination long RD ID
+ */
+void seqtrack_stamp(uint8_t *prefix, uint32_t long_rd_id);
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_SEQ.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload after the port byte
+ * @param len        Payload length
+ * @param dispatch   Port dispatch for the inner payload
+ */
+void seqtrack_rx(uint32_t long_rd_id, const uint8_t *data, size_t len,
+		 app_dlc_dispatch_t dispatch);
+
+/**
+ * @brief Get the receive statistics for a peer.
+ *
+ * @param long_rd_id Peer long RD ID
+ * @param out        Output: statistics
+ * @return 0 on success, -ENOENT if no numbered SDU was received from the peer
+ */
+int seqtrack_get(uint32_t long_rd_id, struct seqtrack_stats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEQTRACK_H__ */
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "spectrum.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include "chan_db.h"
+
+LOG_MODULE_REGISTER(spectrum, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ETSI EN 301 406-2: Band 1 uses the odd channels only. */
+#define BAND1_FIRST 1657
+#define BAND1_LAST  1677
+
+static struct {
+	bool enabled;
+	bool own_next;
+	bool alert;
+	uint16_t alt_channel;
+	uint8_t refused;
+	uint16_t move_to;
+} state = {
+	.enabled = IS_ENABLED(CONFIG_APP_SPECTRUM_MONITOR),
+	.own_next = true,
+};
+
+static struct {
+	uint32_t samples;
+	uint32_t own_samples;
+	uint32_t failed;
+	uint32_t alerts;
+	uint32_t last_alert_ms;
+} stats;
+
+static K_MUTEX_DEFINE(spectrum_mutex);
+
+void spectrum_enable(bool enable)
+{
+	k_mutex_lock(&spectrum_mutex, K_FOREVER);
+	state.enabled = enable;
+	state.refused = 0;
+	k_mutex_unlock(&spectrum_mutex);
+}
+
+bool spectrum_enabled(void)
+{
+	bool enabled;
+
+	k_mutex_lock(&spectrum_mutex, K_FOREVER);
+	enabled = state.enabled;
+	k_mutex_unlock(&spectrum_mutex);
+	return enabled;
+}
+
+uint16_t spectrum_next_channel(uint16_t own_carrier)
+{
+	uint16_t channel = own_carrier;
+
+	k_mutex_lock(&spectrum_mutex, K_FOREVER);
+	if (own_carrier < BAND1_FIRST || own_carrier > BAND1_LAST) {
+		/* Outside Band 1 only the own carrier is watched. */
+		state.own_next = true;
+	} else if (!state.own_next) {
+		do {
+			state.alt_channel = (state.alt_channel < BAND1_FIRST ||
+					     state.alt_channel + 2 > BAND1_LAST)
+						    ? BAND1_FIRST : state.alt_channel + 2;
+		} while (state.alt_channel == own_carrier);
+		channel = state.alt_channel;
+	}
+	state.own_next = !state.own_next;
+	k_mutex_unlock(&spectrum_mutex);
+	return channel;
+}
+
+/* Alert on a busy own carrier or a clearly better alternative; print on
+ * every change of the verdict only. Must be called with spectrum_mutex held. */
+static void evaluate_locked(uint16_t own_carrier)
+{
+	/* Static: this runs on the system workqueue's small stack. */
+	static struct chan_db_entry ranked[CONFIG_APP_CHAN_DB_SIZE];
+	struct chan_db_entry own;
+	const struct chan_db_entry *best = NULL;
+	size_t n = chan_db_rank(ranked, ARRAY_SIZE(ranked));
+	bool busy, better;
+
+	if (chan_db_get(own_carrier, &own) != 0 || own.samples == 0) {
+		return;
+	}
+	for (size_t i = 0; i < n; i++) {
+		if (ranked[i].channel != own_carrier && ranked[i].samples != 0) {
+			best = &ranked[i];
+			break;
+		}
+	}
+
+	busy = own.busy_avg_x10 >= CONFIG_APP_SPECTRUM_BUSY_WARN * 10U;
+	better = best != NULL &&
+		 best->score + CONFIG_APP_SPECTRUM_MOVE_MARGIN * 10U < own.score;
+	if ((busy || better) && !state.alert) {
+		state.alert = true;
+		state.move_to = (best != NULL && best->score < own.score) ? best->channel : 0;
+		stats.alerts++;
+		stats.last_alert_ms = k_uptime_get_32();
+		printk("SPECTRUM: ch=%u avg busy %u.%u%% +-%u.%u, score %u.%u", own_carrier,
+		       own.busy_avg_x10 / 10U, own.busy_avg_x10 % 10U, own.busy_sd_x10 / 10U,
+		       own.busy_sd_x10 % 10U, own.score / 10U, own.score % 10U);
+		if (state.move_to != 0) {
+			printk(" — ch=%u scores %u.%u, plan a move (FT %u)\n", best->channel,
+			       best->score / 10U, best->score % 10U, best->channel);
+		} else {
+			printk(" — no better channel known yet\n");
+		}
+	} else if (!busy && !better && state.alert) {
+		state.alert = false;
+		state.move_to = 0;
+		printk("SPECTRUM: ch=%u back to avg busy %u.%u%%\n", own_carrier,
+		       own.busy_avg_x10 / 10U, own.busy_avg_x10 % 10U);
+	}
+}
+
+void spectrum_note_scan(uint16_t channel, uint16_t own_carrier, int err)
+{
+	k_mutex_lock(&spectrum_mutex, K_FOREVER);
+	if (err != 0) {
+		stats.failed++;
+		if (++state.refused >= SPECTRUM_REFUSED_MAX && state.enabled) {
+			state.enabled = false;
+			LOG_WRN("SPECTRUM: %u RSSI scans refused while beaconing (last %d), "
+				"monitor off", state.refused, err);
+		}
+		k_mutex_unlock(&spectrum_mutex);
+		return;
+	}
+
+	state.refused = 0;
+	stats.samples++;
+	if (channel == own_carrier) {
+		stats.own_samples++;
+		evaluate_locked(own_carrier);
+	}
+	k_mutex_unlock(&spectrum_mutex);
+}
+
+static int cmd_spectrum(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "ON") == 0 || strcmp(argv[1], "on") == 0) {
+			spectrum_enable(true);
+		} else if (strcmp(argv[1], "OFF") == 0 || strcmp(argv[1], "off") == 0) {
+			spectrum_enable(false);
+		} else {
+			shell_error(shell, "Usage: SPECTRUM [ON|OFF]");
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&spectrum_mutex, K_FOREVER);
+	shell_print(shell, "SPECTRUM monitor: %s, one %u-frame sample every %u ms while beaconing, "
+		    "alert at %u%% avg busy or %u points behind another channel",
+		    state.enabled ? "on" : "off", SPECTRUM_SCAN_FRAMES,
+		    CONFIG_APP_SPECTRUM_INTERVAL_MS, CONFIG_APP_SPECTRUM_BUSY_WARN,
+		    CONFIG_APP_SPECTRUM_MOVE_MARGIN);
+	if (state.alert && state.move_to != 0) {
+		shell_print(shell, "SPECTRUM: alert since %u s ago, best move: FT %u",
+			    (k_uptime_get_32() - stats.last_alert_ms) / 1000U, state.move_to);
+	} else if (state.alert) {
+		shell_print(shell, "SPECTRUM: alert since %u s ago, no better channel known yet",
+			    (k_uptime_get_32() - stats.last_alert_ms) / 1000U);
+	} else {
+		shell_print(shell, "SPECTRUM: own carrier fine");
+	}
+	shell_print(shell, "SPECTRUM: samples=%u own=%u failed=%u alerts=%u (SCAN prints the table)",
+		    stats.samples, stats.own_samples, stats.failed, stats.alerts);
+	k_mutex_unlock(&spectrum_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(SPECTRUM, NULL, "SPECTRUM [ON|OFF] — background channel monitor on an FT", cmd_spectrum, 1, 1);
+SHELL_CMD_ARG_REGISTER(spectrum, NULL, "spectrum [on|off] — background channel monitor on an ft", cmd_spectrum, 1, 1);
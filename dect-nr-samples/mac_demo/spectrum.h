@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SPECTRUM_H__
+#define SPECTRUM_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file spectrum.h
+ * @brief Background spectrum monitoring on an active FT.
+ *
+ * Every CONFIG_APP_SPECTRUM_INTERVAL_MS the beaconing FT measures one channel
+ * for SPECTRUM_SCAN_FRAMES frames: every other sample its own carrier, in
+ * between the other Band 1 channels in turn. Results go into the channel
+ * history (chan_db.h) like any RSSI scan.
+ *
+ * After each sample of its own carrier the monitor raises an alert when the
+ * carrier's average busy percentage reaches CONFIG_APP_SPECTRUM_BUSY_WARN, or
+ * another channel scores CONFIG_APP_SPECTRUM_MOVE_MARGIN points better, and
+ * names the channel to move to. Moving is left to the operator (FT <ch>), as
+ * it drops the associations. After SPECTRUM_REFUSED_MAX refused scans in a
+ * row the monitor concludes that the modem does not scan while beaconing and
+ * turns itself off.
+ */
+
+/** Measurement length of one monitor sample, in frames. */
+#define SPECTRUM_SCAN_FRAMES 2
+
+/** Refused scans in a row that turn the monitor off. */
+#define SPECTRUM_REFUSED_MAX 3
+
+/**
+ * @brief Turn the monitor on or off.
+ *
+ * @param enable true to sample from the next interval on
+ */
+void spectrum_enable(bool enable);
+
+/** @brief Check whether the monitor is on. */
+bool spectrum_enabled(void);
+
+/**
+ * @brief Pick the channel for the next sample.
+ *
+ * @param own_carrier Carrier the FT beacons on
+ * @return Channel to measure
+ */
+uint16_t spectrum_next_channel(uint16_t own_carrier);
+
+/**
+ * @brief Report the outcome of a sample.
+ *
+ * Evaluates the own carrier after it was measured and counts refusals.
+ *
+ * @param channel     Channel measured
+ * @param own_carrier Carrier the FT beacons on
+ * @param err         0 if the scan completed, else the error
+ */
+void spectrum_note_scan(uint16_t channel, uint16_t own_carrier, int err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPECTRUM_H__ */
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "telemetry.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/base64.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include "rpc.h"
+#include "seqtrack.h"
+
+LOG_MODULE_REGISTER(telemetry, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define TELEMETRY_PEER_MAX       (CONFIG_APP_FT_MAX_PTS + 1) /* associated PTs and the relay parent */
+#define TELEMETRY_HDR_LEN        52 /* up to and including the peer count */
+#define TELEMETRY_PEER_LEN       40
+#define TELEMETRY_FRAME_LEN_MAX  (TELEMETRY_HDR_LEN + TELEMETRY_PEER_MAX * TELEMETRY_PEER_LEN)
+#define TELEMETRY_INTERVAL_MS_MIN 100
+
+struct tlm_peer {
+	uint32_t long_rd_id; /* 0 = free slot */
+	int16_t rssi_dbm;
+	uint32_t tx_ok;
+	uint32_t tx_fail;
+	uint32_t rx_sdus;
+	uint32_t last_rx_ms;
+};
+
+static struct tlm_peer peers[TELEMETRY_PEER_MAX];
+static struct {
+	uint32_t tx_ok;
+	uint32_t tx_fail;
+	uint32_t tx_bytes;
+	uint32_t rx_sdus;
+	uint32_t rx_bytes;
+} totals;
+static uint32_t interval_ms = CONFIG_APP_TELEMETRY_INTERVAL_MS;
+static uint16_t frame_seq;
+static uint32_t frames_sent;
+
+/* Leaf lock: taken with tx_sched_mutex held from tx_sched_tx_done(). */
+static K_MUTEX_DEFINE(telemetry_mutex);
+
+static void telemetry_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(telemetry_work, telemetry_work_handler);
+
+/* Must be called with telemetry_mutex held. A new peer takes a free slot or
+ * the one heard from longest ago. */
+static struct tlm_peer *peer_get(uint32_t long_rd_id)
+{
+	struct tlm_peer *victim = &peers[0];
+	uint32_t now = k_uptime_get_32();
+
+	for (int i = 0; i < TELEMETRY_PEER_MAX; i++) {
+		if (peers[i].long_rd_id == long_rd_id) {
+			return &peers[i];
+		}
+	}
+	for (int i = 0; i < TELEMETRY_PEER_MAX; i++) {
+		if (peers[i].long_rd_id == 0) {
+			victim = &peers[i];
+			break;
+		}
+		if (now - peers[i].last_rx_ms > now - victim->last_rx_ms) {
+			victim = &peers[i];
+		}
+	}
+
+	memset(victim, 0, sizeof(*victim));
+	victim->long_rd_id = long_rd_id;
+	victim->rssi_dbm = TELEMETRY_RSSI_UNKNOWN;
+	victim->last_rx_ms = now;
+	return victim;
+}
+
+void telemetry_note_tx(uint32_t long_rd_id, size_t sdu_len, int status)
+{
+	struct tlm_peer *p;
+
+	if (long_rd_id == 0) {
+		return;
+	}
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+	p = peer_get(long_rd_id);
+	if (status == 0) {
+		p->tx_ok++;
+		totals.tx_ok++;
+		totals.tx_bytes += sdu_len;
+	} else {
+		p->tx_fail++;
+		totals.tx_fail++;
+	}
+	k_mutex_unlock(&telemetry_mutex);
+}
+
+void telemetry_note_rx(uint32_t long_rd_id, size_t sdu_len)
+{
+	struct tlm_peer *p;
+
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+	p = peer_get(long_rd_id);
+	p->rx_sdus++;
+	p->last_rx_ms = k_uptime_get_32();
+	totals.rx_sdus++;
+	totals.rx_bytes += sdu_len;
+	k_mutex_unlock(&telemetry_mutex);
+}
+
+void telemetry_note_rssi(uint32_t long_rd_id, int16_t rssi_dbm)
+{
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+	peer_get(long_rd_id)->rssi_dbm = rssi_dbm;
+	k_mutex_unlock(&telemetry_mutex);
+}
+
+/* Build one frame into buf (TELEMETRY_FRAME_LEN_MAX bytes); returns its length. */
+static size_t frame_build(uint8_t *buf)
+{
+	struct app_status st;
+	uint32_t now = k_uptime_get_32();
+	uint8_t *p = buf;
+	uint8_t *count;
+
+	app_status_get(&st);
+
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+	*p++ = TELEMETRY_VERSION;
+	sys_put_le32(now, p); p += 4;
+	sys_put_le16(frame_seq++, p); p += 2;
+	*p++ = st.mode;
+	*p++ = st.associated ? 1 : 0;
+	sys_put_le16(st.carrier, p); p += 2;
+	sys_put_le32(st.device_long_rd_id, p); p += 4;
+	sys_put_le32(st.beacon_period_ms, p); p += 4;
+	sys_put_le32(totals.tx_ok, p); p += 4;
+	sys_put_le32(totals.tx_fail, p); p += 4;
+	sys_put_le32(totals.tx_bytes, p); p += 4;
+	sys_put_le32(totals.rx_sdus, p); p += 4;
+	sys_put_le32(totals.rx_bytes, p); p += 4;
+	sys_put_le32(st.evt_dropped, p); p += 4;
+	sys_put_le32(st.dlc_rx_dropped, p); p += 4;
+	sys_put_le32(st.recoveries, p); p += 4;
+	count = p++;
+	*count = 0;
+	for (int i = 0; i < TELEMETRY_PEER_MAX; i++) {
+		const struct tlm_peer *peer = &peers[i];
+		struct seqtrack_stats seq = {0};
+
+		if (peer->long_rd_id == 0) {
+			continue;
+		}
+		(void)seqtrack_get(peer->long_rd_id, &seq);
+		sys_put_le32(peer->long_rd_id, p); p += 4;
+		sys_put_le16((uint16_t)peer->rssi_dbm, p); p += 2;
+		sys_put_le32(peer->tx_ok, p); p += 4;
+		sys_put_le32(peer->tx_fail, p); p += 4;
+		sys_put_le32(peer->rx_sdus, p); p += 4;
+		sys_put_le32(now - peer->last_rx_ms, p); p += 4;
+		sys_put_le32(seq.received, p); p += 4;
+		sys_put_le32(seq.lost, p); p += 4;
+		sys_put_le32(seq.duplicates, p); p += 4;
+		sys_put_le32(seq.reordered, p); p += 4;
+		sys_put_le16((uint16_t)MIN(seq.jitter_x16, UINT16_MAX), p); p += 2;
+		(*count)++;
+	}
+	k_mutex_unlock(&telemetry_mutex);
+
+	return p - buf;
+}
+
+/* Only used from telemetry_work; static to keep them off the work queue stack. */
+static uint8_t frame[TELEMETRY_FRAME_LEN_MAX + 2];
+#if !defined(CONFIG_APP_RPC)
+static uint8_t frame_b64[DIV_ROUND_UP(sizeof(frame), 3) * 4 + 1];
+#endif
+
+static void frame_emit(void)
+{
+	size_t len = frame_build(frame);
+
+#if defined(CONFIG_APP_RPC)
+	/* RPC frames carry their own CRC. */
+	rpc_event_telemetry(frame, len);
+#else
+	size_t b64_len;
+
+	sys_put_le16(crc16_itu_t(0xffff, frame, len), &frame[len]);
+	if (base64_encode(frame_b64, sizeof(frame_b64), &b64_len, frame, len + 2) == 0) {
+		printk("TLM %s\n", (const char *)frame_b64);
+	}
+#endif
+	frames_sent++;
+}
+
+static void telemetry_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (interval_ms == 0) {
+		return;
+	}
+	frame_emit();
+	k_work_reschedule(&telemetry_work, K_MSEC(interval_ms));
+}
+
+void telemetry_interval_set(uint32_t new_interval_ms)
+{
+	interval_ms = new_interval_ms;
+	if (interval_ms == 0) {
+		k_work_cancel_delayable(&telemetry_work);
+	} else {
+		k_work_reschedule(&telemetry_work, K_MSEC(interval_ms));
+	}
+}
+
+void telemetry_init(void)
+{
+	telemetry_interval_set(interval_ms);
+}
+
+static int cmd_telemetry(const struct shell *shell, size_t argc, char **argv)
+{
+	long new_interval;
+
+	if (argc >= 2) {
+		new_interval = strtol(argv[1], NULL, 10);
+		if (new_interval != 0 &&
+		    (new_interval < TELEMETRY_INTERVAL_MS_MIN || new_interval > 3600000)) {
+			shell_error(shell, "Interval must be 0 (off) or %u..3600000 ms",
+				    TELEMETRY_INTERVAL_MS_MIN);
+			return -EINVAL;
+		}
+		telemetry_interval_set((uint32_t)new_interval);
+	}
+
+	if (interval_ms == 0) {
+		shell_print(shell, "Telemetry: off");
+	} else {
+		shell_print(shell, "Telemetry: every %u ms on %s", interval_ms,
+			    IS_ENABLED(CONFIG_APP_RPC) ? "the RPC UART" : "the console (TLM lines)");
+	}
+
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+	shell_print(shell, "Telemetry: frames=%u, TX ok=%u failed=%u (%u B), RX %u SDUs (%u B)",
+		    frames_sent, totals.tx_ok, totals.tx_fail, totals.tx_bytes, totals.rx_sdus,
+		    totals.rx_bytes);
+	for (int i = 0; i < TELEMETRY_PEER_MAX; i++) {
+		const struct tlm_peer *p = &peers[i];
+
+		if (p->long_rd_id == 0) {
+			continue;
+		}
+		if (p->rssi_dbm == TELEMETRY_RSSI_UNKNOWN) {
+			shell_print(shell, "  rd=%u rssi=- tx_ok=%u tx_fail=%u rx=%u last_rx=%u ms ago",
+				    p->long_rd_id, p->tx_ok, p->tx_fail, p->rx_sdus,
+				    k_uptime_get_32() - p->last_rx_ms);
+		} else {
+			shell_print(shell, "  rd=%u rssi=%d dBm tx_ok=%u tx_fail=%u rx=%u "
+				    "last_rx=%u ms ago", p->long_rd_id, p->rssi_dbm, p->tx_ok,
+				    p->tx_fail, p->rx_sdus, k_uptime_get_32() - p->last_rx_ms);
+		}
+	}
+	k_mutex_unlock(&telemetry_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(TELEMETRY, NULL, "TELEMETRY [interval_ms] — periodic binary status frames (0 = off)", cmd_telemetry, 1, 1);
+SHELL_CMD_ARG_REGISTER(telemetry, NULL, "telemetry [interval_ms] — periodic binary status frames (0 = off)", cmd_telemetry, 1, 1);
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TELEMETRY_H__
+#define TELEMETRY_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file telemetry.h
+ * @brief Periodic binary telemetry frames and per-peer link counters.
+ *
+ * Every TELEMETRY interval one frame is emitted: as an RPC_EVT_TELEMETRY event
+ * on the binary RPC UART when CONFIG_APP_RPC is set, otherwise as a console
+ * line "TLM <base64>" whose decoded bytes end in a CRC-16/CCITT-FALSE of the
+ * frame. The frame is little endian:
+ *
+ *   u8  version (TELEMETRY_VERSION)
+ *   u32 uptime ms, u16 sequence
+ *   u8  mode (0 idle, 1 FT, 2 PT), u8 associated, u16 carrier
+ *   u32 device long RD ID, u32 beacon period ms
+ *   u32 TX ok, u32 TX failed, u32 TX bytes, u32 RX SDUs, u32 RX bytes
+ *   u32 event queue drops, u32 DLC RX drops, u32 PT recoveries
+ *   u8  peer count, then per peer:
+ *     u32 long RD ID, i16 last beacon RSSI dBm (TELEMETRY_RSSI_UNKNOWN if
+ *     none), u32 TX ok, u32 TX failed, u32 RX SDUs, u32 ms since last RX,
+ *     u32 numbered SDUs received (0 if the peer does not number them, see
+ *     seqtrack.h), u32 lost, u32 duplicates, u32 reordered,
+ *     u16 jitter in 1/16 ms (saturates)
+ */
+
+#define TELEMETRY_VERSION 2
+
+/** RSSI of a peer whose beacons are not received (e.g. PTs seen by an FT). */
+#define TELEMETRY_RSSI_UNKNOWN INT16_MIN
+
+/**
+ * @brief Start the periodic frames with the CONFIG_APP_TELEMETRY_INTERVAL_MS
+ *        interval (nothing is sent while it is 0).
+ */
+void telemetry_init(void);
+
+/**
+ * @brief Set the frame interval.
+ *
+ * @param interval_ms Interval in milliseconds, 0 stops the frames
+ */
+void telemetry_interval_set(uint32_t interval_ms);
+
+/**
+ * @brief Count one modem DLC TX completion towards a peer.
+ *
+ * @param long_rd_id Destination long RD ID
+ * @param sdu_len    SDU length in bytes
+ * @param status     Completion status (0 = success)
+ */
+void telemetry_note_tx(uint32_t long_rd_id, size_t sdu_len, int status);
+
+/**
+ * @brief Count one received DLC SDU from a peer.
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param sdu_len    SDU length in bytes
+ */
+void telemetry_note_rx(uint32_t long_rd_id, size_t sdu_len);
+
+/**
+ * @brief Record the RSSI of a beacon received from a peer.
+ *
+ * @param long_rd_id FT long RD ID
+ * @param rssi_dbm   RSSI
+ */
+void telemetry_note_rssi(uint32_t long_rd_id, int16_t rssi_dbm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H__ */
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "timesync.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+#include "app_dlc.h"
+#include "rpc.h"
+
+LOG_MODULE_REGISTER(timesync, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define TS_MSG_REQUEST 1
+#define TS_MSG_REPLY   2
+#define TS_MSG_PROBE   3
+#define TS_FLAG_SYNCED BIT(0) /* reply: t2 and t3 are network time */
+#define TS_REQUEST_LEN 12
+#define TS_REPLY_LEN   28
+#define TS_PROBE_LEN   16
+#define TS_BURST_MS    500      /* request interval until the sample window is full */
+#define TS_DELAY_SLACK_US 500   /* samples this close to the best delay fit the skew */
+#define TS_SKEW_SPAN_MS 5000    /* least local time span for a skew estimate */
+#define TS_SKEW_MAX_PPB 200000  /* beyond any crystal pair: a bad fit */
+#define TS_PROBE_INTERVAL_MS 100
+#define TS_PROBE_MAX   1000
+
+/* struct app_status mode values. */
+#define TS_MODE_FT 1
+#define TS_MODE_PT 2
+
+struct ts_sample {
+	int64_t local_us;  /* midpoint of t1 and t4 */
+	int64_t offset_us;
+	uint32_t delay_us;
+};
+
+static struct {
+	uint32_t server;   /* parent the samples were taken against */
+	uint16_t seq;      /* of the last request */
+	bool pending;
+	struct ts_sample samples[TIMESYNC_SAMPLES];
+	uint8_t count;
+	uint8_t next;
+	bool synced;
+	int64_t base_local_us;
+	int64_t base_offset_us;
+	int32_t skew_ppb;
+	bool skew_valid;
+	uint32_t delay_us;
+	uint32_t last_sync_ms;
+} ts;
+
+static struct {
+	uint32_t requests;
+	uint32_t replies;
+	uint32_t timeouts;  /* requests not answered before the next one */
+	uint32_t unsynced;  /* replies from a parent without network time */
+	uint32_t send_err;
+	uint32_t answered;
+} stats;
+
+static struct {
+	uint32_t to_send;
+	uint32_t sent;
+	uint32_t received;
+	uint32_t unsynced;
+	int64_t min_us;
+	int64_t max_us;
+	int64_t sum_us;
+} probe;
+
+/* Leaf lock: never held while sending or reading the application state. */
+static K_MUTEX_DEFINE(timesync_mutex);
+
+static void sync_work_handler(struct k_work *work);
+static void probe_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(sync_work, sync_work_handler);
+static K_WORK_DELAYABLE_DEFINE(probe_work, probe_work_handler);
+
+static int64_t uptime_us(void)
+{
+	return (int64_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* Must be called with timesync_mutex held and ts.synced set. */
+static int64_t offset_at_locked(int64_t local_us)
+{
+	return ts.base_offset_us + (local_us - ts.base_local_us) * ts.skew_ppb / 1000000000LL;
+}
+
+int timesync_from_local_us(int64_t local_us, int64_t *time_us)
+{
+	struct app_status st;
+	int err = 0;
+
+	app_status_get(&st);
+	if (st.mode == TS_MODE_FT) {
+		*time_us = local_us;
+		return 0;
+	}
+	if (st.mode != TS_MODE_PT) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (ts.synced) {
+		*time_us = local_us + offset_at_locked(local_us);
+	} else {
+		err = -EAGAIN;
+	}
+	k_mutex_unlock(&timesync_mutex);
+	return err;
+}
+
+int timesync_now_us(int64_t *time_us)
+{
+	return timesync_from_local_us(uptime_us(), time_us);
+}
+
+/* Must be called with timesync_mutex held. */
+static void samples_reset_locked(uint32_t server)
+{
+	memset(&ts, 0, sizeof(ts));
+	ts.server = server;
+}
+
+/* Offset from the lowest-delay samples: a least-squares line over local time
+ * once they span TS_SKEW_SPAN_MS, otherwise the newest of them. Must be
+ * called with timesync_mutex held. */
+static void estimate_locked(void)
+{
+	const struct ts_sample *newest = NULL;
+	uint32_t best_delay = UINT32_MAX;
+	uint32_t limit;
+	int64_t mean_local = 0, mean_offset = 0, lo = INT64_MAX, hi = INT64_MIN;
+	int64_t num = 0, den = 0;
+	int n = 0;
+
+	for (int i = 0; i < ts.count; i++) {
+		best_delay = MIN(best_delay, ts.samples[i].delay_us);
+	}
+	limit = 2U * best_delay + TS_DELAY_SLACK_US;
+
+	for (int i = 0; i < ts.count; i++) {
+		const struct ts_sample *s = &ts.samples[i];
+
+		if (s->delay_us > limit) {
+			continue;
+		}
+		if (newest == NULL || s->local_us > newest->local_us) {
+			newest = s;
+		}
+		mean_local += s->local_us;
+		mean_offset += s->offset_us;
+		lo = MIN(lo, s->local_us);
+		hi = MAX(hi, s->local_us);
+		n++;
+	}
+	mean_local /= n;
+	mean_offset /= n;
+
+	ts.skew_valid = false;
+	if (n >= 3 && hi - lo >= TS_SKEW_SPAN_MS * 1000LL) {
+		for (int i = 0; i < ts.count; i++) {
+			const struct ts_sample *s = &ts.samples[i];
+			int64_t dt_ms = (s->local_us - mean_local) / 1000;
+
+			if (s->delay_us > limit) {
+				continue;
+			}
+			num += dt_ms * (s->offset_us - mean_offset);
+			den += dt_ms * dt_ms;
+		}
+		/* Slope in us per ms, times 1e6: parts per billion. Over long spans
+		 * num * 1e6 would overflow; den is then large enough to scale instead. */
+		if (den != 0) {
+			int64_t ppb = den >= 1000000000000LL ? num / (den / 1000000)
+							     : num * 1000000 / den;
+
+			if (llabs(ppb) <= TS_SKEW_MAX_PPB) {
+				ts.skew_ppb = (int32_t)ppb;
+				ts.skew_valid = true;
+			}
+		}
+	}
+
+	if (ts.skew_valid) {
+		ts.base_local_us = mean_local;
+		ts.base_offset_us = mean_offset;
+	} else {
+		ts.skew_ppb = 0;
+		ts.base_local_us = newest->local_us;
+		ts.base_offset_us = newest->offset_us;
+	}
+	ts.delay_us = best_delay;
+	ts.synced = true;
+	ts.last_sync_ms = k_uptime_get_32();
+}
+
+static void sync_work_handler(struct k_work *work)
+{
+	uint8_t msg[TS_REQUEST_LEN];
+	uint32_t parent;
+	uint32_t next_ms;
+	int err;
+
+	ARG_UNUSED(work);
+
+	if (CONFIG_APP_TIMESYNC_INTERVAL_MS == 0 || app_dlc_parent_get(&parent) != 0) {
+		return;
+	}
+
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (parent != ts.server) {
+		samples_reset_locked(parent);
+	}
+	if (ts.pending) {
+		stats.timeouts++;
+	}
+	ts.pending = true;
+	msg[0] = TS_MSG_REQUEST;
+	msg[1] = 0;
+	sys_put_le16(++ts.seq, &msg[2]);
+	next_ms = ts.count < TIMESYNC_SAMPLES ? TS_BURST_MS : CONFIG_APP_TIMESYNC_INTERVAL_MS;
+	k_mutex_unlock(&timesync_mutex);
+
+	sys_put_le64((uint64_t)uptime_us(), &msg[4]);
+	err = app_dlc_flow_send(parent, APP_DLC_FLOW_SIGNALLING, APP_DLC_PORT_TIME, msg,
+				sizeof(msg), NULL);
+
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (err != 0) {
+		ts.pending = false;
+		stats.send_err++;
+	} else {
+		stats.requests++;
+	}
+	k_mutex_unlock(&timesync_mutex);
+
+	k_work_reschedule(&sync_work, K_MSEC(next_ms));
+}
+
+void timesync_link_up(void)
+{
+	/* Samples are dropped on the first request if the parent changed. */
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	ts.pending = false;
+	k_mutex_unlock(&timesync_mutex);
+	k_work_reschedule(&sync_work, K_NO_WAIT);
+}
+
+static void request_answer(uint32_t long_rd_id, const uint8_t *data)
+{
+	uint8_t reply[TS_REPLY_LEN];
+	int64_t t2, t3;
+	bool synced = timesync_from_local_us((int64_t)app_dlc_rx_time_us(), &t2) == 0;
+
+	reply[0] = TS_MSG_REPLY;
+	memcpy(&reply[2], &data[2], 2 + 8); /* sequence number and t1 */
+	synced = synced && timesync_now_us(&t3) == 0;
+	reply[1] = synced ? TS_FLAG_SYNCED : 0;
+	sys_put_le64(synced ? (uint64_t)t2 : 0, &reply[12]);
+	sys_put_le64(synced ? (uint64_t)t3 : 0, &reply[20]);
+
+	if (app_dlc_flow_send(long_rd_id, APP_DLC_FLOW_SIGNALLING, APP_DLC_PORT_TIME, reply,
+			      sizeof(reply), NULL) == 0) {
+		k_mutex_lock(&timesync_mutex, K_FOREVER);
+		stats.answered++;
+		k_mutex_unlock(&timesync_mutex);
+	}
+}
+
+static void reply_take(uint32_t long_rd_id, const uint8_t *data)
+{
+	int64_t t4 = (int64_t)app_dlc_rx_time_us();
+	int64_t t1 = (int64_t)sys_get_le64(&data[4]);
+	int64_t t2 = (int64_t)sys_get_le64(&data[12]);
+	int64_t t3 = (int64_t)sys_get_le64(&data[20]);
+	int64_t delay = (t4 - t1) - (t3 - t2);
+	struct ts_sample *s;
+
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (!ts.pending || long_rd_id != ts.server || sys_get_le16(&data[2]) != ts.seq) {
+		k_mutex_unlock(&timesync_mutex);
+		return;
+	}
+	ts.pending = false;
+	if ((data[1] & TS_FLAG_SYNCED) == 0) {
+		stats.unsynced++;
+		k_mutex_unlock(&timesync_mutex);
+		return;
+	}
+
+	s = &ts.samples[ts.next];
+	s->local_us = t1 + (t4 - t1) / 2;
+	s->offset_us = ((t2 - t1) + (t3 - t4)) / 2;
+	s->delay_us = (uint32_t)CLAMP(delay, 0, INT32_MAX);
+	ts.next = (ts.next + 1) % TIMESYNC_SAMPLES;
+	ts.count = MIN(ts.count + 1, TIMESYNC_SAMPLES);
+	stats.replies++;
+	estimate_locked();
+	k_mutex_unlock(&timesync_mutex);
+}
+
+static void probe_take(const uint8_t *data)
+{
+	int64_t sent = (int64_t)sys_get_le64(&data[4]);
+	int64_t now, one_way;
+	int err = timesync_from_local_us((int64_t)app_dlc_rx_time_us(), &now);
+
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (err != 0) {
+		probe.unsynced++;
+	} else {
+		one_way = now - sent;
+		probe.min_us = probe.received == 0 ? one_way : MIN(probe.min_us, one_way);
+		probe.max_us = probe.received == 0 ? one_way : MAX(probe.max_us, one_way);
+		probe.sum_us += one_way;
+		probe.received++;
+	}
+	k_mutex_unlock(&timesync_mutex);
+}
+
+void timesync_rx(uint32_t long_rd_id, const uint8_t *data, size_t len)
+{
+	if (len >= TS_REQUEST_LEN && data[0] == TS_MSG_REQUEST) {
+		request_answer(long_rd_id, data);
+	} else if (len >= TS_REPLY_LEN && data[0] == TS_MSG_REPLY) {
+		reply_take(long_rd_id, data);
+	} else if (len >= TS_PROBE_LEN && data[0] == TS_MSG_PROBE) {
+		probe_take(data);
+	} else {
+		LOG_WRN("TIME from rd=%u: bad message (type %u, %zu B)", long_rd_id,
+			len > 0 ? data[0] : 0U, len);
+	}
+}
+
+static void probe_work_handler(struct k_work *work)
+{
+	uint8_t msg[TS_PROBE_LEN] = {TS_MSG_PROBE};
+	int64_t now;
+	uint32_t index;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (probe.to_send == 0) {
+		k_mutex_unlock(&timesync_mutex);
+		return;
+	}
+	probe.to_send--;
+	index = probe.sent++;
+	k_mutex_unlock(&timesync_mutex);
+
+	if (timesync_now_us(&now) == 0) {
+		sys_put_le64((uint64_t)now, &msg[4]);
+		sys_put_le32(index, &msg[12]);
+		(void)app_dlc_flow_send(0, APP_DLC_FLOW_SIGNALLING, APP_DLC_PORT_TIME, msg,
+					sizeof(msg), NULL);
+	}
+	k_work_reschedule(&probe_work, K_MSEC(TS_PROBE_INTERVAL_MS));
+}
+
+static void print_sync(const struct shell *shell)
+{
+	struct app_status st;
+	int64_t now;
+
+	app_status_get(&st);
+	if (st.mode == TS_MODE_FT) {
+		shell_print(shell, "TIME: FT, network time is this device's uptime");
+	}
+	k_mutex_lock(&timesync_mutex, K_FOREVER);
+	if (st.mode == TS_MODE_PT && ts.synced) {
+		uint32_t skew = (uint32_t)abs(ts.skew_ppb);
+
+		shell_print(shell, "TIME: synced to rd=%u, offset %lld us, skew %s%u.%03u ppm%s, "
+			    "delay %u us (error within +-%u us), %u sample(s), last %u s ago",
+			    ts.server, (long long)offset_at_locked(uptime_us()), ts.skew_ppb < 0 ? "-" : "+",
+			    skew / 1000U, skew % 1000U, ts.skew_valid ? "" : " (not yet estimated)",
+			    ts.delay_us, ts.delay_us / 2U, ts.count,
+			    (k_uptime_get_32() - ts.last_sync_ms) / 1000U);
+	} else if (st.mode == TS_MODE_PT) {
+		shell_print(shell, "TIME: not synced yet%s",
+			    CONFIG_APP_TIMESYNC_INTERVAL_MS == 0 ? " (CONFIG_APP_TIMESYNC_INTERVAL_MS is 0)"
+								 : "");
+	} else if (st.mode != TS_MODE_FT) {
+		shell_print(shell, "TIME: idle, no network time");
+	}
+	shell_print(shell, "TIME: requests=%u replies=%u timeouts=%u unsynced=%u send_err=%u "
+		    "answered=%u", stats.requests, stats.replies, stats.timeouts, stats.unsynced,
+		    stats.send_err, stats.answered);
+	if (probe.received != 0) {
+		shell_print(shell, "TIME: %u probe(s) received, one-way min/avg/max %lld/%lld/%lld us"
+			    " (%u without network time)", probe.received,
+			    (long long)probe.min_us, (long long)(probe.sum_us / probe.received),
+			    (long long)probe.max_us, probe.unsynced);
+	}
+	k_mutex_unlock(&timesync_mutex);
+
+	if (timesync_now_us(&now) == 0) {
+		shell_print(shell, "TIME: network time %lld.%06lld s", (long long)(now / 1000000),
+			    (long long)(now % 1000000));
+	}
+}
+
+static int cmd_time(const struct shell *shell, size_t argc, char **argv)
+{
+	long count = 10;
+
+	if (argc > 1 && (strcmp(argv[1], "PROBE") == 0 || strcmp(argv[1], "probe") == 0)) {
+		int64_t now;
+
+		if (argc > 2) {
+			count = strtol(argv[2], NULL, 10);
+		}
+		if (count < 1 || count > TS_PROBE_MAX) {
+			shell_error(shell, "Probe count must be 1..%u", TS_PROBE_MAX);
+			return -EINVAL;
+		}
+		if (timesync_now_us(&now) != 0) {
+			shell_error(shell, "No network time yet; probes need a synced PT or an FT");
+			return -EAGAIN;
+		}
+		k_mutex_lock(&timesync_mutex, K_FOREVER);
+		probe.to_send = (uint32_t)count;
+		k_mutex_unlock(&timesync_mutex);
+		k_work_reschedule(&probe_work, K_NO_WAIT);
+		shell_print(shell, "TIME: sending %ld probe(s) to the associated peer, %u ms apart; "
+			    "TIME on the peer shows the one-way latency", count, TS_PROBE_INTERVAL_MS);
+		return 0;
+	} else if (argc > 1 && (strcmp(argv[1], "RESET") == 0 || strcmp(argv[1], "reset") == 0)) {
+		k_mutex_lock(&timesync_mutex, K_FOREVER);
+		memset(&stats, 0, sizeof(stats));
+		memset(&probe, 0, sizeof(probe));
+		k_mutex_unlock(&timesync_mutex);
+	} else if (argc > 1) {
+		shell_error(shell, "Usage: TIME [PROBE [count]|RESET]");
+		return -EINVAL;
+	}
+
+	print_sync(shell);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(TIME, NULL, "TIME [PROBE [count]|RESET] — network time sync to the FT, one-way latency", cmd_time, 1, 2);
+SHELL_CMD_ARG_REGISTER(time, NULL, "time [probe [count]|reset] — network time sync to the ft, one-way latency", cmd_time, 1, 2);
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TIMESYNC_H__
+#define TIMESYNC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file timesync.h
+ * @brief NTP-style time transfer from the FT to its PTs over DLC.
+ *
+ * Network time is the FT's uptime in microseconds. A PT (or relay) sends a
+ * request with its local send time t1 to its parent every
+ * CONFIG_APP_TIMESYNC_INTERVAL_MS, faster right after association; the
+ * parent answers with its network time at request RX (t2) and at reply TX
+ * (t3), and the PT notes the local RX time t4:
+ *
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2      delay = (t4 - t1) - (t3 - t2)
+ *
+ * RX times are taken in the modem callback, and the messages travel on the
+ * signalling flow to keep queueing out of the measurement. Of the last
+ * TIMESYNC_SAMPLES, only those with a delay close to the smallest count:
+ * once they span a few seconds, a least-squares fit of their offsets over
+ * local time gives offset and skew, before that the newest one gives the
+ * offset alone. A relay answers its own PTs with its
+ * synced time, so a whole tree shares the root FT's clock.
+ *
+ * Wire format after the port byte (APP_DLC_PORT_TIME), little endian:
+ *   [0] type, [1] flags, [2..3] sequence number, then
+ *   request: [4..11] t1
+ *   reply:   [4..11] t1 echoed, [12..19] t2, [20..27] t3
+ *   probe:   [4..11] network time at send, [12..15] probe index
+ */
+
+/** Samples kept for the offset and skew estimate. */
+#define TIMESYNC_SAMPLES 8
+
+/**
+ * @brief Handle a payload received on APP_DLC_PORT_TIME.
+ *
+ * Called from the main event loop; uses app_dlc_rx_time_us().
+ *
+ * @param long_rd_id Sender long RD ID
+ * @param data       Payload after the port byte
+ * @param len        Payload length
+ */
+void timesync_rx(uint32_t long_rd_id, const uint8_t *data, size_t len);
+
+/**
+ * @brief Start synchronising to the parent after an association.
+ *
+ * Samples from an earlier parent are discarded.
+ */
+void timesync_link_up(void);
+
+/**
+ * @brief Convert a local uptime to network time.
+ *
+ * @param local_us Local uptime in microseconds (k_ticks_to_us_floor64())
+ * @param time_us  Output: network time in microseconds
+ * @return 0 on success, -EAGAIN on a PT that has not synchronised yet, or
+ *         -ENOTCONN when idle
+ */
+int timesync_from_local_us(int64_t local_us, int64_t *time_us);
+
+/**
+ * @brief Get the current network time.
+ *
+ * On an FT this is the local uptime. A PT keeps its last estimate while it
+ * is not associated.
+ *
+ * @param time_us Output: network time in microseconds
+ * @return 0 on success, negative error code as for timesync_from_local_us()
+ */
+int timesync_now_us(int64_t *time_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMESYNC_H__ */
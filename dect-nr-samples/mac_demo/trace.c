@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "trace.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/base64.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+LOG_MODULE_REGISTER(trace, CONFIG_LOG_DEFAULT_LEVEL);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_APP_TRACE_RING_SIZE),
+	     "CONFIG_APP_TRACE_RING_SIZE must be a power of two");
+
+#define TRACE_RECORD_LEN     16
+#define TRACE_LINE_RECORDS   8
+#define TRACE_LINE_HDR_LEN   9
+#define TRACE_LINE_LEN       (TRACE_LINE_HDR_LEN + TRACE_LINE_RECORDS * TRACE_RECORD_LEN + 2)
+
+struct trace_record {
+	uint32_t ticks;
+	uint16_t id;
+	int16_t a0;
+	uint32_t a1;
+	uint32_t a2;
+};
+
+static struct trace_record ring[CONFIG_APP_TRACE_RING_SIZE];
+/* Sequence number + 1 of the complete record in each slot, 0 while written. */
+static atomic_t ring_seq[CONFIG_APP_TRACE_RING_SIZE];
+static atomic_t head;       /* sequence number of the next record */
+static atomic_t base;       /* first sequence number after TRACE CLEAR */
+static atomic_t trace_on = ATOMIC_INIT(1);
+
+void trace_event(enum trace_id id, int16_t a0, uint32_t a1, uint32_t a2)
+{
+	uint32_t seq;
+	size_t slot;
+
+	if (!atomic_get(&trace_on)) {
+		return;
+	}
+	seq = (uint32_t)atomic_inc(&head);
+	slot = seq & (CONFIG_APP_TRACE_RING_SIZE - 1);
+	atomic_set(&ring_seq[slot], 0);
+	ring[slot] = (struct trace_record){
+		.ticks = (uint32_t)k_uptime_ticks(),
+		.id = (uint16_t)id,
+		.a0 = a0,
+		.a1 = a1,
+		.a2 = a2,
+	};
+	atomic_set(&ring_seq[slot], (atomic_val_t)(seq + 1));
+}
+
+/* Copy the record with sequence number seq if it is still in the ring and
+ * was not overwritten while copying. */
+static bool record_get(uint32_t seq, struct trace_record *out)
+{
+	size_t slot = seq & (CONFIG_APP_TRACE_RING_SIZE - 1);
+
+	if ((uint32_t)atomic_get(&ring_seq[slot]) != seq + 1) {
+		return false;
+	}
+	*out = ring[slot];
+	return (uint32_t)atomic_get(&ring_seq[slot]) == seq + 1;
+}
+
+static void line_print(const struct shell *shell, uint8_t *line, size_t n_records)
+{
+	static uint8_t line_b64[((TRACE_LINE_LEN + 2) / 3) * 4 + 1];
+	size_t len = TRACE_LINE_HDR_LEN + n_records * TRACE_RECORD_LEN;
+	size_t b64_len;
+
+	sys_put_le16(crc16_itu_t(0xffff, line, len), &line[len]);
+	if (base64_encode(line_b64, sizeof(line_b64), &b64_len, line, len + 2) == 0) {
+		shell_print(shell, "TRC %s", (const char *)line_b64);
+	}
+}
+
+/* Print every record still in the ring, oldest first. Records written during
+ * the dump are left for the next one. */
+static void trace_dump(const struct shell *shell)
+{
+	static uint8_t line[TRACE_LINE_LEN];
+	uint32_t end = (uint32_t)atomic_get(&head);
+	uint32_t start = (uint32_t)atomic_get(&base);
+	uint32_t first_seq = 0;
+	size_t n = 0, dumped = 0, lost = 0;
+
+	if (end - start > CONFIG_APP_TRACE_RING_SIZE) {
+		lost = end - start - CONFIG_APP_TRACE_RING_SIZE;
+		start = end - CONFIG_APP_TRACE_RING_SIZE;
+	}
+
+	for (uint32_t seq = start; seq != end; seq++) {
+		struct trace_record r;
+		uint8_t *p;
+
+		if (!record_get(seq, &r)) {
+			lost++;
+			continue;
+		}
+		if (n == 0) {
+			first_seq = seq;
+		}
+		/* A gap starts a new line: the decoder numbers records from first_seq. */
+		if (n > 0 && seq != first_seq + n) {
+			line_print(shell, line, n);
+			n = 0;
+			first_seq = seq;
+		}
+		if (n == 0) {
+			line[0] = TRACE_VERSION;
+			sys_put_le32(CONFIG_SYS_CLOCK_TICKS_PER_SEC, &line[1]);
+			sys_put_le32(first_seq, &line[5]);
+		}
+		p = &line[TRACE_LINE_HDR_LEN + n * TRACE_RECORD_LEN];
+		sys_put_le32(r.ticks, &p[0]);
+		sys_put_le16(r.id, &p[4]);
+		sys_put_le16((uint16_t)r.a0, &p[6]);
+		sys_put_le32(r.a1, &p[8]);
+		sys_put_le32(r.a2, &p[12]);
+		dumped++;
+		if (++n == TRACE_LINE_RECORDS) {
+			line_print(shell, line, n);
+			n = 0;
+		}
+	}
+	if (n > 0) {
+		line_print(shell, line, n);
+	}
+	shell_print(shell, "TRACE: %zu record(s) dumped, %zu overwritten (decode with "
+		    "python/trace_decode.py)", dumped, lost);
+}
+
+static int cmd_trace(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t recorded;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "DUMP") == 0 || strcmp(argv[1], "dump") == 0) {
+			trace_dump(shell);
+			return 0;
+		} else if (strcmp(argv[1], "CLEAR") == 0 || strcmp(argv[1], "clear") == 0) {
+			atomic_set(&base, atomic_get(&head));
+		} else if (strcmp(argv[1], "ON") == 0 || strcmp(argv[1], "on") == 0) {
+			atomic_set(&trace_on, 1);
+		} else if (strcmp(argv[1], "OFF") == 0 || strcmp(argv[1], "off") == 0) {
+			atomic_set(&trace_on, 0);
+		} else {
+			shell_error(shell, "Usage: TRACE [DUMP|CLEAR|ON|OFF]");
+			return -EINVAL;
+		}
+	}
+
+	recorded = (uint32_t)atomic_get(&head) - (uint32_t)atomic_get(&base);
+	shell_print(shell, "TRACE: %s, %u record(s) since clear, ring %u x %u B (%u held)",
+		    atomic_get(&trace_on) ? "on" : "off", recorded, CONFIG_APP_TRACE_RING_SIZE,
+		    TRACE_RECORD_LEN, MIN(recorded, CONFIG_APP_TRACE_RING_SIZE));
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(TRACE, NULL, "TRACE [DUMP|CLEAR|ON|OFF] — binary event trace ring", cmd_trace, 1, 1);
+SHELL_CMD_ARG_REGISTER(trace, NULL, "trace [dump|clear|on|off] — binary event trace ring", cmd_trace, 1, 1);
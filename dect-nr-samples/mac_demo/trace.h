@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_H__
+#define TRACE_H__
+
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file trace.h
+ * @brief Deferred binary trace for callback context and hot paths.
+ *
+ * A trace point stores a fixed 16-byte record (uptime ticks, event ID and
+ * three arguments) in a RAM ring: one atomic increment claims a slot, so it
+ * is safe in modem callbacks and ISRs and costs no UART time. Format strings
+ * never reach the device; they live in trace_events.h, which
+ * python/trace_decode.py uses as its dictionary.
+ *
+ * When the ring is full the oldest records are overwritten. TRACE DUMP prints
+ * the ring as "TRC <base64>" lines:
+ *   [u8 version][u32 ticks per second][u32 sequence of the first record]
+ *   [records: u32 ticks, u16 id, i16 a0, u32 a1, u32 a2]... [u16 CRC-16/ITU-T]
+ * all little endian.
+ */
+
+#define TRACE_VERSION 1
+
+enum trace_id {
+	TRACE_NONE = 0,
+#define TRACE_EVENT(name, fmt) TRACE_##name,
+#include "trace_events.h"
+#undef TRACE_EVENT
+	TRACE_ID_COUNT,
+};
+
+#if defined(CONFIG_APP_TRACE)
+/**
+ * @brief Record a trace event.
+ *
+ * Lock-free; callable from any context. Does nothing while tracing is off.
+ *
+ * @param id Event ID
+ * @param a0 Small signed argument (status, length, percentage)
+ * @param a1 First 32-bit argument
+ * @param a2 Second 32-bit argument
+ */
+void trace_event(enum trace_id id, int16_t a0, uint32_t a1, uint32_t a2);
+#else
+static inline void trace_event(enum trace_id id, int16_t a0, uint32_t a1, uint32_t a2)
+{
+	ARG_UNUSED(id);
+	ARG_UNUSED(a0);
+	ARG_UNUSED(a1);
+	ARG_UNUSED(a2);
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H__ */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Trace event dictionary (trace.h). Included once per use with TRACE_EVENT
+ * defined; no include guard on purpose.
+ *
+ * TRACE_EVENT(name, format): IDs are assigned in order from 1, so append new
+ * events at the end and never reorder. The format string stays on the host:
+ * python/trace_decode.py reads this file and formats {a0} (int16), {a1} and
+ * {a2} (uint32) with str.format().
+ */
+
+/* dect_adapter.c: modem callbacks */
+TRACE_EVENT(MODEM_CLUSTER_CONFIGURE, "modem cluster_configure done status={a0}")
+TRACE_EVENT(MODEM_NETWORK_SCAN, "modem network_scan done status={a0} channels={a1}")
+TRACE_EVENT(MODEM_ASSOC_IND, "modem association ind status={a0} rd={a1} short_rd={a2}")
+TRACE_EVENT(MODEM_DLC_RX, "modem dlc rx len={a0} rd={a1} flow={a2}")
+TRACE_EVENT(MODEM_DLC_TX, "modem dlc tx done status={a0} txn={a1} rd={a2}")
+TRACE_EVENT(MODEM_DLC_FLOW_CONTROL, "modem dlc flow control status={a0}")
+TRACE_EVENT(MODEM_CH_LOAD_CHANGE, "modem cluster channel load busy={a0}% ch={a1}")
+TRACE_EVENT(MODEM_CAPABILITY_BAND, "modem capability band={a0} min_carrier={a1} max_carrier={a2}")
+TRACE_EVENT(MODEM_CONTROL_CONFIGURE, "control_configure tx={a0} dBm rd={a1} carrier={a2}")
+
+/* main.c: application callbacks */
+TRACE_EVENT(ASSOC_RELEASE, "association release rd={a1}")
+TRACE_EVENT(ASSOC_IND, "association ind status={a0} rd={a1}")
+TRACE_EVENT(ASSOC, "association result status={a0} rd={a1}")
+TRACE_EVENT(RSSI_SCAN, "rssi ch={a1} busy={a0}% free={a2}")
+TRACE_EVENT(DLC_RX, "dlc rx len={a0} rd={a1}")
+TRACE_EVENT(DLC_RX_DROP, "dlc rx dropped len={a0} rd={a1} total_dropped={a2}")
+TRACE_EVENT(DLC_TX_DONE, "dlc tx done status={a0} txn={a1}")
+TRACE_EVENT(BEACON_RX_FAILURE, "cluster beacon rx failure rd={a1}")
+TRACE_EVENT(APP_EVT_DROP, "app event dropped type={a0} total_dropped={a1}")
+TRACE_EVENT(WAIT_MISMATCH, "completion for wait reason {a1} while waiting for {a2}")
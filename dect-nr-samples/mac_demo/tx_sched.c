@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "tx_sched.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/slist.h>
+#include "app_dlc.h"
+#include "dect_adapter.h"
+#include "ft_assoc.h"
+#include "power.h"
+#include "seqtrack.h"
+#include "telemetry.h"
+
+LOG_MODULE_REGISTER(tx_sched, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define TX_SCHED_FLOW_MAX    4 /* flow IDs above this share the last queue */
+#define TX_SCHED_PEER_MAX    CONFIG_APP_TX_SCHED_PEER_MAX
+#define TX_SCHED_INFLIGHT    CONFIG_APP_TX_SCHED_INFLIGHT
+#define TX_SCHED_QUANTUM     CONFIG_APP_TX_SCHED_QUANTUM
+#define TX_SCHED_RETRY_MS    10
+/* Longer than the 60 s DLC SDU lifetime configured at association: a slot
+ * still held after this lost its completion and is reclaimed. */
+#define TX_SCHED_INFLIGHT_TIMEOUT_MS 65000
+/* Rounds needed before any head SDU fits the deficit, for every peer. */
+#define TX_SCHED_SELECT_ROUNDS \
+	(TX_SCHED_PEER_MAX * (DIV_ROUND_UP(APP_DLC_SDU_LEN_MAX, TX_SCHED_QUANTUM) + 1))
+
+struct tx_entry {
+	sys_snode_t node;
+	uint32_t transaction_id;
+	uint32_t long_rd_id;
+	uint32_t queued_ms;
+	uint16_t len;        /* SDU length without the sequence prefix */
+	uint8_t flow_id;
+	bool seq;            /* numbered: sent with the prefix */
+	bool seq_stamped;    /* prefix written; a modem retry keeps the number */
+	/* Sequence prefix (seqtrack.h), then the SDU. */
+	uint8_t sdu[SEQTRACK_OVERHEAD + APP_DLC_SDU_LEN_MAX];
+};
+
+struct tx_peer {
+	uint32_t long_rd_id; /* 0 = free slot */
+	sys_slist_t queue[TX_SCHED_FLOW_MAX];
+	uint32_t deficit[TX_SCHED_FLOW_MAX];
+	uint16_t queued;
+	uint32_t sent;
+	uint32_t sent_bytes;
+	uint32_t dropped;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(tx_sched_slab, ROUND_UP(sizeof(struct tx_entry), 4),
+			 CONFIG_APP_TX_SCHED_BUF_COUNT, 4);
+
+static struct tx_peer peers[TX_SCHED_PEER_MAX];
+static uint8_t cursor[TX_SCHED_FLOW_MAX];     /* DRR position per flow */
+static uint16_t flow_queued[TX_SCHED_FLOW_MAX];
+static struct {
+	uint32_t transaction_id;
+	uint32_t long_rd_id;
+	uint32_t start_ms;
+	uint32_t queued_ms;
+	uint16_t len;
+	bool used;
+} inflight[TX_SCHED_INFLIGHT];
+static uint8_t inflight_count;
+static tx_sched_fail_cb_t fail_cb;
+
+static struct {
+	uint32_t enqueued;
+	uint32_t sent;
+	uint32_t no_buf;
+	uint32_t modem_busy;
+	uint32_t modem_err;
+	uint32_t flushed;
+	uint32_t reclaimed;
+	uint32_t peak_queued;
+} stats;
+
+/* Taken after app_mutex when called from send_data(). */
+static K_MUTEX_DEFINE(tx_sched_mutex);
+
+static void tx_sched_retry_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(tx_sched_retry_work, tx_sched_retry_handler);
+
+static uint8_t flow_index(uint8_t flow_id)
+{
+	return (flow_id == 0) ? 0 : MIN(flow_id, TX_SCHED_FLOW_MAX) - 1;
+}
+
+/* Must be called with tx_sched_mutex held. */
+static struct tx_peer *peer_get(uint32_t long_rd_id, bool create)
+{
+	struct tx_peer *free_slot = NULL;
+	struct tx_peer *idle_slot = NULL;
+
+	for (int i = 0; i < TX_SCHED_PEER_MAX; i++) {
+		if (peers[i].long_rd_id == long_rd_id) {
+			return &peers[i];
+		}
+		if (free_slot == NULL && peers[i].long_rd_id == 0) {
+			free_slot = &peers[i];
+		} else if (idle_slot == NULL && peers[i].queued == 0) {
+			idle_slot = &peers[i];
+		}
+	}
+	if (free_slot == NULL) {
+		free_slot = idle_slot;
+	}
+	if (!create || free_slot == NULL) {
+		return NULL;
+	}
+
+	/* Unused slots first; only when none is left is a live peer's idle slot
+	 * recycled, and its counters restart. */
+	memset(free_slot, 0, sizeof(*free_slot));
+	free_slot->long_rd_id = long_rd_id;
+	for (int f = 0; f < TX_SCHED_FLOW_MAX; f++) {
+		sys_slist_init(&free_slot->queue[f]);
+	}
+	return free_slot;
+}
+
+/* Pick the next SDU: strict priority between flows, deficit round-robin
+ * between peers within a flow. The entry stays queued; *peer_out and
+ * *flow_out say where. Must be called with tx_sched_mutex held. */
+static struct tx_entry *select_locked(struct tx_peer **peer_out, uint8_t *flow_out)
+{
+	for (uint8_t f = 0; f < TX_SCHED_FLOW_MAX; f++) {
+		if (flow_queued[f] == 0) {
+			continue;
+		}
+
+		for (int n = 0; n < TX_SCHED_SELECT_ROUNDS; n++) {
+			struct tx_peer *p = &peers[cursor[f]];
+			sys_snode_t *head = sys_slist_peek_head(&p->queue[f]);
+
+			if (head != NULL) {
+				struct tx_entry *e = CONTAINER_OF(head, struct tx_entry, node);
+
+				if (e->len <= p->deficit[f]) {
+					*peer_out = p;
+					*flow_out = f;
+					return e;
+				}
+			} else {
+				p->deficit[f] = 0;
+			}
+
+			/* Turn over: the next backlogged peer earns one quantum. */
+			cursor[f] = (cursor[f] + 1) % TX_SCHED_PEER_MAX;
+			p = &peers[cursor[f]];
+			if (!sys_slist_is_empty(&p->queue[f])) {
+				p->deficit[f] += TX_SCHED_QUANTUM;
+			}
+		}
+	}
+	return NULL;
+}
+
+/* Must be called with tx_sched_mutex held. */
+static void inflight_reclaim_locked(void)
+{
+	uint32_t now = k_uptime_get_32();
+
+	for (int i = 0; i < TX_SCHED_INFLIGHT; i++) {
+		if (inflight[i].used && now - inflight[i].start_ms > TX_SCHED_INFLIGHT_TIMEOUT_MS) {
+			LOG_WRN("No TX completion for tx=%u, reclaiming slot",
+				inflight[i].transaction_id);
+			inflight[i].used = false;
+			inflight_count--;
+			stats.reclaimed++;
+		}
+	}
+}
+
+/* Must be called with tx_sched_mutex held. len is the SDU as sent. */
+static void inflight_add_locked(const struct tx_entry *e, uint16_t len)
+{
+	for (int i = 0; i < TX_SCHED_INFLIGHT; i++) {
+		if (!inflight[i].used) {
+			inflight[i].used = true;
+			inflight[i].transaction_id = e->transaction_id;
+			inflight[i].long_rd_id = e->long_rd_id;
+			inflight[i].start_ms = k_uptime_get_32();
+			inflight[i].queued_ms = e->queued_ms;
+			inflight[i].len = len;
+			inflight_count++;
+			return;
+		}
+	}
+}
+
+/* Hand queued SDUs to the adapter while the window has room.
+ * Must be called with tx_sched_mutex held. */
+static void dispatch_locked(void)
+{
+	inflight_reclaim_locked();
+
+	while (inflight_count < TX_SCHED_INFLIGHT) {
+		struct tx_peer *p;
+		uint8_t f;
+		struct tx_entry *e = select_locked(&p, &f);
+		const uint8_t *sdu;
+		uint16_t sdu_len;
+		int err;
+
+		if (e == NULL) {
+			return;
+		}
+
+		if (e->seq && !e->seq_stamped) {
+			seqtrack_stamp(e->sdu, e->long_rd_id);
+			e->seq_stamped = true;
+		}
+		sdu = e->seq ? e->sdu : &e->sdu[SEQTRACK_OVERHEAD];
+		sdu_len = e->seq ? e->len + SEQTRACK_OVERHEAD : e->len;
+
+		err = dect_adapter_dlc_data_send(e->transaction_id, e->flow_id, e->long_rd_id,
+						 sdu, sdu_len);
+		if (err == -ENOMEM || err == -ENOBUFS || err == -EAGAIN || err == -EBUSY) {
+			/* Modem queue full: keep the SDU at the head and try again shortly. */
+			stats.modem_busy++;
+			if (inflight_count == 0) {
+				k_work_reschedule(&tx_sched_retry_work, K_MSEC(TX_SCHED_RETRY_MS));
+			}
+			return;
+		}
+
+		(void)sys_slist_get(&p->queue[f]);
+		p->deficit[f] -= e->len;
+		p->queued--;
+		flow_queued[f]--;
+
+		if (err != 0) {
+			stats.modem_err++;
+			p->dropped++;
+			LOG_WRN("DLC send tx=%u rd=%u failed: %d", e->transaction_id,
+				e->long_rd_id, err);
+			if (fail_cb != NULL) {
+				fail_cb(err, e->transaction_id);
+			}
+		} else {
+			stats.sent++;
+			p->sent++;
+			p->sent_bytes += sdu_len;
+			inflight_add_locked(e, sdu_len);
+		}
+		k_mem_slab_free(&tx_sched_slab, e);
+	}
+}
+
+static void tx_sched_retry_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&tx_sched_mutex, K_FOREVER);
+	dispatch_locked();
+	k_mutex_unlock(&tx_sched_mutex);
+}
+
+void tx_sched_init(tx_sched_fail_cb_t cb)
+{
+	k_mutex_lock(&tx_sched_mutex, K_FOREVER);
+	fail_cb = cb;
+	k_mutex_unlock(&tx_sched_mutex);
+}
+
+int tx_sched_enqueue(uint32_t transaction_id, uint8_t flow_id, uint32_t long_rd_id,
+		     uint8_t port, const void *hdr, size_t hdr_len, const void *data, size_t len)
+{
+	struct tx_peer *p;
+	struct tx_entry *e;
+	uint8_t f = flow_index(flow_id);
+	uint32_t total = 0;
+
+	if (APP_DLC_PORT_HDR_LEN + hdr_len + len > APP_DLC_SDU_LEN_MAX) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&tx_sched_mutex, K_FOREVER);
+	p = peer_get(long_rd_id, true);
+	if (p == NULL || p->queued >= CONFIG_APP_TX_SCHED_PEER_QUEUE_MAX ||
+	    k_mem_slab_alloc(&tx_sched_slab, (void **)&e, K_NO_WAIT) != 0) {
+		stats.no_buf++;
+		if (p != NULL) {
+			p->dropped++;
+		}
+		k_mutex_unlock(&tx_sched_mutex);
+		return -ENOBUFS;
+	}
+
+	e->transaction_id = transaction_id;
+	e->long_rd_id = long_rd_id;
+	e->queued_ms = k_uptime_get_32();
+	e->flow_id = flow_id;
+	e->sdu[SEQTRACK_OVERHEAD] = port;
+	if (hdr_len != 0) {
+		memcpy(&e->sdu[SEQTRACK_OVERHEAD + APP_DLC_PORT_HDR_LEN], hdr, hdr_len);
+	}
+	if (len != 0) {
+		memcpy(&e->sdu[SEQTRACK_OVERHEAD + APP_DLC_PORT_HDR_LEN + hdr_len], data, len);
+	}
+	e->len = (uint16_t)(APP_DLC_PORT_HDR_LEN + hdr_len + len);
+	/* SDUs too large for the prefix go out unnumbered. */
+	e->seq = seqtrack_enabled() && e->len + SEQTRACK_OVERHEAD <= APP_DLC_SDU_LEN_MAX;
+	e->seq_stamped = false;
+
+	sys_slist_append(&p->queue[f], &e->node);
+	p->queued++;
+	flow_queued[f]++;
+	stats.enqueued++;
+	for (int i = 0; i < TX_SCHED_FLOW_MAX; i++) {
+		total += flow_queued[i];
+	}
+	stats.peak_queued = MAX(stats.peak_queued, total);
+
+	dispatch_locked();
+	k_mutex_unlock(&tx_sched_mutex);
+	return 0;
+}
+
+uint32_t tx_sched_tx_done(uint32_t transaction_id, int status)
+{
+	uint32_t long_rd_id = 0;
+
+	k_mutex_lock(&tx_sched_mutex, K_FOREVER);
+	for (int i = 0; i < TX_SCHED_INFLIGHT; i++) {
+		if (inflight[i].used && inflight[i].transaction_id == transaction_id) {
+			inflight[i].used = false;
+			inflight_count--;
+			if (status == 0) {
+				power_note_tx(inflight[i].len,
+					      k_uptime_get_32() - inflight[i].queued_ms);
+			}
+			telemetry_note_tx(inflight[i].long_rd_id, inflight[i].len, status);
+			ft_assoc_note_tx(inflight[i].long_rd_id, inflight[i].len, status);
+			long_rd_id = inflight[i].long_rd_id;
+			break;
+		}
+	}
+	dispatch_locked();
+	k_mutex_unlock(&tx_sched_mutex);
+	return long_rd_id;
+}
+
+void tx_sched_peer_flush(uint32_t long_rd_id, tx_sched_fail_cb_t done)
+{
+	uint32_t flushed[CONFIG_APP_TX_SCHED_PEER_QUEUE_MAX];
+	size_t n = 0;
+	struct tx_peer *p;
+
+	k_mutex_lock(&tx_sched_mutex, K_FOREVER);
+	p = peer_get(long_rd_id, false);
+	if (p == NULL) {
+		k_mutex_unlock(&tx_sched_mutex);
+		return;
+	}
+
+	for (int f = 0; f < TX_SCHED_FLOW_MAX; f++) {
+		sys_snode_t *node;
+
+		while ((node = sys_slist_get(&p->queue[f])) != NULL) {
+			struct tx_entry *e = CONTAINER_OF(node, struct tx_entry, node);
+
+			/* The per-peer limit bounds the queue, so every ID fits. */
+			if (n < ARRAY_SIZE(flushed)) {
+				flushed[n++] = e->transaction_id;
+			}
+			k_mem_slab_free(&tx_sched_slab, e);
+			p->queued--;
+			p->dropped++;
+			flow_queued[f]--;
+			stats.flushed++;
+		}
+		p->deficit[f] = 0;
+	}
+	k_mutex_unlock(&tx_sched_mutex);
+
+	if (n != 0) {
+		LOG_INF("Flushed %zu queued SDU(s) for rd=%u", n, long_rd_id);
+	}
+	for (size_t i = 0; done != NULL && i < n; i++) {
+		done(-ENOTCONN, flushed[i]);
+	}
+}
+
+static int cmd_txq(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_mutex_lock(&tx_sched_mutex, K_FOREVER);
+	shell_print(shell, "TXQ: in flight %u/%u, buffers free %u/%u, quantum %u B",
+		    inflight_count, TX_SCHED_INFLIGHT, k_mem_slab_num_free_get(&tx_sched_slab),
+		    CONFIG_APP_TX_SCHED_BUF_COUNT, TX_SCHED_QUANTUM);
+	shell_print(shell, "TXQ: enqueued=%u sent=%u no_buf=%u modem_busy=%u modem_err=%u "
+		    "flushed=%u reclaimed=%u peak_queued=%u", stats.enqueued, stats.sent,
+		    stats.no_buf, stats.modem_busy, stats.modem_err, stats.flushed,
+		    stats.reclaimed, stats.peak_queued);
+	for (int i = 0; i < TX_SCHED_PEER_MAX; i++) {
+		struct tx_peer *p = &peers[i];
+
+		if (p->long_rd_id == 0 && p->sent == 0) {
+			continue;
+		}
+		shell_print(shell, "  rd=%u queued=%u (flow1..4: %u/%u/%u/%u) sent=%u (%u B) "
+			    "dropped=%u", p->long_rd_id, p->queued,
+			    (uint32_t)sys_slist_len(&p->queue[0]),
+			    (uint32_t)sys_slist_len(&p->queue[1]),
+			    (uint32_t)sys_slist_len(&p->queue[2]),
+			    (uint32_t)sys_slist_len(&p->queue[3]),
+			    p->sent, p->sent_bytes, p->dropped);
+	}
+	k_mutex_unlock(&tx_sched_mutex);
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(TXQ, NULL, "TXQ — DLC TX scheduler queues and counters", cmd_txq, 1, 0);
+SHELL_CMD_ARG_REGISTER(txq, NULL, "txq — dlc tx scheduler queues and counters", cmd_txq, 1, 0);
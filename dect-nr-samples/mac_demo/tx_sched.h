@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TX_SCHED_H__
+#define TX_SCHED_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tx_sched.h
+ * @brief Per-peer, per-flow DLC TX queues in front of dect_adapter_dlc_data_send().
+ *
+ * Each peer has one queue per flow. Lower flow IDs have strict priority
+ * (flows 1-2 are signalling, 3+ user plane); within a flow, peers are served
+ * by deficit round-robin with a quantum of CONFIG_APP_TX_SCHED_QUANTUM bytes.
+ * At most CONFIG_APP_TX_SCHED_INFLIGHT SDUs are handed to the modem without a
+ * TX completion, so the queues, not the modem, absorb bursts.
+ */
+
+/**
+ * @brief Report a TX failure for an SDU that never reached the modem.
+ *
+ * Same signature as the adapter's dlc_data_tx completion, so failures can
+ * take the same path as modem completions. The handler given to
+ * tx_sched_init() is called with scheduler and possibly app_mutex held and
+ * must only post an event; the one given to tx_sched_peer_flush() is called
+ * without locks.
+ *
+ * @param status         Negative error code
+ * @param transaction_id Transaction ID given to tx_sched_enqueue()
+ */
+typedef void (*tx_sched_fail_cb_t)(int status, uint32_t transaction_id);
+
+/**
+ * @brief Set the handler for SDUs that fail before reaching the modem.
+ *
+ * @param cb Failure handler
+ */
+void tx_sched_init(tx_sched_fail_cb_t cb);
+
+/**
+ * @brief Queue one SDU (port byte, header, payload) and send what the window allows.
+ *
+ * The SDU is copied; the caller's buffers can be reused at once.
+ *
+ * @param transaction_id Transaction ID the TX completion will carry
+ * @param flow_id        DLC flow (1..)
+ * @param long_rd_id     Destination long RD ID
+ * @param port           Service port byte
+ * @param hdr            Service header (may be NULL if @p hdr_len is 0)
+ * @param hdr_len        Service header length
+ * @param data           Payload (may be NULL if @p len is 0)
+ * @param len            Payload length
+ * @return 0 on success, -ENOBUFS if the peer's queue or the buffer pool is full
+ */
+int tx_sched_enqueue(uint32_t transaction_id, uint8_t flow_id, uint32_t long_rd_id,
+		     uint8_t port, const void *hdr, size_t hdr_len, const void *data, size_t len);
+
+/**
+ * @brief Account a modem TX completion and refill the window.
+ *
+ * Called from the main event loop for every DLC TX completion. Successful
+ * completions are charged to the power accounting with their queueing-to-
+ * completion latency; every modem completion is counted in the destination
+ * peer's telemetry.
+ *
+ * @param transaction_id Transaction ID of the completed SDU
+ * @param status         Completion status (0 = success)
+ * @return Destination long RD ID of the SDU, 0 if it was not in flight
+ */
+uint32_t tx_sched_tx_done(uint32_t transaction_id, int status);
+
+/**
+ * @brief Drop everything queued for a peer, failing each SDU with -ENOTCONN.
+ *
+ * The failures are reported after the scheduler lock is released, so the
+ * event loop can run its completion path directly instead of posting one
+ * event per SDU.
+ *
+ * @param long_rd_id Peer long RD ID
+ * @param done       Called once per dropped SDU (may be NULL)
+ */
+void tx_sched_peer_flush(uint32_t long_rd_id, tx_sched_fail_cb_t done);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TX_SCHED_H__ */